@@ -43,7 +43,8 @@ private:
  */
 class RMLUICORE_API CallbackTextureInterface {
 public:
-	CallbackTextureInterface(RenderManager& render_manager, RenderInterface& render_interface, TextureHandle& texture_handle, Vector2i& dimensions);
+	CallbackTextureInterface(RenderManager& render_manager, RenderInterface& render_interface, TextureHandle& texture_handle, Vector2i& dimensions,
+		bool* deferred = nullptr);
 
 	/// Generate texture from byte source.
 	/// @param[in] source Texture data in 8-bit RGBA (premultiplied) format.
@@ -62,11 +63,18 @@ public:
 
 	RenderManager& GetRenderManager() const;
 
+	/// Returns true if the callback may postpone the texture to a later frame, see Defer().
+	bool CanDefer() const;
+	/// Postpone the texture, e.g. while it is being generated on a worker thread. The callback must then return false
+	/// without setting a texture. It will be called again on a later render, and geometry using the texture is skipped until then.
+	void Defer() const;
+
 private:
 	RenderManager& render_manager;
 	RenderInterface& render_interface;
 	TextureHandle& texture_handle;
 	Vector2i& dimensions;
+	bool* deferred;
 };
 
 /**
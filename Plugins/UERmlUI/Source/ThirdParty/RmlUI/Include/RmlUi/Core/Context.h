@@ -21,6 +21,24 @@ class RenderManager;
 class TextInputHandler;
 enum class EventId : uint16_t;
 
+/**
+    Optional hook into Context::Render, allowing the application to retain and replay the render output of individual
+    documents. Each document is rendered starting from, and ending in, the default render state, thus its output does not
+    depend on the documents rendered before it.
+ */
+class RMLUICORE_API RenderDocumentHandler {
+public:
+	virtual ~RenderDocumentHandler() = default;
+
+	/// Called before a document is rendered.
+	/// @param[in] document The document about to be rendered.
+	/// @return False to skip rendering the document, e.g. when its previously retained output has been replayed instead.
+	virtual bool OnRenderDocumentBegin(ElementDocument* document) = 0;
+	/// Called after the document has been rendered, only when OnRenderDocumentBegin returned true.
+	/// @param[in] document The document that was rendered.
+	virtual void OnRenderDocumentEnd(ElementDocument* document) = 0;
+};
+
 /**
     A context for storing, rendering, and processing RML documents. Multiple contexts can exist simultaneously.
  */
@@ -57,7 +75,8 @@ public:
 	/// This must be called before Context::Render, but after any elements have been changed, added, or removed.
 	bool Update();
 	/// Renders all visible elements in the context's documents.
-	bool Render();
+	/// @param[in] document_handler Optional handler which is notified around the rendering of each document, and may skip it.
+	bool Render(RenderDocumentHandler* document_handler = nullptr);
 
 	/// Creates a new, empty document and places it into this context.
 	/// @param[in] instancer_name The name of the instancer used to create the document.
@@ -388,6 +407,9 @@ private:
 	// See RequestNextUpdate() and NextUpdateRequested() for details.
 	double next_update_timeout = 0;
 
+	// Renders the documents in stacking order, passing each of them through the document handler.
+	void RenderDocuments(RenderDocumentHandler& document_handler);
+
 	// Internal callback for when an element is detached or removed from the hierarchy.
 	void OnElementDetach(Element* element);
 	// Internal callback for when a new element gains focus.
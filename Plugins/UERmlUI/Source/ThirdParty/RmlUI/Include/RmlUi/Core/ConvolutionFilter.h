@@ -51,6 +51,11 @@ public:
 	void Run(byte* destination, Vector2i destination_dimensions, int destination_stride, ColorFormat destination_color_format, const byte* source,
 		Vector2i source_dimensions, Vector2i source_offset, ColorFormat source_color_format) const;
 
+	/// Straightforward per-pixel implementation of Run(), evaluating every kernel value for every pixel. Used for
+	/// validating and benchmarking Run(), which produces the same result within float rounding.
+	void RunReference(byte* destination, Vector2i destination_dimensions, int destination_stride, ColorFormat destination_color_format,
+		const byte* source, Vector2i source_dimensions, Vector2i source_offset, ColorFormat source_color_format) const;
+
 private:
 	Vector2i kernel_size;
 	UniquePtr<float[]> kernel;
@@ -27,6 +27,7 @@ class ElementDefinition;
 class ElementDocument;
 class ElementScroll;
 class ElementStyle;
+class LayoutCache;
 class LayoutEngine;
 class ContainerBox;
 class InlineLevelBox;
@@ -573,6 +574,9 @@ public:
 	const TransformState* GetTransformState() const noexcept;
 	/// Returns the data model of this element.
 	DataModel* GetDataModel() const;
+	/// Marks this element to be visited by the next Context::Update, along with its ancestors. Update skips subtrees
+	/// where no element is marked, so anything that needs Update to process a change on an element must call this.
+	void DirtyUpdate();
 	//@}
 
 	/// Sets the instancer to use for releasing this element.
@@ -597,7 +601,9 @@ protected:
 	/// Forces the element to generate a local stacking context, regardless of the value of its z-index property.
 	void ForceLocalStackingContext();
 
-	/// Called during the update loop after children are updated.
+	/// Called during the update loop after children are updated. The update loop only visits elements marked through
+	/// DirtyUpdate() and their ancestors, so elements with per-frame work must call DirtyUpdate() every frame they need it,
+	/// e.g. from OnUpdate itself.
 	virtual void OnUpdate();
 	/// Called during render after backgrounds, borders, decorators, but before children, are rendered.
 	virtual void OnRender();
@@ -633,6 +639,9 @@ protected:
 	/// Returns true if the element has been marked as needing a re-layout.
 	virtual bool IsLayoutDirty();
 
+	/// Marks the render output of the owner document as changed.
+	void DirtyDocumentRender();
+
 	/// Returns the RML of this element and all children.
 	/// @param[out] content The content of this element and those under it, in XML form.
 	virtual void GetRML(String& content);
@@ -671,6 +680,9 @@ private:
 
 	void UpdateDefinition();
 
+	/// Dirties the layout after our children changed, which our own box may contain if we are a layout boundary.
+	void DirtyContentsLayout();
+
 	void DirtyTransformState(bool perspective_dirty, bool transform_dirty);
 	void UpdateTransformState();
 
@@ -721,6 +733,8 @@ private:
 	bool dirty_transform : 1;
 	bool dirty_perspective : 1;
 
+	bool dirty_update : 1; // This element or one of its descendants needs to be visited by the next Update().
+
 	OwnedElementList children;
 	int num_non_dom_children;
 
@@ -774,6 +788,12 @@ private:
 	float baseline;
 	float z_index;
 
+	// The containing block of the last layout, kept for formatting the element on its own as a layout boundary.
+	Vector2f layout_containing_block;
+
+	// Measurements of the element made by the layout of its ancestors, created on first use.
+	UniquePtr<LayoutCache> layout_cache;
+
 	ElementList stacking_context;
 
 	UniquePtr<TransformState> transform_state;
@@ -787,6 +807,7 @@ private:
 	friend class Rml::ContainerBox;
 	friend class Rml::InlineLevelBox;
 	friend class Rml::ReplacedBox;
+	friend class Rml::LayoutCache;
 	friend class Rml::LayoutEngine;
 	friend class Rml::ElementScroll;
 	friend RMLUICORE_API void Rml::ReleaseFontResources();
@@ -19,6 +19,7 @@ void Element::SetAttribute(const String& name, const T& value)
 	attributes[name] = variant;
 	ElementAttributes changed_attributes;
 	changed_attributes.emplace(name, std::move(variant));
+	DirtyDocumentRender();
 	OnAttributeChange(changed_attributes);
 }
 
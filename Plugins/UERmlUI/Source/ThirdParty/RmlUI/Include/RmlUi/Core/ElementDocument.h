@@ -110,6 +110,15 @@ public:
 	/// has already been called after the change. This has a performance penalty, only call when necessary.
 	void UpdateDocument();
 
+	/// Marks the render output of the document as changed. Called internally whenever an element in the document changes
+	/// in a way that may affect its rendering, such as property, attribute, layout, offset, or stacking changes.
+	void DirtyRender();
+	/// Returns true if the render output of the document may have changed since the last call to ClearRenderDirty().
+	/// Applications that retain the render output of documents (see Context::Render) must render the document again.
+	bool IsRenderDirty() const;
+	/// Clears the render dirty flag. Call before rendering the document, so that changes made during rendering are kept.
+	void ClearRenderDirty();
+
 protected:
 	/// Repositions the document if necessary.
 	void OnPropertyChange(const PropertyIdSet& changed_properties) override;
@@ -135,6 +144,8 @@ private:
 	void DirtyLayout() override;
 	/// Returns true if the document has been marked as needing a re-layout.
 	bool IsLayoutDirty() override;
+	/// Marks a layout boundary to be formatted before the next render, instead of the whole document.
+	void DirtyLayoutBoundary(Element* boundary);
 
 	/// Notify the document that media query-related properties have changed and that style sheets need to be re-evaluated.
 	void DirtyMediaQueries();
@@ -144,6 +155,9 @@ private:
 
 	/// Updates the layout if necessary.
 	void UpdateLayout();
+	/// Formats the given layout boundaries on their own, moving up to the enclosing boundary when one changes size.
+	/// @return False if the whole document needs to be formatted instead.
+	bool UpdateLayoutBoundaries(const Vector<ObserverPtr<Element>>& boundaries);
 
 	/// Updates the position of the document based on the style properties.
 	void UpdatePosition();
@@ -162,8 +176,13 @@ private:
 
 	bool layout_dirty;
 	bool position_dirty;
+	bool render_dirty;
+
+	// Layout boundaries with changed contents, formatted on their own as long as the document layout is not dirty.
+	Vector<ObserverPtr<Element>> dirty_layout_boundaries;
 
 	friend class Rml::Context;
+	friend class Rml::Element;
 	friend class Rml::Factory;
 };
 
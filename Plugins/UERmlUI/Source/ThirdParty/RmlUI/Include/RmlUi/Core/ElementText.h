@@ -6,6 +6,8 @@
 
 namespace Rml {
 
+struct TextGeometry;
+
 class RMLUICORE_API ElementText final : public Element {
 public:
 	RMLUI_RTTI_DefineWithParent(ElementText, Element)
@@ -78,11 +80,8 @@ private:
 
 	LineList lines;
 
-	struct TexturedGeometry {
-		Geometry geometry;
-		Texture texture;
-	};
-	Vector<TexturedGeometry> geometry;
+	// The geometry of our lines, possibly shared with other text elements showing the same lines.
+	SharedPtr<TextGeometry> geometry;
 
 	// The decoration geometry we've generated for this string.
 	UniquePtr<Geometry> decoration;
@@ -105,6 +104,15 @@ private:
 
 	bool font_effects_dirty;
 	FontEffectsHandle font_effects_handle;
+
+	// Widths of the whole tokens measured by GenerateLine, kept until the text or its font changes so that laying the
+	// text out again in a different width does not measure every word again.
+	struct TokenWidth {
+		Character previous_codepoint = Character::Null;
+		int width = -1;
+	};
+	UnorderedMap<uint64_t, TokenWidth> token_widths;
+	FontFaceHandle token_widths_font_face_handle;
 };
 
 } // namespace Rml
@@ -46,6 +46,11 @@ public:
 	size_t GetFingerprint() const;
 	void SetFingerprint(size_t fingerprint);
 
+	/// Returns the declaration the effect was instanced from, such as 'outline(1px black)', or empty if it was not
+	/// instanced from a style property. Joining the declarations of a list with commas gives a valid 'font-effect' value.
+	const String& GetDeclaration() const;
+	void SetDeclaration(const String& declaration);
+
 protected:
 	// Helper function to copy the alpha value to the colour channels for each pixel, assuming RGBA-ordered bytes, resulting in a grayscale texture.
 	static void FillColorValuesFromAlpha(byte* destination, Vector2i dimensions, int stride);
@@ -58,6 +63,8 @@ private:
 
 	// A hash value identifying the properties that affected the generation of the effect's geometry and texture data.
 	size_t fingerprint;
+
+	String declaration;
 };
 
 } // namespace Rml
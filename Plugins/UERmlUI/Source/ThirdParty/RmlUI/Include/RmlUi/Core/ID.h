@@ -154,6 +154,8 @@ enum class PropertyId : uint8_t {
 	NavDown,
 	NavLeft,
 
+	Contain,
+
 	RmlUi_Language,
 	RmlUi_Direction,
 
@@ -11,6 +11,7 @@ namespace Rml {
 class Geometry;
 class CompiledFilter;
 class CompiledShader;
+class TextGeometryCache;
 class TextureDatabase;
 class Texture;
 class RenderManagerAccess;
@@ -47,6 +48,9 @@ public:
 	RenderManager(RenderInterface* render_interface);
 	~RenderManager();
 
+	/// Returns the render interface this manager submits to.
+	RenderInterface* GetRenderInterface() const { return render_interface; }
+
 	void PrepareRender(Vector2i dimensions);
 	void SetViewport(Vector2i dimensions);
 	Vector2i GetViewport() const;
@@ -84,6 +88,16 @@ public:
 
 	CompiledFilter SaveLayerAsMaskImage();
 
+	/// Limits the time spent generating callback textures (such as font effect layers) per call to PrepareRender. Textures that
+	/// do not fit are generated on a later frame, and geometry using them is not rendered until then. Texture callbacks may
+	/// also defer themselves while generating on a worker thread. A negative budget (the default) generates every texture
+	/// synchronously on first use.
+	void SetCallbackTextureBudget(double budget_seconds);
+
+	/// Number of draws skipped so far because their callback texture was still pending. Compare before and after rendering
+	/// to find out whether the result is incomplete.
+	int GetNumDeferredTextureDraws() const { return num_deferred_texture_draws; }
+
 private:
 	void ApplyClipMask(const ClipMaskGeometryList& clip_elements);
 
@@ -113,9 +127,11 @@ private:
 
 	StableVector<GeometryData> geometry_list;
 	UniquePtr<TextureDatabase> texture_database;
+	UniquePtr<TextGeometryCache> text_geometry_cache;
 
 	int compiled_filter_count = 0;
 	int compiled_shader_count = 0;
+	int num_deferred_texture_draws = 0;
 
 	RenderState state;
 	Vector2i viewport_dimensions;
@@ -60,6 +60,26 @@ public:
 
 	/// Deactivate keyboard (for touchscreen devices).
 	virtual void DeactivateKeyboard();
+
+	/// Run a task on another thread, such as generating a font effect texture. The task only touches data it owns, and
+	/// completion is polled by the caller, so no synchronization is required from the implementation.
+	/// @param[in] task The task to run.
+	/// @return True if the task was scheduled, false to have the caller run it synchronously instead.
+	virtual bool RunAsync(Function<void()> task);
+
+	/// Look up a generated texture, such as a font effect layer, in a cache persisted between runs. May be called from any thread.
+	/// @param[in] key A hash of everything that determines the texture contents.
+	/// @param[out] data The premultiplied RGBA8 texture data.
+	/// @param[out] dimensions The dimensions of the texture.
+	/// @return True if the texture was found.
+	virtual bool LoadGeneratedTexture(uint64_t key, Vector<byte>& data, Vector2i& dimensions);
+
+	/// Offer a newly generated texture to the cache, so that later runs can load it instead of generating it again. May be
+	/// called from any thread.
+	/// @param[in] key A hash of everything that determines the texture contents.
+	/// @param[in] data The premultiplied RGBA8 texture data.
+	/// @param[in] dimensions The dimensions of the texture.
+	virtual void StoreGeneratedTexture(uint64_t key, const Vector<byte>& data, Vector2i dimensions);
 };
 
 } // namespace Rml
@@ -19,9 +19,22 @@ Rml::CallbackTexture::operator Texture() const
 }
 
 CallbackTextureInterface::CallbackTextureInterface(RenderManager& render_manager, RenderInterface& render_interface, TextureHandle& texture_handle,
-	Vector2i& dimensions) : render_manager(render_manager), render_interface(render_interface), texture_handle(texture_handle), dimensions(dimensions)
+	Vector2i& dimensions, bool* deferred) :
+	render_manager(render_manager), render_interface(render_interface), texture_handle(texture_handle), dimensions(dimensions), deferred(deferred)
 {}
 
+bool CallbackTextureInterface::CanDefer() const
+{
+	return deferred != nullptr;
+}
+
+void CallbackTextureInterface::Defer() const
+{
+	RMLUI_ASSERTMSG(deferred, "Callback texture deferred while deferral is not allowed, see CanDefer().");
+	if (deferred)
+		*deferred = true;
+}
+
 bool CallbackTextureInterface::GenerateTexture(Span<const byte> source, Vector2i new_dimensions) const
 {
 	if (texture_handle)
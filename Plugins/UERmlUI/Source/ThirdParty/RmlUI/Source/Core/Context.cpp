@@ -215,13 +215,16 @@ bool Context::Update()
 	return true;
 }
 
-bool Context::Render()
+bool Context::Render(RenderDocumentHandler* document_handler)
 {
 	RMLUI_ZoneScoped;
 
 	render_manager->PrepareRender(dimensions);
 
-	root->Render();
+	if (document_handler)
+		RenderDocuments(*document_handler);
+	else
+		root->Render();
 
 	// Render the cursor proxy so that any attached drag clone will be rendered below the cursor.
 	if (drag_clone)
@@ -237,6 +240,34 @@ bool Context::Render()
 	return true;
 }
 
+void Context::RenderDocuments(RenderDocumentHandler& document_handler)
+{
+	// The root element has no decoration of its own, and every document forms a local stacking context. Thus, the root's
+	// stacking context consists of exactly the visible documents, in render order.
+	root->UpdateAbsoluteOffsetAndRenderBoxData();
+	if (root->stacking_context_dirty)
+		root->BuildLocalStackingContext();
+
+	for (Element* element : root->stacking_context)
+	{
+		ElementDocument* document = element->GetOwnerDocument();
+		RMLUI_ASSERT(document == element);
+
+		render_manager->ResetState();
+		if (document_handler.OnRenderDocumentBegin(document))
+		{
+			const int num_deferred_draws = render_manager->GetNumDeferredTextureDraws();
+			element->Render();
+			render_manager->ResetState();
+			document_handler.OnRenderDocumentEnd(document);
+
+			// Some textures were still pending, so the recording is incomplete. Record it again next frame.
+			if (render_manager->GetNumDeferredTextureDraws() != num_deferred_draws)
+				document->DirtyRender();
+		}
+	}
+}
+
 ElementDocument* Context::CreateDocument(const String& instancer_name)
 {
 	ElementPtr element = Factory::InstanceElement(nullptr, instancer_name, documents_base_tag, XMLAttributes());
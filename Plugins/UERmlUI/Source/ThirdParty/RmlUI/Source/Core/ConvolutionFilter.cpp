@@ -1,10 +1,136 @@
 #include "../../Include/RmlUi/Core/ConvolutionFilter.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
+#include "Memory.h"
 #include <float.h>
+#include <math.h>
 #include <string.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define RMLUI_CONVOLUTION_SSE
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+	#include <arm_neon.h>
+	#define RMLUI_CONVOLUTION_NEON
+#endif
+
 namespace Rml {
 
+namespace {
+
+	using FloatBuffer = DynamicArray<float, GlobalStackAllocator<float>>;
+	using IntBuffer = DynamicArray<int, GlobalStackAllocator<int>>;
+
+	// accumulator[i] += source[i] * weight
+	void MultiplyAdd(float* accumulator, const float* source, const float weight, const int count)
+	{
+		int i = 0;
+#if defined(RMLUI_CONVOLUTION_SSE)
+		const __m128 w = _mm_set1_ps(weight);
+		for (; i + 4 <= count; i += 4)
+			_mm_storeu_ps(accumulator + i, _mm_add_ps(_mm_loadu_ps(accumulator + i), _mm_mul_ps(_mm_loadu_ps(source + i), w)));
+#elif defined(RMLUI_CONVOLUTION_NEON)
+		const float32x4_t w = vdupq_n_f32(weight);
+		for (; i + 4 <= count; i += 4)
+			vst1q_f32(accumulator + i, vaddq_f32(vld1q_f32(accumulator + i), vmulq_f32(vld1q_f32(source + i), w)));
+#endif
+		for (; i < count; ++i)
+			accumulator[i] += source[i] * weight;
+	}
+
+	// accumulator[i] = max(accumulator[i], source[i] * weight)
+	void MultiplyMax(float* accumulator, const float* source, const float weight, const int count)
+	{
+		int i = 0;
+#if defined(RMLUI_CONVOLUTION_SSE)
+		const __m128 w = _mm_set1_ps(weight);
+		for (; i + 4 <= count; i += 4)
+			_mm_storeu_ps(accumulator + i, _mm_max_ps(_mm_loadu_ps(accumulator + i), _mm_mul_ps(_mm_loadu_ps(source + i), w)));
+#elif defined(RMLUI_CONVOLUTION_NEON)
+		const float32x4_t w = vdupq_n_f32(weight);
+		for (; i + 4 <= count; i += 4)
+			vst1q_f32(accumulator + i, vmaxq_f32(vld1q_f32(accumulator + i), vmulq_f32(vld1q_f32(source + i), w)));
+#endif
+		for (; i < count; ++i)
+			accumulator[i] = Math::Max(accumulator[i], source[i] * weight);
+	}
+
+	// accumulator[i] = max(accumulator[i], source[i])
+	void Max(float* accumulator, const float* source, const int count)
+	{
+		int i = 0;
+#if defined(RMLUI_CONVOLUTION_SSE)
+		for (; i + 4 <= count; i += 4)
+			_mm_storeu_ps(accumulator + i, _mm_max_ps(_mm_loadu_ps(accumulator + i), _mm_loadu_ps(source + i)));
+#elif defined(RMLUI_CONVOLUTION_NEON)
+		for (; i + 4 <= count; i += 4)
+			vst1q_f32(accumulator + i, vmaxq_f32(vld1q_f32(accumulator + i), vld1q_f32(source + i)));
+#endif
+		for (; i < count; ++i)
+			accumulator[i] = Math::Max(accumulator[i], source[i]);
+	}
+
+	// Sliding window maximum of 'length' values for every window start in [0, count - length], with a constant number of
+	// comparisons per value regardless of the window length (van Herk / Gil-Werman). Uses two scratch rows of 'count' values.
+	void WindowMax(float* destination, const float* source, const int count, const int length, float* prefix, float* suffix)
+	{
+		if (length == 1)
+		{
+			memcpy(destination, source, sizeof(float) * count);
+			return;
+		}
+
+		// Running maxima within each block of 'length' values, from the left and from the right. Any window spans at most
+		// two blocks, so its maximum combines the suffix of the first block with the prefix of the second.
+		for (int i = 0; i < count; ++i)
+			prefix[i] = (i % length == 0 ? source[i] : Math::Max(prefix[i - 1], source[i]));
+
+		for (int i = count - 1; i >= 0; --i)
+			suffix[i] = ((i + 1) % length == 0 || i == count - 1 ? source[i] : Math::Max(suffix[i + 1], source[i]));
+
+		for (int i = 0; i + length <= count; ++i)
+			destination[i] = Math::Max(suffix[i], prefix[i + length - 1]);
+	}
+
+	// Tries to factor the kernel into a column vector times a row vector.
+	bool FactorKernel(const float* kernel, const Vector2i kernel_size, float* column, float* row)
+	{
+		int pivot_index = 0;
+		float max_weight = 0.f;
+		for (int i = 0; i < kernel_size.x * kernel_size.y; ++i)
+		{
+			if (Math::Absolute(kernel[i]) > max_weight)
+			{
+				max_weight = Math::Absolute(kernel[i]);
+				pivot_index = i;
+			}
+		}
+		if (max_weight <= 0.f)
+			return false;
+
+		const int pivot_x = pivot_index % kernel_size.x;
+		const int pivot_y = pivot_index / kernel_size.x;
+		const float pivot = kernel[pivot_index];
+
+		for (int x = 0; x < kernel_size.x; ++x)
+			row[x] = kernel[pivot_y * kernel_size.x + x] / pivot;
+		for (int y = 0; y < kernel_size.y; ++y)
+			column[y] = kernel[y * kernel_size.x + pivot_x];
+
+		const float tolerance = 1e-5f * max_weight;
+		for (int y = 0; y < kernel_size.y; ++y)
+		{
+			for (int x = 0; x < kernel_size.x; ++x)
+			{
+				if (Math::Absolute(kernel[y * kernel_size.x + x] - column[y] * row[x]) > tolerance)
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+} // namespace
+
 ConvolutionFilter::ConvolutionFilter() {}
 
 ConvolutionFilter::~ConvolutionFilter() {}
@@ -50,6 +176,182 @@ void ConvolutionFilter::Run(byte* destination, const Vector2i destination_dimens
 	const int source_bytes_per_pixel = (source_color_format == ColorFormat::RGBA8 ? 4 : 1);
 	const int source_alpha_offset = (source_color_format == ColorFormat::RGBA8 ? 3 : 0);
 
+	const Vector2i kernel_radius = (kernel_size - Vector2i(1)) / 2;
+	const int width = destination_dimensions.x;
+	const int height = destination_dimensions.y;
+	if (width <= 0 || height <= 0)
+		return;
+
+	// Copy the source opacity into a float image padded with zeros, such that destination pixel (x, y) is the kernel
+	// applied to the padded pixels [x, x + kernel_size.x) * [y, y + kernel_size.y). The inner loops below then run over
+	// whole contiguous rows without any bounds checks, one kernel value at a time.
+	const Vector2i padded_dimensions = destination_dimensions + kernel_size - Vector2i(1);
+	const Vector2i padded_origin = -source_offset - kernel_radius;
+	FloatBuffer padded(size_t(padded_dimensions.x) * size_t(padded_dimensions.y));
+
+	for (int py = 0; py < padded_dimensions.y; ++py)
+	{
+		float* padded_row = padded.data() + py * padded_dimensions.x;
+		const int source_y = py + padded_origin.y;
+
+		if (source_y < 0 || source_y >= source_dimensions.y)
+		{
+			memset(padded_row, 0, sizeof(float) * padded_dimensions.x);
+			continue;
+		}
+
+		const byte* source_row = source + (source_y * source_dimensions.x) * source_bytes_per_pixel + source_alpha_offset;
+		for (int px = 0; px < padded_dimensions.x; ++px)
+		{
+			const int source_x = px + padded_origin.x;
+			padded_row[px] = (source_x >= 0 && source_x < source_dimensions.x ? float(source_row[source_x * source_bytes_per_pixel]) : 0.f);
+		}
+	}
+
+	FloatBuffer result(size_t(width) * size_t(height));
+	memset(result.data(), 0, sizeof(float) * width * height);
+
+	if (operation == FilterOperation::Sum)
+	{
+		FloatBuffer column(kernel_size.y);
+		FloatBuffer row(kernel_size.x);
+
+		if (kernel_size.x > 1 && kernel_size.y > 1 && FactorKernel(kernel.get(), kernel_size, column.data(), row.data()))
+		{
+			// Separable kernel, such as a gaussian blur. Run a horizontal pass over all padded rows, then a vertical pass.
+			FloatBuffer horizontal(size_t(width) * size_t(padded_dimensions.y));
+			memset(horizontal.data(), 0, sizeof(float) * width * padded_dimensions.y);
+
+			for (int py = 0; py < padded_dimensions.y; ++py)
+			{
+				for (int kernel_x = 0; kernel_x < kernel_size.x; ++kernel_x)
+				{
+					if (row[kernel_x] != 0.f)
+						MultiplyAdd(horizontal.data() + py * width, padded.data() + py * padded_dimensions.x + kernel_x, row[kernel_x], width);
+				}
+			}
+
+			for (int y = 0; y < height; ++y)
+			{
+				for (int kernel_y = 0; kernel_y < kernel_size.y; ++kernel_y)
+				{
+					if (column[kernel_y] != 0.f)
+						MultiplyAdd(result.data() + y * width, horizontal.data() + (y + kernel_y) * width, column[kernel_y], width);
+				}
+			}
+		}
+		else
+		{
+			for (int y = 0; y < height; ++y)
+			{
+				for (int kernel_y = 0; kernel_y < kernel_size.y; ++kernel_y)
+				{
+					const float* kernel_row = kernel.get() + kernel_y * kernel_size.x;
+					const float* padded_row = padded.data() + (y + kernel_y) * padded_dimensions.x;
+
+					for (int kernel_x = 0; kernel_x < kernel_size.x; ++kernel_x)
+					{
+						if (kernel_row[kernel_x] != 0.f)
+							MultiplyAdd(result.data() + y * width, padded_row + kernel_x, kernel_row[kernel_x], width);
+					}
+				}
+			}
+		}
+	}
+	else
+	{
+		// Dilation. Each kernel row usually has a run of unit weights (the inside of an outline disc), possibly surrounded by
+		// a few fractional weights (its anti-aliased edge). Runs are evaluated as sliding window maxima, shared by all kernel
+		// rows with the same run length, and only the remaining weights are applied individually.
+		IntBuffer run_start(kernel_size.y);
+		IntBuffer run_length(kernel_size.y);
+
+		for (int kernel_y = 0; kernel_y < kernel_size.y; ++kernel_y)
+		{
+			const float* kernel_row = kernel.get() + kernel_y * kernel_size.x;
+			int best_start = 0, best_length = 0;
+			for (int start = 0; start < kernel_size.x;)
+			{
+				int end = start;
+				while (end < kernel_size.x && kernel_row[end] == 1.f)
+					++end;
+				if (end - start > best_length)
+				{
+					best_start = start;
+					best_length = end - start;
+				}
+				start = end + 1;
+			}
+			run_start[kernel_y] = best_start;
+			run_length[kernel_y] = best_length;
+		}
+
+		const int num_windows_max = padded_dimensions.x;
+		FloatBuffer windows(size_t(num_windows_max) * size_t(padded_dimensions.y));
+		FloatBuffer prefix(padded_dimensions.x);
+		FloatBuffer suffix(padded_dimensions.x);
+
+		for (int length = 1; length <= kernel_size.x; ++length)
+		{
+			bool used = false;
+			for (int kernel_y = 0; kernel_y < kernel_size.y && !used; ++kernel_y)
+				used = (run_length[kernel_y] == length);
+			if (!used)
+				continue;
+
+			for (int py = 0; py < padded_dimensions.y; ++py)
+			{
+				WindowMax(windows.data() + py * num_windows_max, padded.data() + py * padded_dimensions.x, padded_dimensions.x, length, prefix.data(),
+					suffix.data());
+			}
+
+			for (int kernel_y = 0; kernel_y < kernel_size.y; ++kernel_y)
+			{
+				if (run_length[kernel_y] != length)
+					continue;
+
+				const int start = run_start[kernel_y];
+				for (int y = 0; y < height; ++y)
+					Max(result.data() + y * width, windows.data() + (y + kernel_y) * num_windows_max + start, width);
+			}
+		}
+
+		for (int kernel_y = 0; kernel_y < kernel_size.y; ++kernel_y)
+		{
+			const float* kernel_row = kernel.get() + kernel_y * kernel_size.x;
+			const int start = run_start[kernel_y];
+			const int end = start + run_length[kernel_y];
+
+			for (int kernel_x = 0; kernel_x < kernel_size.x; ++kernel_x)
+			{
+				if ((kernel_x >= start && kernel_x < end) || kernel_row[kernel_x] <= 0.f)
+					continue;
+
+				for (int y = 0; y < height; ++y)
+					MultiplyMax(result.data() + y * width, padded.data() + (y + kernel_y) * padded_dimensions.x + kernel_x, kernel_row[kernel_x], width);
+			}
+		}
+	}
+
+	for (int y = 0; y < height; ++y)
+	{
+		const float* result_row = result.data() + y * width;
+		byte* destination_row = destination + y * destination_stride + destination_alpha_offset;
+
+		for (int x = 0; x < width; ++x)
+			destination_row[x * destination_bytes_per_pixel] = byte(Math::Min(255.f, result_row[x]));
+	}
+}
+
+void ConvolutionFilter::RunReference(byte* destination, const Vector2i destination_dimensions, const int destination_stride,
+	const ColorFormat destination_color_format, const byte* source, const Vector2i source_dimensions, const Vector2i source_offset,
+	const ColorFormat source_color_format) const
+{
+	const int destination_bytes_per_pixel = (destination_color_format == ColorFormat::RGBA8 ? 4 : 1);
+	const int destination_alpha_offset = (destination_color_format == ColorFormat::RGBA8 ? 3 : 0);
+	const int source_bytes_per_pixel = (source_color_format == ColorFormat::RGBA8 ? 4 : 1);
+	const int source_alpha_offset = (source_color_format == ColorFormat::RGBA8 ? 3 : 0);
+
 	const Vector2i kernel_radius = (kernel_size - Vector2i(1)) / 2;
 
 	for (int y = 0; y < destination_dimensions.y; ++y)
@@ -26,6 +26,7 @@
 #include "ElementStyle.h"
 #include "EventDispatcher.h"
 #include "EventSpecification.h"
+#include "Layout/LayoutCache.h"
 #include "Layout/LayoutEngine.h"
 #include "PluginRegistry.h"
 #include "Pool.h"
@@ -67,8 +68,8 @@ static float GetScrollOffsetDelta(ScrollAlignment alignment, float begin_offset,
 Element::Element(const String& tag) :
 	local_stacking_context(false), local_stacking_context_forced(false), stacking_context_dirty(false), computed_values_are_default_initialized(true),
 	visible(true), offset_fixed(false), absolute_offset_dirty(true), rounded_main_padding_size_dirty(true), dirty_definition(false),
-	dirty_child_definitions(false), dirty_animation(false), dirty_transition(false), dirty_transform(false), dirty_perspective(false), tag(tag),
-	relative_offset_base(0, 0), relative_offset_position(0, 0), absolute_offset(0, 0), scroll_offset(0, 0)
+	dirty_child_definitions(false), dirty_animation(false), dirty_transition(false), dirty_transform(false), dirty_perspective(false),
+	dirty_update(true), tag(tag), relative_offset_base(0, 0), relative_offset_position(0, 0), absolute_offset(0, 0), scroll_offset(0, 0)
 {
 	RMLUI_ASSERT(tag == StringUtilities::ToLower(tag));
 	parent = nullptr;
@@ -119,6 +120,9 @@ void Element::Update(float dp_ratio, Vector2f vp_dimensions)
 	RMLUI_ZoneText(name.c_str(), name.size());
 #endif
 
+	// Cleared before anything runs, so changes made during this update mark the element again for the next one.
+	dirty_update = false;
+
 	OnUpdate();
 
 	HandleTransitionProperty();
@@ -139,13 +143,21 @@ void Element::Update(float dp_ratio, Vector2f vp_dimensions)
 
 	meta->effects.InstanceEffects();
 
+	// Children that nothing has marked since their last update have no work to do in their entire subtree.
 	for (size_t i = 0; i < children.size(); i++)
-		children[i]->Update(dp_ratio, vp_dimensions);
+	{
+		if (children[i]->dirty_update)
+			children[i]->Update(dp_ratio, vp_dimensions);
+	}
 
-	if (!animations.empty() && IsVisible(true))
+	if (!animations.empty())
 	{
-		if (Context* ctx = GetContext())
-			ctx->RequestNextUpdate(0);
+		DirtyUpdate();
+		if (IsVisible(true))
+		{
+			if (Context* ctx = GetContext())
+				ctx->RequestNextUpdate(0);
+		}
 	}
 }
 
@@ -167,7 +179,10 @@ void Element::UpdateProperties(const float dp_ratio, const Vector2f vp_dimension
 		// Computed values are just calculated and can safely be used in OnPropertyChange.
 		// However, new properties set during this call will not be available until the next update loop.
 		if (!dirty_properties.Empty())
+		{
+			DirtyDocumentRender();
 			OnPropertyChange(dirty_properties);
+		}
 	}
 }
 
@@ -831,6 +846,7 @@ void Element::RemoveAttribute(const String& name)
 
 		ElementAttributes changed_attributes;
 		changed_attributes.emplace(name, Variant());
+		DirtyDocumentRender();
 		OnAttributeChange(changed_attributes);
 	}
 }
@@ -873,6 +889,7 @@ void Element::SetAttributes(const ElementAttributes& _attributes)
 	for (auto& pair : _attributes)
 		attributes[pair.first] = pair.second;
 
+	DirtyDocumentRender();
 	OnAttributeChange(_attributes);
 }
 
@@ -1323,7 +1340,7 @@ Element* Element::AppendChild(ElementPtr child, bool dom_element)
 	DirtyDefinition(DirtyNodes::Self);
 
 	if (dom_element)
-		DirtyLayout();
+		DirtyContentsLayout();
 
 	return child_ptr;
 }
@@ -1357,7 +1374,7 @@ Element* Element::InsertBefore(ElementPtr child, Element* adjacent_element)
 		if ((int)child_index >= GetNumChildren())
 			num_non_dom_children++;
 		else
-			DirtyLayout();
+			DirtyContentsLayout();
 
 		children.insert(children.begin() + child_index, std::move(child));
 		child_ptr->SetParent(this);
@@ -1450,7 +1467,7 @@ ElementPtr Element::RemoveChild(Element* child)
 
 			detached_child->SetParent(nullptr);
 
-			DirtyLayout();
+			DirtyContentsLayout();
 			DirtyStackingContext();
 			DirtyDefinition(DirtyNodes::Self);
 
@@ -1629,6 +1646,14 @@ DataModel* Element::GetDataModel() const
 	return data_model;
 }
 
+void Element::DirtyUpdate()
+{
+	// A marked ancestor means the rest of the chain is marked too, or is being updated and still has to visit it.
+	dirty_update = true;
+	for (Element* ancestor = parent; ancestor && !ancestor->dirty_update; ancestor = ancestor->parent)
+		ancestor->dirty_update = true;
+}
+
 void Element::SetInstancer(ElementInstancer* _instancer)
 {
 	// Only record the first instancer being set as some instancers call other instancers to do their dirty work, in
@@ -1673,6 +1698,10 @@ void Element::OnAttributeChange(const ElementAttributes& changed_attributes)
 		{
 			meta->style.SetClassNames(value.Get<String>());
 		}
+		else if (attribute == "data-layout-boundary")
+		{
+			DirtyLayout();
+		}
 		else if (((attribute == "colspan" || attribute == "rowspan") && meta->computed_values.display() == Style::Display::TableCell) ||
 			(attribute == "span" &&
 				(meta->computed_values.display() == Style::Display::TableColumn ||
@@ -1767,33 +1796,30 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 		changed_properties.Contains(PropertyId::Left)      //
 	);
 
-	// See if the document layout needs to be updated.
-	if (!IsLayoutDirty())
-	{
-		// Force a relayout if any of the changed properties require it.
-		const PropertyIdSet changed_properties_forcing_layout =
-			(changed_properties & StyleSheetSpecification::GetRegisteredPropertiesForcingLayout());
+	// Force a relayout if any of the changed properties require it. This is done even if the document layout is already
+	// dirty, as DirtyLayout() also clears the layout measurements cached on this element and its ancestors.
+	const PropertyIdSet changed_properties_forcing_layout =
+		(changed_properties & StyleSheetSpecification::GetRegisteredPropertiesForcingLayout());
 
-		if (!changed_properties_forcing_layout.Empty())
-		{
+	if (!changed_properties_forcing_layout.Empty())
+	{
+		DirtyLayout();
+	}
+	else if (top_right_bottom_left_changed)
+	{
+		// Normally, the position properties only affect the position of the element and not the layout. Thus, these properties are not registered
+		// as affecting layout. However, when absolutely positioned elements with both left & right, or top & bottom are set to definite values,
+		// they affect the size of the element and thereby also the layout. This layout-dirtying condition needs to be registered manually.
+		using namespace Style;
+		const ComputedValues& computed = GetComputedValues();
+		const bool absolutely_positioned = (computed.position() == Position::Absolute || computed.position() == Position::Fixed);
+		const bool sized_width =
+			(computed.width().type == Width::Auto && computed.left().type != Left::Auto && computed.right().type != Right::Auto);
+		const bool sized_height =
+			(computed.height().type == Height::Auto && computed.top().type != Top::Auto && computed.bottom().type != Bottom::Auto);
+
+		if (absolutely_positioned && (sized_width || sized_height))
 			DirtyLayout();
-		}
-		else if (top_right_bottom_left_changed)
-		{
-			// Normally, the position properties only affect the position of the element and not the layout. Thus, these properties are not registered
-			// as affecting layout. However, when absolutely positioned elements with both left & right, or top & bottom are set to definite values,
-			// they affect the size of the element and thereby also the layout. This layout-dirtying condition needs to be registered manually.
-			using namespace Style;
-			const ComputedValues& computed = GetComputedValues();
-			const bool absolutely_positioned = (computed.position() == Position::Absolute || computed.position() == Position::Fixed);
-			const bool sized_width =
-				(computed.width().type == Width::Auto && computed.left().type != Left::Auto && computed.right().type != Right::Auto);
-			const bool sized_height =
-				(computed.height().type == Height::Auto && computed.top().type != Top::Auto && computed.bottom().type != Bottom::Auto);
-
-			if (absolutely_positioned && (sized_width || sized_height))
-				DirtyLayout();
-		}
 	}
 
 	// Update the position.
@@ -1925,11 +1951,13 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 	if (changed_properties.Contains(PropertyId::Animation))
 	{
 		dirty_animation = true;
+		DirtyUpdate();
 	}
 	// Check for `transition' changes
 	if (changed_properties.Contains(PropertyId::Transition))
 	{
 		dirty_transition = true;
+		DirtyUpdate();
 	}
 }
 
@@ -1941,10 +1969,34 @@ void Element::OnChildRemove(Element* /*child*/) {}
 
 void Element::DirtyLayout()
 {
-	if (Element* document = GetOwnerDocument())
+	if (layout_cache)
+		layout_cache->Clear();
+
+	// Our own box may change, so the closest layout boundary is found among our ancestors.
+	if (parent)
+		parent->DirtyContentsLayout();
+}
+
+void Element::DirtyContentsLayout()
+{
+	LayoutCache::Invalidate(this);
+
+	ElementDocument* document = GetOwnerDocument();
+	if (!document || document->layout_dirty)
+		return;
+
+	if (Element* boundary = LayoutEngine::FindLayoutBoundary(this))
+		document->DirtyLayoutBoundary(boundary);
+	else
 		document->DirtyLayout();
 }
 
+void Element::DirtyDocumentRender()
+{
+	if (owner_document)
+		owner_document->DirtyRender();
+}
+
 bool Element::IsLayoutDirty()
 {
 	if (Element* document = GetOwnerDocument())
@@ -2125,6 +2177,7 @@ void Element::SetParent(Element* _parent)
 	if (parent)
 	{
 		// We need to update our definition and make sure we inherit the properties of our new parent.
+		// Both mark this element and the new ancestors for the next update.
 		DirtyDefinition(DirtyNodes::Self);
 		meta->style.DirtyInheritedProperties();
 	}
@@ -2164,6 +2217,7 @@ void Element::SetParent(Element* _parent)
 
 void Element::DirtyAbsoluteOffset()
 {
+	DirtyDocumentRender();
 	if (!absolute_offset_dirty)
 		DirtyAbsoluteOffsetRecursive();
 }
@@ -2423,6 +2477,8 @@ void Element::AddToStackingContext(Vector<StackingContextChild>& stacking_childr
 
 void Element::DirtyStackingContext()
 {
+	DirtyDocumentRender();
+
 	// Find the first ancestor that has a local stacking context, that is our stacking context parent.
 	Element* stacking_context_parent = this;
 	while (stacking_context_parent && !stacking_context_parent->local_stacking_context)
@@ -2442,9 +2498,13 @@ void Element::DirtyDefinition(DirtyNodes dirty_nodes)
 	case DirtyNodes::SelfAndSiblings:
 		dirty_definition = true;
 		if (parent)
+		{
 			parent->dirty_child_definitions = true;
+			parent->DirtyUpdate();
+		}
 		break;
 	}
+	DirtyUpdate();
 }
 
 void Element::UpdateDefinition()
@@ -2464,8 +2524,12 @@ void Element::UpdateDefinition()
 	if (dirty_child_definitions)
 	{
 		dirty_child_definitions = false;
+		// Only called while this element is being updated, which goes on to visit the marked children.
 		for (const ElementPtr& child : children)
+		{
 			child->dirty_definition = true;
+			child->dirty_update = true;
+		}
 	}
 }
 
@@ -2488,6 +2552,9 @@ bool Element::Animate(PropertyId id, const Property& target_value, float duratio
 			animations.erase(it_animation);
 	}
 
+	if (result)
+		DirtyUpdate();
+
 	return result;
 }
 
@@ -2624,7 +2691,10 @@ bool Element::StartTransition(const Transition& transition, const Property& star
 	bool result = it->AddKey(duration, target_value, *this, transition.tween, true);
 
 	if (result)
+	{
 		SetProperty(transition.id, start_value);
+		DirtyUpdate();
+	}
 	else
 		animations.erase(it);
 
@@ -2793,6 +2863,8 @@ void Element::AdvanceAnimations()
 
 void Element::DirtyTransformState(bool perspective_dirty, bool transform_dirty)
 {
+	if (perspective_dirty || transform_dirty)
+		DirtyDocumentRender();
 	dirty_perspective |= perspective_dirty;
 	dirty_transform |= transform_dirty;
 }
@@ -9,6 +9,7 @@
 #include "DocumentHeader.h"
 #include "ElementStyle.h"
 #include "EventDispatcher.h"
+#include "Layout/LayoutCache.h"
 #include "Layout/LayoutDetails.h"
 #include "Layout/LayoutEngine.h"
 #include "StreamFile.h"
@@ -150,6 +151,7 @@ ElementDocument::ElementDocument(const String& tag) : Element(tag)
 
 	layout_dirty = true;
 	position_dirty = false;
+	render_dirty = true;
 
 	ForceLocalStackingContext();
 	SetOwnerDocument(this);
@@ -490,6 +492,16 @@ void ElementDocument::UpdateLayout()
 {
 	// Note: Carefully consider when to call this function for performance reasons.
 	// Ideally, only called once per update loop.
+	if (!layout_dirty && !dirty_layout_boundaries.empty())
+	{
+		RMLUI_ZoneScopedN("LayoutBoundaries");
+
+		// As with the whole document below, anything dirtied while formatting the boundaries is ignored.
+		const Vector<ObserverPtr<Element>> boundaries = std::move(dirty_layout_boundaries);
+		layout_dirty = !UpdateLayoutBoundaries(boundaries);
+	}
+	dirty_layout_boundaries.clear();
+
 	if (layout_dirty)
 	{
 		RMLUI_ZoneScoped;
@@ -507,6 +519,38 @@ void ElementDocument::UpdateLayout()
 	}
 }
 
+bool ElementDocument::UpdateLayoutBoundaries(const Vector<ObserverPtr<Element>>& boundaries)
+{
+	SmallUnorderedSet<Element*> dirty_boundaries;
+	for (const ObserverPtr<Element>& boundary : boundaries)
+	{
+		// Skip boundaries that have been destroyed or moved out of the document since they were dirtied.
+		if (boundary && boundary->GetOwnerDocument() == this)
+			dirty_boundaries.insert(boundary.get());
+	}
+
+	for (Element* boundary : dirty_boundaries)
+	{
+		// Boundaries inside another dirty boundary are formatted along with it.
+		bool nested = false;
+		for (Element* ancestor = boundary->GetParentNode(); ancestor && ancestor != this && !nested; ancestor = ancestor->GetParentNode())
+			nested = (dirty_boundaries.find(ancestor) != dirty_boundaries.end());
+		if (nested)
+			continue;
+
+		// The boundary may no longer qualify after its own properties changed, and formatting it may change its size. In
+		// either case, continue with the next boundary further up.
+		Element* element = LayoutEngine::FindLayoutBoundary(boundary);
+		while (element && !LayoutEngine::FormatLayoutBoundary(element))
+			element = LayoutEngine::FindLayoutBoundary(element->GetParentNode());
+
+		if (!element)
+			return false;
+	}
+
+	return true;
+}
+
 void ElementDocument::UpdatePosition()
 {
 	if (position_dirty)
@@ -555,7 +599,37 @@ void ElementDocument::DirtyPosition()
 
 void ElementDocument::DirtyLayout()
 {
+	LayoutCache::Invalidate(this);
+
 	layout_dirty = true;
+	render_dirty = true;
+}
+
+void ElementDocument::DirtyLayoutBoundary(Element* boundary)
+{
+	render_dirty = true;
+
+	for (const ObserverPtr<Element>& dirty_boundary : dirty_layout_boundaries)
+	{
+		if (dirty_boundary.get() == boundary)
+			return;
+	}
+	dirty_layout_boundaries.push_back(boundary->GetObserverPtr());
+}
+
+void ElementDocument::DirtyRender()
+{
+	render_dirty = true;
+}
+
+bool ElementDocument::IsRenderDirty() const
+{
+	return render_dirty;
+}
+
+void ElementDocument::ClearRenderDirty()
+{
+	render_dirty = false;
 }
 
 bool ElementDocument::IsLayoutDirty()
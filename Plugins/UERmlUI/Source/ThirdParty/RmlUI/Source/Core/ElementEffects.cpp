@@ -317,6 +317,7 @@ void ElementEffects::RenderEffects(RenderStage render_stage)
 void ElementEffects::DirtyEffects()
 {
 	effects_dirty = true;
+	element->DirtyUpdate();
 }
 
 void ElementEffects::DirtyEffectsData()
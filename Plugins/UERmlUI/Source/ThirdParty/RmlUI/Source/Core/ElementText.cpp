@@ -13,6 +13,8 @@
 #include "ComputeProperty.h"
 #include "ElementDefinition.h"
 #include "ElementStyle.h"
+#include "RenderManagerAccess.h"
+#include "TextGeometryCache.h"
 #include "TransformState.h"
 #include <limits>
 
@@ -100,7 +102,7 @@ void LogMissingFontFace(Element* element)
 ElementText::ElementText(const String& tag) :
 	Element(tag), colour(255, 255, 255), opacity(1), font_handle_version(0), geometry_dirty(true), dirty_layout_on_change(true),
 	generated_decoration(Style::TextDecoration::None), decoration_property(Style::TextDecoration::None), font_effects_dirty(true),
-	font_effects_handle(0)
+	font_effects_handle(0), token_widths_font_face_handle(0)
 {}
 
 ElementText::~ElementText() {}
@@ -110,6 +112,8 @@ void ElementText::SetText(const String& _text)
 	if (text != _text)
 	{
 		text = _text;
+		token_widths.clear();
+		DirtyDocumentRender();
 
 		if (dirty_layout_on_change)
 			DirtyLayout();
@@ -199,10 +203,10 @@ void ElementText::OnRender()
 		}
 	}
 
-	if (render)
+	if (render && geometry)
 	{
-		for (size_t i = 0; i < geometry.size(); ++i)
-			geometry[i].geometry.Render(translation, geometry[i].texture);
+		for (const TextGeometry::TexturedGeometry& textured_geometry : geometry->geometry)
+			textured_geometry.geometry.Render(translation, textured_geometry.texture);
 	}
 
 	if (decoration)
@@ -229,6 +233,12 @@ bool ElementText::GenerateLine(String& line, int& line_length, float& line_width
 		return true;
 	}
 
+	if (token_widths_font_face_handle != font_face_handle)
+	{
+		token_widths.clear();
+		token_widths_font_face_handle = font_face_handle;
+	}
+
 	// Determine how we are processing white-space while formatting the text.
 	using namespace Style;
 	const auto& computed = GetComputedValues();
@@ -261,9 +271,20 @@ bool ElementText::GenerateLine(String& line, int& line_length, float& line_width
 				StringUtilities::ToCharacter(StringUtilities::SeekBackwardUTF8(&line.back(), line.data()), line.data() + line.size());
 
 		// Generate the next token and determine its pixel-length.
-		bool break_line = BuildToken(token, next_token_begin, string_end, line.empty() && trim_whitespace_prefix, collapse_white_space,
-			break_at_endline, text_transform_property, decode_escape_characters);
-		int token_width = font_engine_interface->GetStringWidth(font_face_handle, token, text_shaping_context, previous_codepoint);
+		const bool first_token = (line.empty() && trim_whitespace_prefix);
+		bool break_line = BuildToken(token, next_token_begin, string_end, first_token, collapse_white_space, break_at_endline,
+			text_transform_property, decode_escape_characters);
+
+		// The same token is built the same way from the same range of the text, only the preceding character may differ.
+		const uint64_t token_key = (uint64_t(token_begin - text.c_str()) << 33) | (uint64_t(next_token_begin - text.c_str()) << 2) |
+			(uint64_t(decode_escape_characters) << 1) | uint64_t(first_token);
+		TokenWidth& cached_token_width = token_widths[token_key];
+		if (cached_token_width.width < 0 || cached_token_width.previous_codepoint != previous_codepoint)
+		{
+			cached_token_width.previous_codepoint = previous_codepoint;
+			cached_token_width.width = font_engine_interface->GetStringWidth(font_face_handle, token, text_shaping_context, previous_codepoint);
+		}
+		int token_width = cached_token_width.width;
 
 		// If we're breaking to fit a line box, check if the token can fit on the line before we add it.
 		if (break_at_line)
@@ -275,36 +296,55 @@ bool ElementText::GenerateLine(String& line, int& line_length, float& line_width
 			{
 				if (word_break == WordBreak::BreakAll || (word_break == WordBreak::BreakWord && line.empty()))
 				{
-					// Try to break up the word
+					// Try to break up the word. Find the longest prefix of the token that fits by bisecting at character
+					// boundaries, assuming that the width of a prefix grows with its length.
 					max_token_width = RoundDownToIntegerClamped(maximum_line_width - line_width);
-					const int token_max_size = int(next_token_begin - token_begin);
-					const char* partial_string_end = token_begin + token_max_size;
+					const char* fit_end = token_begin;
+					const char* overflow_end = next_token_begin;
+					String partial_token;
 
-					// @performance: Can be made much faster. Use string width heuristics and logarithmic search.
 					while (true)
 					{
-						partial_string_end = StringUtilities::SeekBackwardUTF8(partial_string_end - 1, token_begin);
+						const char* partial_string_end =
+							StringUtilities::SeekForwardUTF8(fit_end + Math::Max(int(overflow_end - fit_end) / 2, 1), overflow_end);
+						if (partial_string_end == overflow_end)
+							partial_string_end = StringUtilities::SeekForwardUTF8(fit_end + 1, overflow_end);
+						if (partial_string_end == overflow_end)
+							break;
 
-						bool force_loop_break_at_end = false;
-						if (partial_string_end == token_begin)
-						{
-							// Not even the first character of the token fits. Let it overflow onto the next line if we can.
-							if (allow_empty || !line.empty())
-								return false;
+						partial_token.clear();
+						const char* partial_token_end = token_begin;
+						BuildToken(partial_token, partial_token_end, partial_string_end, first_token, collapse_white_space, break_at_endline,
+							text_transform_property, decode_escape_characters);
+						const int partial_token_width =
+							font_engine_interface->GetStringWidth(font_face_handle, partial_token, text_shaping_context, previous_codepoint);
 
-							// Continue by forcing the first character to be consumed, even though it will overflow.
-							partial_string_end = StringUtilities::SeekForwardUTF8(token_begin + 1, token_begin + token_max_size);
-							force_loop_break_at_end = true;
+						if (partial_token_width <= max_token_width)
+						{
+							fit_end = partial_string_end;
+							next_token_begin = partial_token_end;
+							token_width = partial_token_width;
+							token.swap(partial_token);
 						}
+						else
+						{
+							overflow_end = partial_string_end;
+						}
+					}
+
+					if (fit_end == token_begin)
+					{
+						// Not even the first character of the token fits. Let it overflow onto the next line if we can.
+						if (allow_empty || !line.empty())
+							return false;
 
+						// Continue by forcing the first character to be consumed, even though it will overflow.
+						const char* partial_string_end = StringUtilities::SeekForwardUTF8(token_begin + 1, next_token_begin);
 						token.clear();
 						next_token_begin = token_begin;
-						BuildToken(token, next_token_begin, partial_string_end, line.empty() && trim_whitespace_prefix, collapse_white_space,
-							break_at_endline, text_transform_property, decode_escape_characters);
+						BuildToken(token, next_token_begin, partial_string_end, first_token, collapse_white_space, break_at_endline,
+							text_transform_property, decode_escape_characters);
 						token_width = font_engine_interface->GetStringWidth(font_face_handle, token, text_shaping_context, previous_codepoint);
-
-						if (force_loop_break_at_end || token_width <= max_token_width)
-							break;
 					}
 
 					break_line = true;
@@ -416,6 +456,9 @@ void ElementText::OnPropertyChange(const PropertyIdSet& changed_properties)
 			decoration.reset();
 	}
 
+	if (font_face_changed || changed_properties.Contains(PropertyId::WhiteSpace) || changed_properties.Contains(PropertyId::TextTransform))
+		token_widths.clear();
+
 	if (font_face_changed)
 	{
 		// We have to let our document know we need to be regenerated.
@@ -477,6 +520,36 @@ bool ElementText::UpdateFontEffects()
 	return false;
 }
 
+// Builds the key identifying the geometry of text in the text geometry cache, from every input to generating its strings.
+static String BuildTextGeometryKey(FontFaceHandle font_face_handle, FontEffectsHandle font_effects_handle, int font_handle_version,
+	ColourbPremultiplied colour, float opacity, const TextShapingContext& text_shaping_context, const ElementText::LineList& lines)
+{
+	String key;
+	const auto append_value = [&key](const auto& value) { key.append(reinterpret_cast<const char*>(&value), sizeof(value)); };
+	const auto append_string = [&](const String& string) {
+		append_value(string.size());
+		key += string;
+	};
+
+	append_value(font_face_handle);
+	append_value(font_effects_handle);
+	append_value(font_handle_version);
+	append_value(colour);
+	append_value(opacity);
+	append_string(text_shaping_context.language);
+	append_value(text_shaping_context.text_direction);
+	append_value(text_shaping_context.font_kerning);
+	append_value(text_shaping_context.letter_spacing);
+
+	for (const ElementText::Line& line : lines)
+	{
+		append_value(line.position);
+		append_string(line.text);
+	}
+
+	return key;
+}
+
 void ElementText::GenerateGeometry(RenderManager& render_manager, const FontFaceHandle font_face_handle)
 {
 	RMLUI_ZoneScopedC(0xD2691E);
@@ -486,8 +559,28 @@ void ElementText::GenerateGeometry(RenderManager& render_manager, const FontFace
 	const auto& computed = GetComputedValues();
 	const TextShapingContext text_shaping_context{computed.language(), computed.direction(), computed.font_kerning(), computed.letter_spacing()};
 
+	// Text elements showing the same lines with the same font, effects, and colour share their geometry. Truncated text
+	// depends on the size of the parent, so it is always generated for the element alone.
+	TextGeometryCache& geometry_cache = RenderManagerAccess::GetTextGeometryCache(&render_manager);
+	String cache_key;
+	if (!text_overflow.enabled)
+	{
+		cache_key = BuildTextGeometryKey(font_face_handle, font_effects_handle, font_handle_version, colour, opacity, text_shaping_context, lines);
+		if (SharedPtr<TextGeometry> cached_geometry = geometry_cache.Find(cache_key))
+		{
+			RMLUI_ASSERT(cached_geometry->line_widths.size() == lines.size());
+			for (size_t i = 0; i < lines.size(); i++)
+				lines[i].width = cached_geometry->line_widths[i];
+
+			geometry = std::move(cached_geometry);
+			generated_decoration = Style::TextDecoration::None;
+			geometry_dirty = false;
+			return;
+		}
+	}
+
 	TexturedMeshList mesh_list;
-	mesh_list.reserve(geometry.size());
+	mesh_list.reserve(geometry ? geometry->geometry.size() : 0);
 
 	for (Line& line : lines)
 	{
@@ -527,17 +620,30 @@ void ElementText::GenerateGeometry(RenderManager& render_manager, const FontFace
 		}
 	}
 
-	// Apply the new geometry and textures. Reuse the old geometry if the mesh matches, which can be relatively common
-	// where the layout is changed in a way that does not visually affect this element.
-	geometry.resize(mesh_list.size());
+	SharedPtr<TextGeometry> new_geometry = (text_overflow.enabled ? MakeShared<TextGeometry>(nullptr, String()) : geometry_cache.Create(cache_key));
+
+	// Apply the new geometry and textures. Reuse the old geometry if the mesh matches and no other element shares it,
+	// which can be relatively common where the layout is changed in a way that does not visually affect this element.
+	const bool reuse_old_geometry = (geometry && geometry.use_count() == 1);
+	new_geometry->geometry.resize(mesh_list.size());
 	for (size_t i = 0; i < mesh_list.size(); i++)
 	{
-		if (!geometry[i].geometry || geometry[i].geometry.GetMesh() != mesh_list[i].mesh)
-			geometry[i].geometry = render_manager.MakeGeometry(std::move(mesh_list[i].mesh));
+		TextGeometry::TexturedGeometry& textured_geometry = new_geometry->geometry[i];
+		if (reuse_old_geometry && i < geometry->geometry.size() && geometry->geometry[i].geometry &&
+			geometry->geometry[i].geometry.GetMesh() == mesh_list[i].mesh)
+			textured_geometry.geometry = std::move(geometry->geometry[i].geometry);
+		else
+			textured_geometry.geometry = render_manager.MakeGeometry(std::move(mesh_list[i].mesh));
 
-		geometry[i].texture = mesh_list[i].texture;
+		textured_geometry.texture = mesh_list[i].texture;
 	}
 
+	new_geometry->line_widths.reserve(lines.size());
+	for (const Line& line : lines)
+		new_geometry->line_widths.push_back(line.width);
+
+	geometry = std::move(new_geometry);
+
 	generated_decoration = Style::TextDecoration::None;
 	geometry_dirty = false;
 }
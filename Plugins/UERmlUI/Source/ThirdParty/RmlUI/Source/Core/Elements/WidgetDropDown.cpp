@@ -252,6 +252,7 @@ void WidgetDropDown::OnLayout()
 
 	box_layout_dirty = true;
 	value_layout_dirty = true;
+	parent_element->DirtyUpdate();
 }
 
 void WidgetDropDown::OnValueChange(const String& value)
@@ -280,6 +281,7 @@ void WidgetDropDown::OnValueChange(const String& value)
 	parent_element->DispatchEvent(EventId::Change, parameters);
 
 	value_rml_dirty = true;
+	parent_element->DirtyUpdate();
 	value_changed_since_last_box_format = true;
 }
 
@@ -316,6 +318,7 @@ void WidgetDropDown::SetSelection(Element* select_option, bool force)
 	}
 
 	value_rml_dirty = true;
+	parent_element->DirtyUpdate();
 }
 
 void WidgetDropDown::SeekSelection(bool seek_forward)
@@ -434,6 +437,7 @@ void WidgetDropDown::OnChildAdd(Element* element)
 
 	selection_dirty = true;
 	box_layout_dirty = true;
+	parent_element->DirtyUpdate();
 }
 
 void WidgetDropDown::OnChildRemove(Element* element)
@@ -448,6 +452,7 @@ void WidgetDropDown::OnChildRemove(Element* element)
 
 	selection_dirty = true;
 	box_layout_dirty = true;
+	parent_element->DirtyUpdate();
 }
 
 void WidgetDropDown::AttachScrollEvent()
@@ -607,6 +612,7 @@ void WidgetDropDown::ShowSelectBox()
 	value_element->SetPseudoClass("checked", true);
 	button_element->SetPseudoClass("checked", true);
 	box_layout_dirty = true;
+	parent_element->DirtyUpdate();
 	box_opened_since_last_format = true;
 	AttachScrollEvent();
 
@@ -123,6 +123,8 @@ void WidgetSlider::Update()
 				SetBarPosition(i == 0 ? OnLineDecrement() : OnLineIncrement());
 			}
 
+			// Keep the element in the update traversal while the arrow repeats.
+			parent->DirtyUpdate();
 			if (Context* ctx = parent->GetContext())
 				ctx->RequestNextUpdate(arrow_timers[i]);
 		}
@@ -394,12 +396,14 @@ void WidgetSlider::ProcessEvent(Event& event)
 		{
 			arrow_timers[0] = DEFAULT_REPEAT_DELAY;
 			last_update_time = Clock::GetElapsedTime();
+			parent->DirtyUpdate();
 			SetBarPosition(OnLineDecrement());
 		}
 		else if (event.GetTargetElement() == arrows[1])
 		{
 			arrow_timers[1] = DEFAULT_REPEAT_DELAY;
 			last_update_time = Clock::GetElapsedTime();
+			parent->DirtyUpdate();
 			SetBarPosition(OnLineIncrement());
 		}
 	}
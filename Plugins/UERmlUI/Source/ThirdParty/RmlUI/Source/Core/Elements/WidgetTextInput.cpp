@@ -2,6 +2,7 @@
 #include "../../../Include/RmlUi/Core/ComputedValues.h"
 #include "../../../Include/RmlUi/Core/Context.h"
 #include "../../../Include/RmlUi/Core/Core.h"
+#include "../../../Include/RmlUi/Core/ElementDocument.h"
 #include "../../../Include/RmlUi/Core/ElementScroll.h"
 #include "../../../Include/RmlUi/Core/ElementText.h"
 #include "../../../Include/RmlUi/Core/ElementUtilities.h"
@@ -426,6 +427,11 @@ void WidgetTextInput::OnUpdate()
 			cursor_visible = !cursor_visible;
 		}
 
+		// The cursor, selection, and scroll state are only reflected during rendering, so keep the document dirty while editing.
+		if (ElementDocument* document = parent->GetOwnerDocument())
+			document->DirtyRender();
+
+		parent->DirtyUpdate();
 		if (parent->IsVisible(true))
 		{
 			if (Context* ctx = parent->GetContext())
@@ -1111,11 +1117,15 @@ int WidgetTextInput::CalculateCharacterIndex(int line_index, float position)
 
 void WidgetTextInput::ShowCursor(bool show, bool move_to_cursor)
 {
+	if (ElementDocument* document = parent->GetOwnerDocument())
+		document->DirtyRender();
+
 	if (show)
 	{
 		cursor_visible = true;
 		cursor_timer = CURSOR_BLINK_TIME;
 		last_update_time = GetSystemInterface()->GetElapsedTime();
+		parent->DirtyUpdate();
 
 		// Shift the cursor into view.
 		if (move_to_cursor)
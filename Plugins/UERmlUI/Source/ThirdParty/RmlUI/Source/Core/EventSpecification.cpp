@@ -1,6 +1,7 @@
 #include "EventSpecification.h"
 #include "../../Include/RmlUi/Core/ID.h"
 #include "ControlledLifetimeResource.h"
+#include <mutex>
 
 namespace Rml {
 
@@ -47,6 +48,9 @@ struct EventSpecificationData {
 
 	// Reverse lookup map from event type to id.
 	UnorderedMap<String, EventId> type_lookup;
+
+	// Guards insertion of custom event types, which may happen from contexts updated on different threads.
+	std::mutex insert_mutex;
 };
 
 static ControlledLifetimeResource<EventSpecificationData> event_specification_data;
@@ -60,6 +64,9 @@ namespace EventSpecificationInterface {
 		auto& specifications = event_specification_data->specifications;
 		auto& type_lookup = event_specification_data->type_lookup;
 
+		// Reserve every possible id up front, so inserting a custom type never moves the specifications that Get()
+		// hands out without taking the lock.
+		specifications.reserve(size_t(EventId::MaxNumIds));
 		type_lookup.reserve(specifications.size());
 		for (auto& specification : specifications)
 			type_lookup.emplace(specification.type, specification.id);
@@ -94,6 +101,8 @@ namespace EventSpecificationInterface {
 	// If not found: Inserts a new entry with given values.
 	static EventSpecification& GetOrInsert(const String& event_type, bool interruptible, bool bubbles, DefaultActionPhase default_action_phase)
 	{
+		std::lock_guard<std::mutex> lock(event_specification_data->insert_mutex);
+
 		auto& specifications = event_specification_data->specifications;
 		auto& type_lookup = event_specification_data->type_lookup;
 
@@ -134,12 +143,7 @@ namespace EventSpecificationInterface {
 
 	EventId GetIdOrInsert(const String& event_type)
 	{
-		auto& type_lookup = event_specification_data->type_lookup;
-
-		auto it = type_lookup.find(event_type);
-		if (it != type_lookup.end())
-			return it->second;
-
+		// The lookup takes the insertion lock, the map may be growing on another thread.
 		return GetOrInsert(event_type).id;
 	}
 
@@ -51,6 +51,16 @@ void FontEffect::SetFingerprint(size_t _fingerprint)
 	fingerprint = _fingerprint;
 }
 
+const String& FontEffect::GetDeclaration() const
+{
+	return declaration;
+}
+
+void FontEffect::SetDeclaration(const String& _declaration)
+{
+	declaration = _declaration;
+}
+
 void FontEffect::FillColorValuesFromAlpha(byte* destination, Vector2i dimensions, int stride)
 {
 	for (int y = 0; y < dimensions.y; ++y)
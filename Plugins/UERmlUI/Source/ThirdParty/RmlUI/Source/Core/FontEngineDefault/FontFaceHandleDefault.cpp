@@ -168,6 +168,18 @@ bool FontFaceHandleDefault::GenerateLayerTexture(Vector<byte>& texture_data, Vec
 	return it->layer->GenerateTexture(texture_data, texture_dimensions, texture_id, glyphs);
 }
 
+SharedPtr<FontFaceLayerTextureJob> FontFaceHandleDefault::CreateLayerTextureJob(const FontEffect* font_effect, int texture_id, int handle_version) const
+{
+	if (handle_version != version)
+		return nullptr;
+
+	auto it = std::find_if(layers.begin(), layers.end(), [font_effect](const EffectLayerPair& pair) { return pair.font_effect == font_effect; });
+	if (it == layers.end())
+		return nullptr;
+
+	return it->layer->CreateTextureJob(texture_id, glyphs);
+}
+
 int FontFaceHandleDefault::GenerateString(RenderManager& render_manager, TexturedMeshList& mesh_list, StringView string, const Vector2f position,
 	const ColourbPremultiplied colour, const float opacity, const TextShapingContext& text_shaping_context, const int layer_configuration_index)
 {
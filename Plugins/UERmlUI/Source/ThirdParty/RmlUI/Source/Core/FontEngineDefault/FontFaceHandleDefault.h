@@ -12,6 +12,7 @@
 namespace Rml {
 
 class FontFaceLayer;
+class FontFaceLayerTextureJob;
 
 class FontFaceHandleDefault final : public NonCopyMoveable {
 public:
@@ -44,6 +45,9 @@ public:
 	/// @param[in] handle_version The version of the handle data. Function returns false if out of date.
 	bool GenerateLayerTexture(Vector<byte>& texture_data, Vector2i& texture_dimensions, const FontEffect* font_effect, int texture_id,
 		int handle_version) const;
+	/// Prepares a layer's texture for generation on another thread, see FontFaceLayer::CreateTextureJob.
+	/// @return The job, or nullptr if the handle is out of date or the layer has no effect.
+	SharedPtr<FontFaceLayerTextureJob> CreateLayerTextureJob(const FontEffect* font_effect, int texture_id, int handle_version) const;
 
 	/// Generates the geometry required to render a single line of text.
 	/// @param[in] render_manager The render manager responsible for rendering the string.
@@ -1,11 +1,34 @@
 #include "FontFaceLayer.h"
+#include "../../../Include/RmlUi/Core/Core.h"
 #include "../../../Include/RmlUi/Core/RenderManager.h"
+#include "../../../Include/RmlUi/Core/SystemInterface.h"
 #include "FontFaceHandleDefault.h"
 #include <string.h>
+#include <thread>
 #include <type_traits>
 
 namespace Rml {
 
+namespace {
+	// 64-bit FNV-1a. The cache key must be stable between runs, so we avoid std::hash here.
+	struct CacheKeyHasher {
+		uint64_t value = 14695981039346656037ull;
+
+		void Add(const void* data, size_t size)
+		{
+			const byte* bytes = static_cast<const byte*>(data);
+			for (size_t i = 0; i < size; ++i)
+				value = (value ^ bytes[i]) * 1099511628211ull;
+		}
+		void Add(int number) { Add(&number, sizeof(number)); }
+		void Add(Vector2i vector)
+		{
+			Add(vector.x);
+			Add(vector.y);
+		}
+	};
+} // namespace
+
 FontFaceLayer::FontFaceLayer(const SharedPtr<const FontEffect>& _effect) : colour(255, 255, 255)
 {
 	effect = _effect;
@@ -132,8 +155,54 @@ bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFace
 		{
 			const int texture_id = i;
 
-			CallbackTextureFunction texture_callback = [handle, effect_ptr, texture_id, handle_version](
-														   const CallbackTextureInterface& texture_interface) -> bool {
+			// Effect layers can be expensive to generate, such as large blurs. When the texture database allows it, the texture
+			// is generated by a job on a worker thread, and the callback defers until the job is done.
+			SharedPtr<FontFaceLayerTextureJob> job;
+
+			CallbackTextureFunction texture_callback = [handle, effect_ptr, texture_id, handle_version, job](
+														   const CallbackTextureInterface& texture_interface) mutable -> bool {
+				if (job)
+				{
+					if (!job->IsDone())
+					{
+						if (texture_interface.CanDefer())
+						{
+							texture_interface.Defer();
+							return false;
+						}
+
+						// This render doesn't allow postponing the texture, such as when texture generation isn't budgeted, so
+						// finish the job here rather than failing the texture for good.
+						job->Wait();
+					}
+
+					SharedPtr<FontFaceLayerTextureJob> finished_job = std::move(job);
+					Vector<byte>& data = finished_job->GetTextureData();
+					if (data.empty())
+						return false;
+					return texture_interface.GenerateTexture(data, finished_job->GetTextureDimensions());
+				}
+
+				if (effect_ptr)
+				{
+					if (SharedPtr<FontFaceLayerTextureJob> new_job = handle->CreateLayerTextureJob(effect_ptr, texture_id, handle_version))
+					{
+						if (texture_interface.CanDefer() && GetSystemInterface()->RunAsync([new_job]() { new_job->Run(); }))
+						{
+							job = std::move(new_job);
+							texture_interface.Defer();
+							return false;
+						}
+
+						// Run the job in place, which still takes the texture from the cache when possible.
+						new_job->Run();
+						Vector<byte>& data = new_job->GetTextureData();
+						if (data.empty())
+							return false;
+						return texture_interface.GenerateTexture(data, new_job->GetTextureDimensions());
+					}
+				}
+
 				Vector2i dimensions;
 				Vector<byte> data;
 				if (!handle->GenerateLayerTexture(data, dimensions, effect_ptr, texture_id, handle_version) || data.empty())
@@ -221,6 +290,114 @@ bool FontFaceLayer::GenerateTexture(Vector<byte>& texture_data, Vector2i& textur
 	return true;
 }
 
+SharedPtr<FontFaceLayerTextureJob> FontFaceLayer::CreateTextureJob(int texture_id, const FontGlyphMap& glyphs) const
+{
+	if (!effect || texture_id < 0 || texture_id >= texture_layout.GetNumTextures())
+		return nullptr;
+
+	auto job = MakeShared<FontFaceLayerTextureJob>();
+	job->effect = effect;
+
+	// The texture layout is not const-correct, but we only read from it here.
+	TextureLayout& layout = const_cast<TextureLayout&>(texture_layout);
+	job->texture_dimensions = layout.GetTexture(texture_id).GetDimensions();
+
+	for (int i = 0; i < layout.GetNumRectangles(); ++i)
+	{
+		TextureLayoutRectangle& rectangle = layout.GetRectangle(i);
+		const Character character = (Character)rectangle.GetId();
+
+		auto it_box = character_boxes.find(character);
+		if (it_box == character_boxes.end() || it_box->second.texture_index != texture_id)
+			continue;
+
+		auto it_glyph = glyphs.find(character);
+		if (it_glyph == glyphs.end())
+			continue;
+
+		// Copy the bitmap, the glyph data may be released while the job is running.
+		FontGlyph glyph = it_glyph->second.WeakCopy();
+		if (glyph.bitmap_data)
+		{
+			const size_t num_bytes = size_t(glyph.bitmap_dimensions.x) * size_t(glyph.bitmap_dimensions.y) *
+				(glyph.color_format == ColorFormat::RGBA8 ? 4 : 1);
+			glyph.bitmap_owned_data.reset(new byte[num_bytes]);
+			memcpy(glyph.bitmap_owned_data.get(), glyph.bitmap_data, num_bytes);
+			glyph.bitmap_data = glyph.bitmap_owned_data.get();
+		}
+
+		job->items.push_back(FontFaceLayerTextureJob::GlyphItem{rectangle.GetPosition(), Vector2i(it_box->second.dimensions), std::move(glyph)});
+	}
+
+	// The effect fingerprint covers its type and properties, and the glyph bitmaps cover the font face, size and density.
+	// Effects without a fingerprint were not instanced from style properties, so we can't tell them apart.
+	if (const size_t fingerprint = effect->GetFingerprint())
+	{
+		CacheKeyHasher hasher;
+		hasher.Add(&fingerprint, sizeof(fingerprint));
+		hasher.Add(job->texture_dimensions);
+		for (const FontFaceLayerTextureJob::GlyphItem& item : job->items)
+		{
+			hasher.Add(item.position);
+			hasher.Add(item.dimensions);
+			hasher.Add(item.glyph.bitmap_dimensions);
+			hasher.Add(int(item.glyph.color_format));
+			if (item.glyph.bitmap_data)
+				hasher.Add(item.glyph.bitmap_data,
+					size_t(item.glyph.bitmap_dimensions.x) * size_t(item.glyph.bitmap_dimensions.y) *
+						(item.glyph.color_format == ColorFormat::RGBA8 ? 4 : 1));
+		}
+		job->cache_key = (hasher.value != 0 ? hasher.value : 1);
+	}
+
+	return job;
+}
+
+void FontFaceLayerTextureJob::Run()
+{
+	if (started.exchange(true, std::memory_order_acq_rel))
+		return;
+
+	SystemInterface* system_interface = GetSystemInterface();
+	const size_t num_bytes = size_t(texture_dimensions.x) * size_t(texture_dimensions.y) * 4;
+
+	if (cache_key != 0)
+	{
+		Vector2i cached_dimensions;
+		if (system_interface->LoadGeneratedTexture(cache_key, texture_data, cached_dimensions) && cached_dimensions == texture_dimensions &&
+			texture_data.size() == num_bytes)
+		{
+			done.store(true, std::memory_order_release);
+			return;
+		}
+		texture_data.clear();
+	}
+
+	if (texture_dimensions.x > 0 && texture_dimensions.y > 0)
+	{
+		const int stride = texture_dimensions.x * 4;
+		texture_data.resize(size_t(stride) * size_t(texture_dimensions.y), 0);
+
+		for (const GlyphItem& item : items)
+		{
+			byte* destination = texture_data.data() + item.position.y * stride + item.position.x * 4;
+			effect->GenerateGlyphTexture(destination, item.dimensions, stride, item.glyph);
+		}
+
+		if (cache_key != 0)
+			system_interface->StoreGeneratedTexture(cache_key, texture_data, texture_dimensions);
+	}
+
+	done.store(true, std::memory_order_release);
+}
+
+void FontFaceLayerTextureJob::Wait()
+{
+	Run();
+	while (!IsDone())
+		std::this_thread::yield();
+}
+
 const FontEffect* FontFaceLayer::GetFontEffect() const
 {
 	return effect.get();
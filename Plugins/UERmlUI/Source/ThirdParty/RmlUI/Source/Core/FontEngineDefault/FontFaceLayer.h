@@ -5,12 +5,53 @@
 #include "../../../Include/RmlUi/Core/Geometry.h"
 #include "../../../Include/RmlUi/Core/MeshUtilities.h"
 #include "../TextureLayout.h"
+#include <atomic>
 
 namespace Rml {
 
 class FontEffect;
 class FontFaceHandleDefault;
 
+/**
+    A self-contained snapshot of everything needed to generate one texture of an effect layer. It owns copies of the
+    glyph bitmaps and a reference to the effect, so it can run on a worker thread while the font face handle is changed
+    or destroyed on the main thread.
+ */
+
+class FontFaceLayerTextureJob {
+public:
+	/// Generates the texture data. May be called from any thread, only the first call does the work.
+	void Run();
+	/// Blocks until the texture data is generated, running the job on this thread if no worker has started it yet.
+	void Wait();
+	/// Returns true once Run() has completed, after which the texture data may be read.
+	bool IsDone() const { return done.load(std::memory_order_acquire); }
+
+	Vector<byte>& GetTextureData() { return texture_data; }
+	Vector2i GetTextureDimensions() const { return texture_dimensions; }
+
+	/// Returns a hash of the effect, layout and glyph bitmaps that determine the texture, for use with the system
+	/// interface's generated texture cache. Zero if the texture should not be cached.
+	uint64_t GetCacheKey() const { return cache_key; }
+
+private:
+	struct GlyphItem {
+		Vector2i position;
+		Vector2i dimensions;
+		FontGlyph glyph;
+	};
+
+	SharedPtr<const FontEffect> effect;
+	Vector<GlyphItem> items;
+	Vector2i texture_dimensions;
+	uint64_t cache_key = 0;
+	Vector<byte> texture_data;
+	std::atomic<bool> started{false};
+	std::atomic<bool> done{false};
+
+	friend class FontFaceLayer;
+};
+
 /**
     A textured layer stored as part of a font face handle. Each handle will have at least a base
     layer for the standard font. Further layers can be added to allow rendering of text effects.
@@ -35,6 +76,12 @@ public:
 	/// @param[in] glyphs The glyphs required by the font face handle.
 	bool GenerateTexture(Vector<byte>& texture_data, Vector2i& texture_dimensions, int texture_id, const FontGlyphMap& glyphs);
 
+	/// Prepares a texture of an effect layer for generation on another thread, see FontFaceLayerTextureJob.
+	/// @param[in] texture_id The index of the texture within the layer to generate.
+	/// @param[in] glyphs The glyphs required by the font face handle.
+	/// @return The job, or nullptr if the layer has no effect or the texture does not exist.
+	SharedPtr<FontFaceLayerTextureJob> CreateTextureJob(int texture_id, const FontGlyphMap& glyphs) const;
+
 	/// Generates the geometry required to render a single character.
 	/// @param[out] mesh_list An array of meshes this layer will write to. It must be at least as big as the number of textures in this layer.
 	/// @param[in] character_code The character to generate geometry for.
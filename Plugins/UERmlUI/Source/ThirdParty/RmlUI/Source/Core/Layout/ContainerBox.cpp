@@ -5,6 +5,7 @@
 #include "../../../Include/RmlUi/Core/Profiling.h"
 #include "FlexFormattingContext.h"
 #include "FormattingContext.h"
+#include "LayoutCache.h"
 #include "LayoutDetails.h"
 #include <algorithm>
 #include <cmath>
@@ -96,6 +97,11 @@ void ContainerBox::SetElementBaseline(float element_baseline)
 	element->SetBaseline(element_baseline);
 }
 
+void ContainerBox::SetElementContainingBlock(Vector2f containing_block)
+{
+	element->layout_containing_block = containing_block;
+}
+
 void ContainerBox::SubmitElementLayout()
 {
 	element->OnLayout();
@@ -252,8 +258,16 @@ float FlexContainer::GetShrinkToFitWidth() const
 	if (element->GetComputedValues().width().type == Style::Width::Type::Length)
 		return box.GetSize().x;
 
-	// Infer shrink-to-fit width from the intrinsic width of the element.
-	return FlexFormattingContext::GetMaxContentSize(element).x;
+	// Infer shrink-to-fit width from the intrinsic width of the element. It is measured in infinite space, which we
+	// represent by an indefinite containing block.
+	const Vector2f infinite_space(-1.f, -1.f);
+	float max_content_width = 0.f;
+	if (!LayoutCache::Find(element, LayoutCacheMode::MaxContentWidth, nullptr, infinite_space, max_content_width))
+	{
+		max_content_width = FlexFormattingContext::GetMaxContentSize(element).x;
+		LayoutCache::Store(element, LayoutCacheMode::MaxContentWidth, nullptr, infinite_space, max_content_width);
+	}
+	return max_content_width;
 }
 
 String FlexContainer::DebugDumpTree(int depth) const
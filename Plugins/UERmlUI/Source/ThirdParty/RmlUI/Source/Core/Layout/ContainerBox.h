@@ -21,6 +21,11 @@ public:
 	void AddAbsoluteElement(Element* element, Vector2f static_position, Element* static_relative_offset_parent);
 	// Adds a relatively positioned element which we act as a containing block for.
 	void AddRelativeElement(Element* element);
+	// Returns true if absolutely positioned elements were added that have not been formatted yet.
+	bool HasAbsoluteElements() const { return !absolute_elements.empty(); }
+
+	// Records the containing block our element is formatted in, so that it can later be formatted on its own.
+	void SetElementContainingBlock(Vector2f containing_block);
 
 	ContainerBox* GetParent() { return parent_container; }
 	Element* GetElement() { return element; }
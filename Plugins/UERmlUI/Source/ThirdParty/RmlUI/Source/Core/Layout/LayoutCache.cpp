@@ -0,0 +1,54 @@
+#include "LayoutCache.h"
+#include "../../../Include/RmlUi/Core/Element.h"
+
+namespace Rml {
+
+bool LayoutCache::Find(Element* element, LayoutCacheMode mode, const Box* initial_box, Vector2f containing_block, float& result)
+{
+	const LayoutCache* cache = element->layout_cache.get();
+	if (!cache)
+		return false;
+
+	for (int i = 0; i < cache->num_entries; i++)
+	{
+		const Entry& entry = cache->entries[i];
+		if (entry.mode == mode && entry.containing_block == containing_block && entry.has_initial_box == (initial_box != nullptr) &&
+			(!initial_box || entry.initial_box == *initial_box))
+		{
+			result = entry.result;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void LayoutCache::Store(Element* element, LayoutCacheMode mode, const Box* initial_box, Vector2f containing_block, float result)
+{
+	if (!element->layout_cache)
+		element->layout_cache = MakeUnique<LayoutCache>();
+
+	LayoutCache& cache = *element->layout_cache;
+
+	// Overwrite entries round-robin once full, the oldest measurement is the least likely to be asked for again.
+	Entry& entry = cache.entries[cache.next_entry];
+	cache.next_entry = (cache.next_entry + 1) % max_entries;
+	cache.num_entries = Math::Min(cache.num_entries + 1, max_entries);
+
+	entry.mode = mode;
+	entry.has_initial_box = (initial_box != nullptr);
+	entry.initial_box = (initial_box ? *initial_box : Box());
+	entry.containing_block = containing_block;
+	entry.result = result;
+}
+
+void LayoutCache::Invalidate(Element* element)
+{
+	for (; element; element = element->parent)
+	{
+		if (element->layout_cache)
+			element->layout_cache->Clear();
+	}
+}
+
+} // namespace Rml
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../../../Include/RmlUi/Core/Box.h"
+#include "../../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+class Element;
+
+enum class LayoutCacheMode : uint8_t {
+	ShrinkToFitWidth, // Width of the element formatted under a max-content constraint, clamped to the available width.
+	MaxContentWidth,  // Width of the flex container's items formatted in infinite space.
+	FormattedHeight,  // Content height of the element formatted under the given initial box.
+};
+
+/**
+    Measurements of an element made while formatting its ancestors, such as the shrink-to-fit width of an inline-block or
+    the hypothetical size of a flex item. Measuring an element formats its whole subtree, and nested containers measure
+    their descendants again at every level, so results are kept with the element and reused within and across layouts.
+
+    A measurement only depends on the element's subtree and the space it is measured in, so the cache of an element and
+    all of its ancestors is cleared whenever it dirties the layout.
+ */
+class LayoutCache {
+public:
+	/// Looks up an earlier measurement of the element.
+	/// @param[in] element The measured element.
+	/// @param[in] mode The kind of measurement.
+	/// @param[in] initial_box The initial box the element was formatted with, or nullptr if it was built from its properties.
+	/// @param[in] containing_block The size of the element's containing block.
+	/// @param[out] result The measured value.
+	/// @return True if a matching measurement was found.
+	static bool Find(Element* element, LayoutCacheMode mode, const Box* initial_box, Vector2f containing_block, float& result);
+
+	/// Stores a measurement of the element, replacing its oldest one if the cache is full.
+	static void Store(Element* element, LayoutCacheMode mode, const Box* initial_box, Vector2f containing_block, float result);
+
+	/// Clears the measurements of the element and its ancestors, which may all depend on the element's layout.
+	static void Invalidate(Element* element);
+
+	/// Clears the measurements of this element only.
+	void Clear() { num_entries = 0; }
+
+private:
+	struct Entry {
+		LayoutCacheMode mode;
+		bool has_initial_box;
+		Box initial_box;
+		Vector2f containing_block;
+		float result;
+	};
+
+	static constexpr int max_entries = 4;
+
+	Entry entries[max_entries];
+	int num_entries = 0;
+	int next_entry = 0;
+};
+
+} // namespace Rml
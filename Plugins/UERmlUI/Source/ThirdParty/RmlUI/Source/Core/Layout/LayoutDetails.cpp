@@ -7,6 +7,7 @@
 #include "../../../Include/RmlUi/Core/Profiling.h"
 #include "ContainerBox.h"
 #include "FormattingContext.h"
+#include "LayoutCache.h"
 #include "LayoutEngine.h"
 #include <float.h>
 
@@ -242,6 +243,10 @@ float LayoutDetails::GetShrinkToFitWidth(Element* element, Vector2f containing_b
 	const float max_content_constraint_width = containing_block.x + 10000.f;
 	box.SetContent({max_content_constraint_width, box.GetSize().y});
 
+	float shrink_to_fit_width = 0.f;
+	if (LayoutCache::Find(element, LayoutCacheMode::ShrinkToFitWidth, nullptr, containing_block, shrink_to_fit_width))
+		return shrink_to_fit_width;
+
 	// First, format the element under the above generated box. Then we ask the resulting box for its shrink-to-fit
 	// width. For block containers, this is essentially its largest line or child box.
 	// @performance. Some formatting can be simplified, e.g. absolute elements do not contribute to the shrink-to-fit
@@ -249,16 +254,37 @@ float LayoutDetails::GetShrinkToFitWidth(Element* element, Vector2f containing_b
 	RootBox root(Math::Max(containing_block, Vector2f(0.f)));
 	UniquePtr<LayoutBox> layout_box = FormattingContext::FormatIndependent(&root, element, &box, FormattingContextType::Block);
 
-	float shrink_to_fit_width = layout_box->GetShrinkToFitWidth();
+	shrink_to_fit_width = layout_box->GetShrinkToFitWidth();
 	if (containing_block.x >= 0)
 	{
 		const float available_width =
 			Math::Max(0.f, containing_block.x - box.GetSizeAcross(BoxDirection::Horizontal, BoxArea::Margin, BoxArea::Padding));
 		shrink_to_fit_width = Math::Min(shrink_to_fit_width, available_width);
 	}
+
+	LayoutCache::Store(element, LayoutCacheMode::ShrinkToFitWidth, nullptr, containing_block, shrink_to_fit_width);
 	return shrink_to_fit_width;
 }
 
+float LayoutDetails::GetFormattedHeight(ContainerBox* parent_container, Element* element, const Box* override_initial_box)
+{
+	RMLUI_ASSERT(parent_container && element);
+
+	// The measurement is fully determined by the element's subtree, its initial box, and its containing block. The
+	// element is formatted again afterwards in its final position, so the layout box itself can be thrown away.
+	const Vector2f containing_block = GetContainingBlock(parent_container, element->GetPosition()).size;
+
+	float height = 0.f;
+	if (LayoutCache::Find(element, LayoutCacheMode::FormattedHeight, override_initial_box, containing_block, height))
+		return height;
+
+	FormattingContext::FormatIndependent(parent_container, element, override_initial_box, FormattingContextType::Block);
+	height = element->GetBox().GetSize().y;
+
+	LayoutCache::Store(element, LayoutCacheMode::FormattedHeight, override_initial_box, containing_block, height);
+	return height;
+}
+
 ComputedAxisSize LayoutDetails::BuildComputedHorizontalSize(const ComputedValues& computed)
 {
 	return ComputedAxisSize{computed.width(), computed.min_width(), computed.max_width(), computed.padding_left(), computed.padding_right(),
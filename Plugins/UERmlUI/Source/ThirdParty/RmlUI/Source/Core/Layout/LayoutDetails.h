@@ -80,6 +80,12 @@ public:
 	/// Formats the element and returns the width of its contents.
 	static float GetShrinkToFitWidth(Element* element, Vector2f containing_block);
 
+	/// Formats the element in an independent formatting context to measure it, and returns its resulting content height.
+	/// @param[in] parent_container The container box which should act as the new box's parent.
+	/// @param[in] element The element to measure.
+	/// @param[in] override_initial_box Optionally set the initial box dimensions, otherwise one will be generated based on the element's properties.
+	static float GetFormattedHeight(ContainerBox* parent_container, Element* element, const Box* override_initial_box);
+
 	/// Build computed axis size along the horizontal direction (width and friends).
 	static ComputedAxisSize BuildComputedHorizontalSize(const ComputedValues& computed);
 	/// Build computed axis size along the vertical direction (height and friends).
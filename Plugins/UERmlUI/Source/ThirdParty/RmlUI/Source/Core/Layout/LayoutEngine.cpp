@@ -1,12 +1,108 @@
 #include "LayoutEngine.h"
+#include "../../../Include/RmlUi/Core/ComputedValues.h"
 #include "../../../Include/RmlUi/Core/Element.h"
+#include "../../../Include/RmlUi/Core/ElementDocument.h"
 #include "../../../Include/RmlUi/Core/Log.h"
 #include "../../../Include/RmlUi/Core/Profiling.h"
 #include "ContainerBox.h"
 #include "FormattingContext.h"
+#include "LayoutDetails.h"
 
 namespace Rml {
 
+// Returns true if the element's height follows from its own properties and its containing block, rather than its contents.
+static bool HasDefiniteHeight(const Style::ComputedValues& computed, float containing_block_height)
+{
+	using namespace Style;
+	switch (computed.height().type)
+	{
+	case Height::Length: return true;
+	case Height::Percentage: return containing_block_height >= 0.f;
+	case Height::Auto: break;
+	}
+
+	const bool absolutely_positioned = (computed.position() == Position::Absolute || computed.position() == Position::Fixed);
+	return absolutely_positioned && computed.top().type != Top::Auto && computed.bottom().type != Bottom::Auto;
+}
+
+// Returns true if an ancestor of the element, below its document, is sized from the max-content width of its contents.
+static bool HasShrinkToFitAncestor(Element* element)
+{
+	using namespace Style;
+	Element* document = element->GetOwnerDocument();
+	for (Element* ancestor = element->GetParentNode(); ancestor && ancestor != document; ancestor = ancestor->GetParentNode())
+	{
+		const ComputedValues& computed = ancestor->GetComputedValues();
+		const Display display = computed.display();
+
+		// Table columns are sized from the contents of their cells, whatever width the cells set.
+		if (display == Display::TableCell)
+			return true;
+
+		// A set width does not depend on the contents, and neither does anything stretched to fill it.
+		if (computed.width().type == Width::Length)
+			return false;
+
+		const bool absolutely_positioned = (computed.position() == Position::Absolute || computed.position() == Position::Fixed);
+		Element* parent = ancestor->GetParentNode();
+
+		if (display == Display::InlineBlock || display == Display::InlineFlex || display == Display::Table || display == Display::InlineTable ||
+			computed.float_() != Float::None)
+			return true;
+		if (absolutely_positioned && (computed.left().type == Left::Auto || computed.right().type == Right::Auto))
+			return true;
+		if (!absolutely_positioned && parent && parent->GetDisplay() == Display::Flex)
+			return true;
+	}
+	return false;
+}
+
+static bool IsLayoutBoundary(Element* element, Vector2f containing_block)
+{
+	using namespace Style;
+	Element* parent = element->GetParentNode();
+	if (!parent || element->IsReplaced())
+		return false;
+
+	const ComputedValues& computed = element->GetComputedValues();
+	const Display display = computed.display();
+
+	// Inline and table boxes are sized from their contents or by their parent box, they can't be formatted on their own.
+	if (display != Display::Block && display != Display::FlowRoot && display != Display::Flex && display != Display::InlineBlock &&
+		display != Display::InlineFlex)
+		return false;
+
+	const bool absolutely_positioned = (computed.position() == Position::Absolute || computed.position() == Position::Fixed);
+	const bool floating = (computed.float_() != Float::None);
+	const bool flex_item = (!absolutely_positioned && parent->GetDisplay() == Display::Flex);
+	const bool scroll_container = LayoutDetails::IsScrollContainer(computed.overflow_x(), computed.overflow_y());
+	const bool definite_height = HasDefiniteHeight(computed, containing_block.y);
+
+	// The width is kept from the last layout, so it must not depend on the contents. It does not when it is set, or when
+	// the box stretches to fill its containing block. Stretching only helps if no ancestor shrinks to fit its contents, as
+	// that ancestor's width would still follow the max-content width of our contents.
+	const bool definite_width = (computed.width().type != Width::Auto ||
+		(absolutely_positioned && computed.left().type != Left::Auto && computed.right().type != Right::Auto));
+	if (!definite_width)
+	{
+		const bool stretched_width =
+			(display != Display::InlineBlock && display != Display::InlineFlex && !floating && !absolutely_positioned && !flex_item);
+		if (!stretched_width || HasShrinkToFitAncestor(element))
+			return false;
+	}
+
+	// Flex items are sized by their container, which accounts for their contents unless both sizes are set.
+	if (flex_item && !(computed.width().type != Width::Auto && definite_height))
+		return false;
+
+	// A plain block box takes part in its parent's block formatting context, e.g. by collapsing margins or sharing floats.
+	const bool independent_formatting_context = (display != Display::Block || floating || absolutely_positioned || scroll_container || flex_item);
+	if (independent_formatting_context && (definite_height || scroll_container))
+		return true;
+
+	return LayoutEngine::HasLayoutContainment(element);
+}
+
 void LayoutEngine::FormatElement(Element* element, Vector2f containing_block)
 {
 	RMLUI_ASSERT(element && containing_block.x >= 0 && containing_block.y >= 0);
@@ -30,4 +126,62 @@ void LayoutEngine::FormatElement(Element* element, Vector2f containing_block)
 	}
 }
 
+bool LayoutEngine::FormatLayoutBoundary(Element* element)
+{
+	RMLUI_ASSERT(element);
+	RMLUI_ZoneScoped;
+
+	const Style::ComputedValues& computed = element->GetComputedValues();
+
+	// What the surrounding layout used from this element, to tell whether it is still valid afterwards.
+	const Box previous_box = element->GetBox();
+	const float previous_baseline = element->baseline;
+	const Vector2f previous_overflow = element->scrollable_overflow_rectangle;
+
+	// Format from the box the element was given last time, letting the height follow the new contents unless it is set.
+	Box box = previous_box;
+	if (!HasDefiniteHeight(computed, element->layout_containing_block.y))
+		box.SetContent({box.GetSize().x, -1.f});
+
+	// Percentages resolve against the same containing block as before.
+	RootBox root(element->layout_containing_block);
+
+	auto layout_box = FormattingContext::FormatIndependent(&root, element, &box, FormattingContextType::Block);
+	if (!layout_box)
+	{
+		Log::Message(Log::LT_ERROR, "Error while formatting layout boundary: %s", element->GetAddress().c_str());
+		return false;
+	}
+
+	// Absolutely positioned descendants whose containing block lies outside the boundary end up in the root box, unformatted.
+	if (root.HasAbsoluteElements())
+		return false;
+
+	// Ancestors see our box and baseline, and unless we are a scroll container, also any overflow from our contents.
+	const bool scroll_container = LayoutDetails::IsScrollContainer(computed.overflow_x(), computed.overflow_y());
+	if (element->GetBox() != previous_box || element->baseline != previous_baseline ||
+		(!scroll_container && element->scrollable_overflow_rectangle != previous_overflow))
+		return false;
+
+	element->ClampScrollOffsetRecursive();
+	return true;
+}
+
+Element* LayoutEngine::FindLayoutBoundary(Element* element)
+{
+	Element* document = (element ? element->GetOwnerDocument() : nullptr);
+	for (; element && element != document; element = element->GetParentNode())
+	{
+		if (IsLayoutBoundary(element, element->layout_containing_block))
+			return element;
+	}
+	return nullptr;
+}
+
+bool LayoutEngine::HasLayoutContainment(Element* element)
+{
+	static const String boundary_attribute = "data-layout-boundary";
+	return element->GetComputedValues().contain() == Style::Contain::Layout || element->HasAttribute(boundary_attribute);
+}
+
 } // namespace Rml
@@ -14,6 +14,21 @@ public:
 	/// @param[in] element The element to lay out.
 	/// @param[in] containing_block The size of the containing block.
 	static void FormatElement(Element* element, Vector2f containing_block);
+
+	/// Formats a layout boundary and its descendants on their own, keeping the boundary where the last layout placed it.
+	/// @param[in] element The layout boundary, as found by FindLayoutBoundary.
+	/// @return False if the result affects the surrounding layout, i.e. the boundary's box, baseline, or overflow changed,
+	///         or a descendant is positioned relative to a box outside of it. The surroundings must then be formatted too.
+	static bool FormatLayoutBoundary(Element* element);
+
+	/// Returns the closest element starting at the given one whose contents can be formatted independently of the rest of
+	/// the document, or nullptr if the whole document must be formatted. Layout boundaries are elements establishing an
+	/// independent formatting context whose width does not depend on their contents, and which either have a fixed height,
+	/// are scroll containers, or explicitly opt in through 'contain: layout' or the 'data-layout-boundary' attribute.
+	static Element* FindLayoutBoundary(Element* element);
+
+	/// Returns true if the element opted in to layout containment, which makes it establish a block formatting context.
+	static bool HasLayoutContainment(Element* element);
 };
 
 } // namespace Rml
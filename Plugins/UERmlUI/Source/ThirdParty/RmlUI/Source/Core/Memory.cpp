@@ -60,7 +60,8 @@ namespace Detail {
 
 	BasicStackAllocator& GetGlobalBasicStackAllocator()
 	{
-		static BasicStackAllocator stack_allocator(10 * 1024);
+		// Thread local, so that e.g. font effect textures can be generated on worker threads, see SystemInterface::RunAsync.
+		static thread_local BasicStackAllocator stack_allocator(10 * 1024);
 		return stack_allocator;
 	}
 
@@ -4,9 +4,14 @@
 #include "../../Include/RmlUi/Core/Header.h"
 #include "../../Include/RmlUi/Core/Traits.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include <mutex>
 
 namespace Rml {
 
+/**
+    Allocation and deallocation may be called from several threads at once. Construction and destruction run outside
+    the pool's lock, so objects may allocate from or release into the same pool while being created or destroyed.
+ */
 template <typename PoolType>
 class Pool {
 private:
@@ -89,6 +94,8 @@ public:
 	inline int GetNumAllocatedObjects() const;
 
 private:
+	// Unlinks a free node and makes it the head of the allocated list, growing the pool if allowed. Returns nullptr if no node is available.
+	PoolNode* AllocateNode();
 	// Creates a new pool chunk and appends its nodes to the beginning of the free list.
 	void CreateChunk();
 
@@ -103,6 +110,9 @@ private:
 
 	int num_allocated_objects;
 
+	// Guards the free and allocated lists, so contexts can be updated on different threads.
+	std::mutex list_mutex;
+
 #ifdef RMLUI_DEBUG
 	int max_num_allocated_objects = 0;
 #endif
@@ -64,6 +64,19 @@ template<typename PoolType>
 template<typename ...Args>
 inline PoolType* Pool<PoolType>::AllocateAndConstruct(Args&&... args)
 {
+	PoolNode* allocated_object = AllocateNode();
+	if (allocated_object == nullptr)
+		return nullptr;
+
+	return new (allocated_object->object) PoolType(std::forward<Args>(args)...);
+}
+
+// Takes a node off the free list and moves it to the allocated list.
+template < typename PoolType >
+typename Pool< PoolType >::PoolNode* Pool< PoolType >::AllocateNode()
+{
+	std::lock_guard<std::mutex> lock(list_mutex);
+
 	// We can't allocate a new object if the deallocated list is empty.
 	if (first_free_node == nullptr)
 	{
@@ -110,19 +123,21 @@ inline PoolType* Pool<PoolType>::AllocateAndConstruct(Args&&... args)
 
 	first_allocated_node = allocated_object;
 
-	return new (allocated_object->object) PoolType(std::forward<Args>(args)...);
+	return allocated_object;
 }
 
 // Deallocates the object pointed to by the given iterator.
 template < typename PoolType >
 void Pool< PoolType >::DestroyAndDeallocate(Iterator& iterator)
 {
-	// We're about to deallocate an object.
-	--num_allocated_objects;
-
 	PoolNode* object = iterator.node;
 	reinterpret_cast<PoolType*>(object->object)->~PoolType();
 
+	std::lock_guard<std::mutex> lock(list_mutex);
+
+	// We're about to deallocate an object.
+	--num_allocated_objects;
+
 	// Get the previous and next pointers now, because they will be overwritten
 	// before we're finished.
 	PoolNode* previous_object = object->previous;
@@ -92,6 +92,7 @@ bool PropertyParserFontEffect::ParseValue(Property& property, const String& font
 					Utilities::HashCombine(fingerprint, id_value.second.Get<String>());
 
 				font_effect->SetFingerprint(fingerprint);
+				font_effect->SetDeclaration(StringUtilities::StripWhitespace(font_effect_string));
 
 				font_effects.list.emplace_back(std::move(font_effect));
 			}
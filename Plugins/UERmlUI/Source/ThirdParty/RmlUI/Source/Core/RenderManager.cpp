@@ -4,11 +4,13 @@
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/RenderInterface.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
+#include "TextGeometryCache.h"
 #include "TextureDatabase.h"
 
 namespace Rml {
 
-RenderManager::RenderManager(RenderInterface* render_interface) : render_interface(render_interface), texture_database(MakeUnique<TextureDatabase>())
+RenderManager::RenderManager(RenderInterface* render_interface) :
+	render_interface(render_interface), texture_database(MakeUnique<TextureDatabase>()), text_geometry_cache(MakeUnique<TextGeometryCache>())
 {
 	RMLUI_ASSERT(render_interface);
 
@@ -52,6 +54,12 @@ void RenderManager::PrepareRender(Vector2i dimensions)
 #endif
 
 	SetViewport(dimensions);
+	texture_database->callback_database.ResetGenerationBudget();
+}
+
+void RenderManager::SetCallbackTextureBudget(double budget_seconds)
+{
+	texture_database->callback_database.SetGenerationBudget(budget_seconds);
 }
 
 void RenderManager::SetViewport(Vector2i dimensions)
@@ -226,8 +234,17 @@ void RenderManager::Render(const Geometry& geometry, Vector2f translation, Textu
 		if (texture.file_index != TextureFileIndex::Invalid)
 			texture_handle = texture_database->file_database.GetHandle(render_interface, texture.file_index);
 		else if (texture.callback_index != StableVectorIndex::Invalid)
+		{
 			texture_handle = texture_database->callback_database.GetHandle(this, render_interface, texture.callback_index);
 
+			// Rendering a pending texture without its image would show e.g. a blank box; skip it until it is ready.
+			if (!texture_handle && texture_database->callback_database.IsPending(texture.callback_index))
+			{
+				num_deferred_texture_draws += 1;
+				return;
+			}
+		}
+
 		RMLUI_ZoneScopedNC("RenderGeometry", 0x3E60B2);
 		if (shader)
 			render_interface->RenderShader(shader.resource_handle, geometry_handle, translation, texture_handle);
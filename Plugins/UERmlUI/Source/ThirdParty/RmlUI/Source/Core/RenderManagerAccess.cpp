@@ -1,5 +1,6 @@
 #include "RenderManagerAccess.h"
 #include "../../Include/RmlUi/Core/Texture.h"
+#include "TextGeometryCache.h"
 #include "TextureDatabase.h"
 
 namespace Rml {
@@ -45,4 +46,9 @@ void RenderManagerAccess::ReleaseAllCompiledGeometry(RenderManager* render_manag
 	render_manager->ReleaseAllCompiledGeometry();
 }
 
+TextGeometryCache& RenderManagerAccess::GetTextGeometryCache(RenderManager* render_manager)
+{
+	return *render_manager->text_geometry_cache;
+}
+
 } // namespace Rml
@@ -11,6 +11,7 @@ class CompiledShader;
 class CallbackTexture;
 class Geometry;
 class Texture;
+class TextGeometryCache;
 
 class RenderManagerAccess {
 private:
@@ -32,11 +33,14 @@ private:
 	static void ReleaseAllTextures(RenderManager* render_manager);
 	static void ReleaseAllCompiledGeometry(RenderManager* render_manager);
 
+	static TextGeometryCache& GetTextGeometryCache(RenderManager* render_manager);
+
 	friend class CompiledFilter;
 	friend class CompiledShader;
 	friend class CallbackTexture;
 	friend class Geometry;
 	friend class Texture;
+	friend class ElementText;
 
 	friend StringList Rml::GetTextureSourceList();
 	friend bool Rml::ReleaseTexture(const String&, RenderInterface*);
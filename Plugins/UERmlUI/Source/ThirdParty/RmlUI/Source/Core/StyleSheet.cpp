@@ -89,7 +89,8 @@ const DecoratorPtrList& StyleSheet::InstanceDecorators(RenderManager& render_man
 	const PropertySource* source) const
 {
 	RMLUI_ASSERT_NONRECURSIVE; // Since we may return a reference to the below static variable.
-	static DecoratorPtrList non_cached_decorator_list;
+	// Per thread, style sheets of contexts updated on different threads instance decorators concurrently.
+	static thread_local DecoratorPtrList non_cached_decorator_list;
 
 	// Empty declaration values are used for interpolated values which we don't want to cache.
 	const bool enable_cache = !declaration_list.value.empty();
@@ -166,8 +167,9 @@ SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const Elemen
 {
 	RMLUI_ASSERT_NONRECURSIVE;
 
-	// Using static to avoid allocations. Make sure we don't call this function recursively.
-	static Vector<const StyleSheetNode*> applicable_nodes;
+	// Using static to avoid allocations. Make sure we don't call this function recursively. Per thread, since contexts
+	// may be updated on different threads.
+	static thread_local Vector<const StyleSheetNode*> applicable_nodes;
 	applicable_nodes.clear();
 
 	auto AddApplicableNodes = [element](const StyleSheetIndex::NodeIndex& node_index, const String& key) {
@@ -44,6 +44,8 @@ void StyleSheetFactory::Shutdown()
 
 const StyleSheetContainer* StyleSheetFactory::GetStyleSheetContainer(const String& sheet_name)
 {
+	std::lock_guard<std::recursive_mutex> lock(instance->stylesheets_mutex);
+
 	// Look up the sheet definition in the cache
 	auto it = instance->stylesheets.find(sheet_name);
 	if (it != instance->stylesheets.end())
@@ -64,6 +66,7 @@ const StyleSheetContainer* StyleSheetFactory::GetStyleSheetContainer(const Strin
 
 void StyleSheetFactory::ClearStyleSheetCache()
 {
+	std::lock_guard<std::recursive_mutex> lock(instance->stylesheets_mutex);
 	instance->stylesheets.clear();
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../Include/RmlUi/Core/Types.h"
+#include <mutex>
 
 namespace Rml {
 
@@ -43,6 +44,8 @@ private:
 	// Individual loaded stylesheets
 	using StyleSheets = UnorderedMap<String, UniquePtr<const StyleSheetContainer>>;
 	StyleSheets stylesheets;
+	// Guards the cache, documents may be loaded from contexts updated on different threads.
+	std::recursive_mutex stylesheets_mutex;
 
 	// Custom complex selectors available for style sheets.
 	using SelectorMap = UnorderedMap<String, StructuralSelectorType>;
@@ -87,4 +87,16 @@ void SystemInterface::ActivateKeyboard(Rml::Vector2f /*caret_position*/, float /
 
 void SystemInterface::DeactivateKeyboard() {}
 
+bool SystemInterface::RunAsync(Function<void()> /*task*/)
+{
+	return false;
+}
+
+bool SystemInterface::LoadGeneratedTexture(uint64_t /*key*/, Vector<byte>& /*data*/, Vector2i& /*dimensions*/)
+{
+	return false;
+}
+
+void SystemInterface::StoreGeneratedTexture(uint64_t /*key*/, const Vector<byte>& /*data*/, Vector2i /*dimensions*/) {}
+
 } // namespace Rml
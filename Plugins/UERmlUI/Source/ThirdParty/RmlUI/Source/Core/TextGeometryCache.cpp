@@ -0,0 +1,42 @@
+#include "TextGeometryCache.h"
+
+namespace Rml {
+
+TextGeometry::TextGeometry(TextGeometryCache* cache, String cache_key) : cache(cache), cache_key(std::move(cache_key)) {}
+
+TextGeometry::~TextGeometry()
+{
+	if (cache)
+		cache->Release(*this);
+}
+
+SharedPtr<TextGeometry> TextGeometryCache::Find(const String& key) const
+{
+	auto it = entries.find(key);
+	if (it == entries.end())
+		return nullptr;
+
+	SharedPtr<TextGeometry> result = it->second.lock();
+	RMLUI_ASSERTMSG(result, "Failed to lock handle in text geometry cache");
+	return result;
+}
+
+SharedPtr<TextGeometry> TextGeometryCache::Create(const String& key)
+{
+	auto text_geometry = MakeShared<TextGeometry>(this, key);
+
+	const bool inserted = entries.emplace(key, WeakPtr<TextGeometry>(text_geometry)).second;
+	RMLUI_ASSERTMSG(inserted, "Could not insert entry into the text geometry cache, duplicate key.");
+	(void)inserted;
+
+	return text_geometry;
+}
+
+void TextGeometryCache::Release(const TextGeometry& text_geometry)
+{
+	auto it = entries.find(text_geometry.cache_key);
+	RMLUI_ASSERT(it != entries.end());
+	entries.erase(it);
+}
+
+} // namespace Rml
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../../Include/RmlUi/Core/Geometry.h"
+#include "../../Include/RmlUi/Core/Texture.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+class TextGeometryCache;
+
+/*
+    The generated geometry of all lines of a text element, positioned relative to the element. Text elements showing the
+    same lines with the same font, effects and colour share it, and render it at their own translation.
+*/
+struct TextGeometry : NonCopyMoveable {
+	TextGeometry(TextGeometryCache* cache, String cache_key);
+	~TextGeometry();
+
+	struct TexturedGeometry {
+		Geometry geometry;
+		Texture texture;
+	};
+	Vector<TexturedGeometry> geometry;
+
+	// The width of each line, as returned from the font engine when generating it.
+	Vector<int> line_widths;
+
+	// The cache this geometry is shared through, or nullptr if it is owned by a single element.
+	TextGeometryCache* const cache;
+	const String cache_key;
+};
+
+/*
+    Shares text geometry between the text elements of a render manager. Entries are owned by the elements using them, and
+    removed from the cache when the last of them lets go.
+*/
+class TextGeometryCache : NonCopyMoveable {
+public:
+	/// Returns the geometry generated for the given key, or nullptr if no element currently uses any.
+	SharedPtr<TextGeometry> Find(const String& key) const;
+
+	/// Creates empty geometry for the given key, to be filled in by the caller and shared with later lookups.
+	SharedPtr<TextGeometry> Create(const String& key);
+
+private:
+	void Release(const TextGeometry& text_geometry);
+
+	UnorderedMap<String, WeakPtr<TextGeometry>> entries;
+
+	friend struct TextGeometry;
+};
+
+} // namespace Rml
@@ -1,6 +1,8 @@
 #include "TextureDatabase.h"
 #include "../../Include/RmlUi/Core/Log.h"
 #include "../../Include/RmlUi/Core/RenderInterface.h"
+#include "../../Include/RmlUi/Core/SystemInterface.h"
+#include "../../Include/RmlUi/Core/Core.h"
 
 namespace Rml {
 
@@ -49,7 +51,28 @@ auto CallbackTextureDatabase::EnsureLoaded(RenderManager* render_manager, Render
 	CallbackTextureEntry& data = texture_list[callback_index];
 	if (!data.texture_handle && !data.load_failed)
 	{
-		if (!data.callback(CallbackTextureInterface(*render_manager, *render_interface, data.texture_handle, data.dimensions)))
+		const bool use_budget = (generation_budget >= 0.0);
+
+		// Once the budget is spent, leave the remaining textures for later frames. At least one callback runs per frame, so
+		// generation always makes progress.
+		if (use_budget && generation_time > generation_budget)
+		{
+			data.pending = true;
+			return data;
+		}
+
+		SystemInterface* system_interface = GetSystemInterface();
+		const double start_time = (use_budget ? system_interface->GetElapsedTime() : 0.0);
+
+		bool deferred = false;
+		const bool result = data.callback(
+			CallbackTextureInterface(*render_manager, *render_interface, data.texture_handle, data.dimensions, use_budget ? &deferred : nullptr));
+
+		if (use_budget)
+			generation_time += system_interface->GetElapsedTime() - start_time;
+
+		data.pending = (!result && deferred);
+		if (!result && !deferred)
 		{
 			data.load_failed = true;
 			data.texture_handle = {};
@@ -59,6 +82,22 @@ auto CallbackTextureDatabase::EnsureLoaded(RenderManager* render_manager, Render
 	return data;
 }
 
+bool CallbackTextureDatabase::IsPending(StableVectorIndex callback_index) const
+{
+	const CallbackTextureEntry& data = texture_list[callback_index];
+	return !data.texture_handle && data.pending;
+}
+
+void CallbackTextureDatabase::SetGenerationBudget(double budget_seconds)
+{
+	generation_budget = budget_seconds;
+}
+
+void CallbackTextureDatabase::ResetGenerationBudget()
+{
+	generation_time = 0.0;
+}
+
 size_t CallbackTextureDatabase::size() const
 {
 	return texture_list.size();
@@ -19,6 +19,14 @@ public:
 	Vector2i GetDimensions(RenderManager* render_manager, RenderInterface* render_interface, StableVectorIndex callback_index);
 	TextureHandle GetHandle(RenderManager* render_manager, RenderInterface* render_interface, StableVectorIndex callback_index);
 
+	/// True if the texture has been postponed to a later frame, either by its callback or by the generation budget.
+	bool IsPending(StableVectorIndex callback_index) const;
+
+	/// Limits the time spent in texture callbacks between calls to ResetGenerationBudget(). A negative budget disables
+	/// the limit and deferral altogether, so every callback runs to completion on first use.
+	void SetGenerationBudget(double budget_seconds);
+	void ResetGenerationBudget();
+
 	size_t size() const;
 
 	void ReleaseAllTextures(RenderInterface* render_interface);
@@ -29,11 +37,15 @@ private:
 		TextureHandle texture_handle = {};
 		Vector2i dimensions;
 		bool load_failed = false;
+		bool pending = false;
 	};
 
 	CallbackTextureEntry& EnsureLoaded(RenderManager* render_manager, RenderInterface* render_interface, StableVectorIndex callback_index);
 
 	StableVector<CallbackTextureEntry> texture_list;
+
+	double generation_budget = -1.0;
+	double generation_time = 0.0;
 };
 
 class FileTextureDatabase : NonCopyMoveable {
@@ -1,10 +1,11 @@
 #include "../../Include/RmlUi/Core/Traits.h"
+#include <atomic>
 
 namespace Rml {
 
 int FamilyBase::GetNewId()
 {
-	static int id = 0;
+	static std::atomic<int> id{0};
 	return id++;
 }
 
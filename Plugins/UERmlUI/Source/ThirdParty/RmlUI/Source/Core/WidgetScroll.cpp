@@ -138,6 +138,8 @@ void WidgetScroll::Update()
 					ScrollLineDown();
 			}
 
+			// Keep the element in the update traversal while the arrow repeats.
+			parent->DirtyUpdate();
 			if (Context* ctx = parent->GetContext())
 				ctx->RequestNextUpdate(arrow_timers[i]);
 		}
@@ -403,12 +405,14 @@ void WidgetScroll::ProcessEvent(Event& event)
 		{
 			arrow_timers[0] = DEFAULT_REPEAT_DELAY;
 			last_update_time = Clock::GetElapsedTime();
+			parent->DirtyUpdate();
 			ScrollLineUp();
 		}
 		else if (event.GetTargetElement() == arrows[1])
 		{
 			arrow_timers[1] = DEFAULT_REPEAT_DELAY;
 			last_update_time = Clock::GetElapsedTime();
+			parent->DirtyUpdate();
 			ScrollLineDown();
 		}
 	}
@@ -25,6 +25,9 @@ void ElementContextHook::OnRender()
 
 	// Render the debugging elements.
 	debugger->Render();
+
+	// The debug overlays follow the hovered element in other documents, never retain our render output.
+	DirtyRender();
 }
 
 } // namespace Debugger
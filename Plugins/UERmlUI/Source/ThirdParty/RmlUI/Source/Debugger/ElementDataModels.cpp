@@ -113,6 +113,9 @@ void ElementDataModels::SetDebugContext(Context* new_debug_context)
 
 void ElementDataModels::OnUpdate()
 {
+	// Polls the debugged context, so stay in the update traversal.
+	DirtyUpdate();
+
 	if (!IsVisible() || !debug_context)
 		return;
 
@@ -66,6 +66,9 @@ void ElementInfo::Reset()
 
 void ElementInfo::OnUpdate()
 {
+	// Polls the source element, so stay in the update traversal.
+	DirtyUpdate();
+
 	if (source_element && (update_source_element || force_update_once) && IsVisible())
 	{
 		const double t = GetSystemInterface()->GetElapsedTime();
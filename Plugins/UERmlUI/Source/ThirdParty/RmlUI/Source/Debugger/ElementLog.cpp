@@ -164,6 +164,7 @@ void ElementLog::AddLogMessage(Log::Type type, const String& message)
 
 	// Force a refresh of the RML.
 	dirty_logs = true;
+	DirtyUpdate();
 }
 
 void ElementLog::OnUpdate()
@@ -237,6 +238,7 @@ void ElementLog::ProcessEvent(Event& event)
 					}
 				}
 				dirty_logs = true;
+				DirtyUpdate();
 			}
 			else
 			{
@@ -250,6 +252,7 @@ void ElementLog::ProcessEvent(Event& event)
 						else
 							event.GetTargetElement()->SetInnerRML("Off");
 						dirty_logs = true;
+						DirtyUpdate();
 					}
 				}
 			}
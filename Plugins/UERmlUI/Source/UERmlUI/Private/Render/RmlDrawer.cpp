@@ -1,19 +1,49 @@
 #include "RmlDrawer.h"
 #include "RmlMesh.h"
+#include "RmlGeometryArena.h"
 #include "RmlShader.h"
 #include "Render/TextureEntries.h"
 #include "Logging.h"
 #include "HAL/PlatformTime.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/Texture2D.h"
+#include "RenderTargetPool.h"
+#include "RenderUtils.h"
 
 DECLARE_STATS_GROUP(TEXT("RmlUI_RT"), STATGROUP_RmlUI_RT, STATCAT_Advanced);
 DECLARE_CYCLE_STAT(TEXT("RmlUI DrawRenderThread"), STAT_RmlUI_DrawRenderThread, STATGROUP_RmlUI_RT);
 DECLARE_CYCLE_STAT(TEXT("RmlUI DrawMesh"),         STAT_RmlUI_DrawMesh,         STATGROUP_RmlUI_RT);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RmlUI Draws Before Merge"),        STAT_RmlUI_DrawsBeforeMerge,       STATGROUP_RmlUI_RT);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RmlUI Draws After Merge"),         STAT_RmlUI_DrawsAfterMerge,        STATGROUP_RmlUI_RT);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RmlUI Transform Binds Skipped"),   STAT_RmlUI_TransformBindsSkipped,  STATGROUP_RmlUI_RT);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RmlUI Scissor Binds Skipped"),     STAT_RmlUI_ScissorBindsSkipped,    STATGROUP_RmlUI_RT);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RmlUI Geometry Bytes Uploaded"),   STAT_RmlUI_GeometryBytesUploaded,  STATGROUP_RmlUI_RT);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RmlUI Geometry Bytes From Arena"), STAT_RmlUI_GeometryBytesFromArena, STATGROUP_RmlUI_RT);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RmlUI Geometry Meshes Promoted"),  STAT_RmlUI_GeometryMeshesPromoted, STATGROUP_RmlUI_RT);
+DECLARE_MEMORY_STAT(TEXT("RmlUI Geometry Arena Used"),              STAT_RmlUI_GeometryArenaUsed,      STATGROUP_RmlUI_RT);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RmlUI Direct Frames"),             STAT_RmlUI_DirectFrames,           STATGROUP_RmlUI_RT);
+DECLARE_CYCLE_STAT(TEXT("RmlUI Cached Layer"),                      STAT_RmlUI_CachedLayer,            STATGROUP_RmlUI_RT);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RmlUI Cached Layer Pixels Redrawn"), STAT_RmlUI_CachedLayerPixelsRedrawn, STATGROUP_RmlUI_RT);
+DECLARE_MEMORY_STAT(TEXT("RmlUI Pooled Targets Memory"),             STAT_RmlUI_PooledTargetMemory,     STATGROUP_RmlUI_RT);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("RmlUI Pooled Targets"),         STAT_RmlUI_PooledTargets,          STATGROUP_RmlUI_RT);
 
 // ============================================================================
 // FRmlLayerStack
 // ============================================================================
 
-void FRmlLayerStack::EnsureResources(FRHICommandListImmediate& RHICmdList, const FIntPoint& Size, EPixelFormat Format, int32 NumSamples)
+// Pool targets held right now and the most held at once this engine frame (render
+// thread only). Drawers draw one after another and hand their targets back in between,
+// so the peak is what the pool actually has to hold for RmlUi.
+static int64  GRmlHeldTargetBytes = 0;
+static int32  GRmlHeldTargetCount = 0;
+static int64  GRmlPeakTargetBytes = 0;
+static int32  GRmlPeakTargetCount = 0;
+static uint32 GRmlPeakFrameNumber = 0;
+
+// Filter regions are rounded up to this many pixels per side.
+static constexpr int32 FilterRegionGranularity = 64;
+
+void FRmlLayerStack::EnsureResources(const FIntPoint& Size, EPixelFormat Format, int32 NumSamples)
 {
 	// Force 8-bit RGBA for all internal render targets.  The Slate RT may use
 	// A2B10G10R10 (10-bit color, but only 2-bit alpha = 4 alpha levels).
@@ -22,52 +52,129 @@ void FRmlLayerStack::EnsureResources(FRHICommandListImmediate& RHICmdList, const
 	// PF_B8G8R8A8 gives us full 8-bit alpha (256 levels).
 	Format = PF_B8G8R8A8;
 
-	if (CachedSize == Size && CachedFormat == Format && CachedNumSamples == NumSamples && SharedDepthStencil.IsValid())
+	if (CachedSize == Size && CachedFormat == Format && CachedNumSamples == NumSamples)
 		return;
 
 	CachedSize = Size;
 	CachedFormat = Format;
 	CachedNumSamples = NumSamples;
 
-	// Release all existing layers
-	Layers.Reset();
-	ActiveCount = 0;
+	// BlendMask allocated lazily
+	BlendMaskRT.SafeRelease();
+}
+
+TRefCountPtr<IPooledRenderTarget> FRmlLayerStack::AcquirePooled(FRHICommandListImmediate& RHICmdList, const FRDGTextureDesc& Desc, const TCHAR* Name)
+{
+	TRefCountPtr<IPooledRenderTarget> Pooled;
+	GRenderTargetPool.FindFreeElement(RHICmdList, Desc, Pooled, Name);
+	check(Pooled.IsValid());
 
-	// Shared depth/stencil
+	if (GRmlPeakFrameNumber != GFrameNumberRenderThread)
 	{
-		FRHITextureCreateDesc Desc = FRHITextureCreateDesc::Create2D(TEXT("RmlUI_DepthStencil"), Size.X, Size.Y, PF_DepthStencil);
-		Desc.NumSamples = NumSamples;
-		Desc.Flags = ETextureCreateFlags::DepthStencilTargetable;
-		Desc.ClearValue = FClearValueBinding::DepthFar;
-		SharedDepthStencil = RHICmdList.CreateTexture(Desc);
+		GRmlPeakFrameNumber = GFrameNumberRenderThread;
+		GRmlPeakTargetBytes = 0;
+		GRmlPeakTargetCount = 0;
 	}
+	GRmlHeldTargetBytes += Pooled->ComputeMemorySize();
+	++GRmlHeldTargetCount;
+	GRmlPeakTargetBytes = FMath::Max(GRmlPeakTargetBytes, GRmlHeldTargetBytes);
+	GRmlPeakTargetCount = FMath::Max(GRmlPeakTargetCount, GRmlHeldTargetCount);
+	SET_MEMORY_STAT(STAT_RmlUI_PooledTargetMemory, GRmlPeakTargetBytes);
+	SET_DWORD_STAT(STAT_RmlUI_PooledTargets, GRmlPeakTargetCount);
+
+	return Pooled;
+}
 
-	// Postprocess buffers (always 1x, shader-readable)
-	auto CreatePostprocess = [&](const TCHAR* Name) -> FTextureRHIRef
-	{
-		FRHITextureCreateDesc Desc = FRHITextureCreateDesc::Create2D(Name, Size.X, Size.Y, Format);
-		Desc.Flags = ETextureCreateFlags::RenderTargetable | ETextureCreateFlags::ShaderResource;
-		Desc.ClearValue = FClearValueBinding::Transparent;
-		return RHICmdList.CreateTexture(Desc);
-	};
+void FRmlLayerStack::ReleasePooled(TRefCountPtr<IPooledRenderTarget>& Target)
+{
+	if (!Target.IsValid())
+		return;
+	GRmlHeldTargetBytes -= Target->ComputeMemorySize();
+	--GRmlHeldTargetCount;
+	Target.SafeRelease();
+}
+
+FTextureRHIRef FRmlLayerStack::AcquireTarget(FRHICommandListImmediate& RHICmdList, const FRDGTextureDesc& Desc, const TCHAR* Name)
+{
+	TRefCountPtr<IPooledRenderTarget> Pooled = AcquirePooled(RHICmdList, Desc, Name);
+	FTextureRHIRef Texture = Pooled->GetRHI();
+	FrameTargets.Add(MoveTemp(Pooled));
+	return Texture;
+}
+
+void FRmlLayerStack::BeginFrame(FRHICommandListImmediate& RHICmdList)
+{
+	check(FrameTargets.Num() == 0);
+
+	SharedDepthStencil = AcquireTarget(RHICmdList,
+		FRDGTextureDesc::Create2D(CachedSize, PF_DepthStencil, FClearValueBinding::DepthFar,
+			TexCreate_DepthStencilTargetable, 1, CachedNumSamples),
+		TEXT("RmlUI_DepthStencil"));
+
+	// Postprocess buffer (always 1x, shader-readable)
+	PostprocessA = AcquireTarget(RHICmdList,
+		FRDGTextureDesc::Create2D(CachedSize, CachedFormat, FClearValueBinding::Transparent,
+			TexCreate_RenderTargetable | TexCreate_ShaderResource),
+		TEXT("RmlUI_PostA"));
+}
+
+void FRmlLayerStack::EndFrame()
+{
+	check(ActiveCount == 0);
+
+	for (FRmlLayer& Layer : Layers)
+		Layer.ColorRT.SafeRelease();
+	SharedDepthStencil.SafeRelease();
+	PostprocessA.SafeRelease();
+
+	for (TRefCountPtr<IPooledRenderTarget>& Target : FrameTargets)
+		ReleasePooled(Target);
+	FrameTargets.Reset();
+}
+
+void FRmlLayerStack::BeginFilterRegion(FRHICommandListImmediate& RHICmdList, const FIntRect& Rect, FRmlFilterRegion& OutRegion)
+{
+	check(OutRegion.Pooled.Num() == 0);
+
+	OutRegion.Origin = Rect.Min;
+	OutRegion.Size = Rect.Size().ComponentMax(FIntPoint(1, 1));
+	OutRegion.Extent = FIntPoint(
+		FMath::DivideAndRoundUp(OutRegion.Size.X, FilterRegionGranularity) * FilterRegionGranularity,
+		FMath::DivideAndRoundUp(OutRegion.Size.Y, FilterRegionGranularity) * FilterRegionGranularity);
+
+	const FRDGTextureDesc Desc = FRDGTextureDesc::Create2D(OutRegion.Extent, CachedFormat, FClearValueBinding::Transparent,
+		TexCreate_RenderTargetable | TexCreate_ShaderResource);
+	OutRegion.Pooled.Add(AcquirePooled(RHICmdList, Desc, TEXT("RmlUI_FilterA")));
+	OutRegion.A = OutRegion.Pooled.Last()->GetRHI();
+	OutRegion.Pooled.Add(AcquirePooled(RHICmdList, Desc, TEXT("RmlUI_FilterB")));
+	OutRegion.B = OutRegion.Pooled.Last()->GetRHI();
+}
+
+void FRmlLayerStack::EnsureBlurTargets(FRHICommandListImmediate& RHICmdList, FRmlFilterRegion& Region)
+{
+	if (Region.BlurTemp.IsValid())
+		return;
 
-	PostprocessA = CreatePostprocess(TEXT("RmlUI_PostA"));
-	PostprocessB = CreatePostprocess(TEXT("RmlUI_PostB"));
 	// FP16 blur buffers — the entire downsample→blur→upsample chain runs in FP16
 	// to avoid repeated 8-bit quantization of alpha gradients (box-shadow, filter:blur).
-	// PostprocessBlurSrc + PostprocessTemp form a matched FP16 pair for RenderBlur.
-	auto CreateFP16 = [&](const TCHAR* Name) -> FTextureRHIRef
-	{
-		FRHITextureCreateDesc Desc = FRHITextureCreateDesc::Create2D(Name, Size.X, Size.Y, PF_FloatRGBA);
-		Desc.Flags = ETextureCreateFlags::RenderTargetable | ETextureCreateFlags::ShaderResource;
-		Desc.ClearValue = FClearValueBinding::Transparent;
-		return RHICmdList.CreateTexture(Desc);
-	};
-	PostprocessTemp = CreateFP16(TEXT("RmlUI_PostTemp"));
-	PostprocessBlurSrc = CreateFP16(TEXT("RmlUI_BlurSrc"));
+	// BlurSrc + BlurTemp form a matched FP16 pair for RenderBlur.
+	const FRDGTextureDesc FP16Desc = FRDGTextureDesc::Create2D(Region.Extent, PF_FloatRGBA, FClearValueBinding::Transparent,
+		TexCreate_RenderTargetable | TexCreate_ShaderResource);
+	Region.Pooled.Add(AcquirePooled(RHICmdList, FP16Desc, TEXT("RmlUI_BlurSrc")));
+	Region.BlurSrc = Region.Pooled.Last()->GetRHI();
+	Region.Pooled.Add(AcquirePooled(RHICmdList, FP16Desc, TEXT("RmlUI_BlurTemp")));
+	Region.BlurTemp = Region.Pooled.Last()->GetRHI();
+}
 
-	// BlendMask allocated lazily
-	BlendMaskRT.SafeRelease();
+void FRmlLayerStack::EndFilterRegion(FRmlFilterRegion& Region)
+{
+	Region.A.SafeRelease();
+	Region.B.SafeRelease();
+	Region.BlurSrc.SafeRelease();
+	Region.BlurTemp.SafeRelease();
+	for (TRefCountPtr<IPooledRenderTarget>& Target : Region.Pooled)
+		ReleasePooled(Target);
+	Region.Pooled.Reset();
 }
 
 void FRmlLayerStack::Reset()
@@ -101,14 +208,11 @@ void FRmlLayerStack::Pop()
 
 void FRmlLayerStack::AllocLayer(FRHICommandListImmediate& RHICmdList, int32 Index)
 {
-	FString Name = FString::Printf(TEXT("RmlUI_Layer%d"), Index);
-	FRHITextureCreateDesc Desc = FRHITextureCreateDesc::Create2D(*Name, CachedSize.X, CachedSize.Y, CachedFormat);
-	Desc.NumSamples = CachedNumSamples;
 	// ShaderResource for ALL layers (including MSAA) — enables Texture2DMS binding
 	// for scissored resolve in CompositeLayers, avoiding fullscreen hardware resolve.
-	Desc.Flags = ETextureCreateFlags::RenderTargetable | ETextureCreateFlags::ShaderResource;
-	Desc.ClearValue = FClearValueBinding::Transparent;
-	Layers[Index].ColorRT = RHICmdList.CreateTexture(Desc);
+	const FRDGTextureDesc Desc = FRDGTextureDesc::Create2D(CachedSize, CachedFormat, FClearValueBinding::Transparent,
+		TexCreate_RenderTargetable | TexCreate_ShaderResource, 1, CachedNumSamples);
+	Layers[Index].ColorRT = AcquireTarget(RHICmdList, Desc, TEXT("RmlUI_Layer"));
 }
 
 // ============================================================================
@@ -117,7 +221,6 @@ void FRmlLayerStack::AllocLayer(FRHICommandListImmediate& RHICmdList, int32 Inde
 
 FRmlDrawer::FRmlDrawer(bool bUsing)
 	: bIsFree(!bUsing)
-	, CachedRTSize(0, 0)
 {
 }
 
@@ -125,26 +228,8 @@ void FRmlDrawer::EnsureRenderResources(FRHICommandListImmediate& RHICmdList, con
 {
 	const int32 NumSamples = bUseMSAA ? MSAASamples : 1;
 
-	if (CachedRTSize == RTSize && ResolveTarget.IsValid())
-	{
-		// Just ensure layer stack resources are up to date
-		LayerStack.EnsureResources(RHICmdList, RTSize, RTFormat, NumSamples);
-		return;
-	}
-
-	CachedRTSize = RTSize;
-
-	// Resolve target — keeps Slate RT format so CopyTexture (format-matching) works in MSAA path.
-	// Only used as a temporary copy of the Slate RT background, not for layer compositing.
-	{
-		FRHITextureCreateDesc Desc = FRHITextureCreateDesc::Create2D(TEXT("RmlUI_Resolve"), RTSize.X, RTSize.Y, RTFormat);
-		Desc.Flags = ETextureCreateFlags::RenderTargetable | ETextureCreateFlags::ShaderResource;
-		Desc.ClearValue = FClearValueBinding::Transparent;
-		ResolveTarget = RHICmdList.CreateTexture(Desc);
-	}
-
 	// Layer stack — internally forces PF_B8G8R8A8 for full 8-bit alpha
-	LayerStack.EnsureResources(RHICmdList, RTSize, RTFormat, NumSamples);
+	LayerStack.EnsureResources(RTSize, RTFormat, NumSamples);
 
 	// Fullscreen quad VB/IB (only once, size-independent)
 	if (!QuadVB.IsValid())
@@ -216,6 +301,22 @@ void FRmlDrawer::DrawFullscreenQuad(FRHICommandListImmediate& RHICmdList)
 	RHICmdList.DrawIndexedPrimitive(QuadIB, 0, 0, 4, 0, 2, 1);
 }
 
+void FRmlDrawer::DrawCommandGeometry(FRHICommandListImmediate& RHICmdList, const FRmlGeometryCommand& Cmd)
+{
+	const FRmlMesh& Mesh = *FrameMeshes[Cmd.Mesh];
+	if (Cmd.bArenaGeometry)
+	{
+		FRmlGeometryArena& Arena = FRmlGeometryArena::Get();
+		RHICmdList.SetStreamSource(0, Arena.GetVertexBuffer(), 0);
+		RHICmdList.DrawIndexedPrimitive(Arena.GetIndexBuffer(), Cmd.BaseVertex, 0, Mesh.NumVertices, Cmd.StartIndex, Mesh.NumTriangles, 1);
+	}
+	else
+	{
+		RHICmdList.SetStreamSource(0, FrameVB, 0);
+		RHICmdList.DrawIndexedPrimitive(FrameIB, Cmd.BaseVertex, 0, Mesh.NumVertices, Cmd.StartIndex, Mesh.NumTriangles, 1);
+	}
+}
+
 // ============================================================================
 // PSO building
 // ============================================================================
@@ -258,22 +359,34 @@ void FRmlDrawer::BuildDrawPSOs(FRHICommandListImmediate& RHICmdList,
 	OutPSONoTex.BoundShaderState.PixelShaderRHI = PsNoTex.GetPixelShader();
 }
 
+FRmlTextureEntry* FRmlDrawer::GetBoundTexture(int32 Index) const
+{
+	return Index != INDEX_NONE ? FrameTextures[Index]->GetPageEntry() : nullptr;
+}
+
 // ============================================================================
 // Command executors
 // ============================================================================
 
-void FRmlDrawer::ExecuteDrawMesh(FRHICommandListImmediate& RHICmdList, const FRmlDrawCommand& Cmd,
+void FRmlDrawer::ExecuteDrawMesh(FRHICommandListImmediate& RHICmdList, const FRmlDrawMeshCommand& Cmd,
 	TShaderMapRef<FRmlShaderVs>& Vs, TShaderMapRef<FRmlShaderPs>& Ps, TShaderMapRef<FRmlShaderPsNoTex>& PsNoTex,
 	FGraphicsPipelineStateInitializer& PSOTex, FGraphicsPipelineStateInitializer& PSONoTex,
 	FRmlTextureEntry*& CurTexture)
 {
 	SCOPE_CYCLE_COUNTER(STAT_RmlUI_DrawMesh);
-	FRmlTextureEntry* NewTexture = Cmd.Texture.Get();
+	// Atlas-packed textures bind their page and remap UVs in the vertex shader, so
+	// consecutive draws from the same page don't rebind the texture.
+	FRmlTextureEntry* DrawTexture = GetTexture(Cmd.Texture);
+	FRmlTextureEntry* NewTexture = DrawTexture ? DrawTexture->GetPageEntry() : nullptr;
+	const FVector4f& UVRect = DrawTexture ? DrawTexture->AtlasUVRect : IdentityUVRect;
 
 	if (NewTexture != CurTexture)
 	{
 		if ((CurTexture != nullptr) != (NewTexture != nullptr))
+		{
 			SetGraphicsPipelineState(RHICmdList, NewTexture ? PSOTex : PSONoTex, 0);
+			InvalidateBoundDrawState();
+		}
 
 		if (NewTexture)
 			Ps->SetParameters(RHICmdList, Ps.GetPixelShader(), NewTexture->GetTextureRHI(),
@@ -286,28 +399,50 @@ void FRmlDrawer::ExecuteDrawMesh(FRHICommandListImmediate& RHICmdList, const FRm
 	if (bClipMaskActive)
 		RHICmdList.SetStencilRef(StencilRef);
 
-	Vs->SetParameters(RHICmdList, Cmd.Transform);
+	// Transform and scissor are interned per frame, so index equality means the
+	// bound state is already correct.
+	if (Cmd.Transform != BoundTransform || Cmd.Translation != BoundTranslation || UVRect != BoundUVRect)
+	{
+		Vs->SetParameters(RHICmdList, GetDrawTransform(Cmd), UVRect);
+		BoundTransform = Cmd.Transform;
+		BoundTranslation = Cmd.Translation;
+		BoundUVRect = UVRect;
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_RmlUI_TransformBindsSkipped);
+	}
 
-	RHICmdList.SetScissorRect(
-		true,
-		Cmd.ScissorRect.Min.X,
-		Cmd.ScissorRect.Min.Y,
-		Cmd.ScissorRect.Max.X,
-		Cmd.ScissorRect.Max.Y);
+	if (Cmd.Scissor != BoundScissor)
+	{
+		const FIntRect& ScissorRect = FrameScissors[Cmd.Scissor];
+		RHICmdList.SetScissorRect(
+			true,
+			ScissorRect.Min.X,
+			ScissorRect.Min.Y,
+			ScissorRect.Max.X,
+			ScissorRect.Max.Y);
+		BoundScissor = Cmd.Scissor;
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_RmlUI_ScissorBindsSkipped);
+	}
 
-	RHICmdList.SetStreamSource(0, FrameVB, 0);
-	RHICmdList.DrawIndexedPrimitive(FrameIB, Cmd.BaseVertex, 0, Cmd.Mesh->NumVertices, Cmd.StartIndex, Cmd.Mesh->NumTriangles, 1);
+	DrawCommandGeometry(RHICmdList, Cmd);
 }
 
-void FRmlDrawer::ExecuteEnableClipMask(FRHICommandListImmediate& RHICmdList, const FRmlDrawCommand& Cmd)
+void FRmlDrawer::ExecuteEnableClipMask(FRHICommandListImmediate& RHICmdList, const FRmlEnableClipMaskCommand& Cmd)
 {
-	bClipMaskActive = Cmd.bClipMaskEnable;
+	bClipMaskActive = Cmd.bEnable;
 	// PSOs will be rebuilt on next DrawMesh when stencil state changed
 }
 
-void FRmlDrawer::ExecuteRenderToClipMask(FRHICommandListImmediate& RHICmdList, const FRmlDrawCommand& Cmd,
+void FRmlDrawer::ExecuteRenderToClipMask(FRHICommandListImmediate& RHICmdList, const FRmlRenderToClipMaskCommand& Cmd,
 	TShaderMapRef<FRmlShaderVs>& Vs, TShaderMapRef<FRmlShaderPsNoTex>& PsNoTex)
 {
+	const FIntRect& ScissorRect = FrameScissors[Cmd.Scissor];
+
 	// No color write — stencil only
 	auto* NoColorWrite = TStaticBlendState<CW_NONE>::GetRHI();
 
@@ -350,15 +485,14 @@ void FRmlDrawer::ExecuteRenderToClipMask(FRHICommandListImmediate& RHICmdList, c
 		// Step 2: Write opposite value where geometry covers
 		SetGraphicsPipelineState(RHICmdList, StencilPSO, 0);
 		RHICmdList.SetStencilRef(WriteRef);
-		Vs->SetParameters(RHICmdList, Cmd.Transform);
+		Vs->SetParameters(RHICmdList, GetDrawTransform(Cmd));
 		RHICmdList.SetScissorRect(
 			true,
-			Cmd.ScissorRect.Min.X,
-			Cmd.ScissorRect.Min.Y,
-			Cmd.ScissorRect.Max.X,
-			Cmd.ScissorRect.Max.Y);
-		RHICmdList.SetStreamSource(0, FrameVB, 0);
-		RHICmdList.DrawIndexedPrimitive(FrameIB, Cmd.BaseVertex, 0, Cmd.Mesh->NumVertices, Cmd.StartIndex, Cmd.Mesh->NumTriangles, 1);
+			ScissorRect.Min.X,
+			ScissorRect.Min.Y,
+			ScissorRect.Max.X,
+			ScissorRect.Max.Y);
+		DrawCommandGeometry(RHICmdList, Cmd);
 
 		StencilRef = 1;
 		break;
@@ -377,21 +511,20 @@ void FRmlDrawer::ExecuteRenderToClipMask(FRHICommandListImmediate& RHICmdList, c
 
 		SetGraphicsPipelineState(RHICmdList, StencilPSO, 0);
 		RHICmdList.SetStencilRef(0);
-		Vs->SetParameters(RHICmdList, Cmd.Transform);
+		Vs->SetParameters(RHICmdList, GetDrawTransform(Cmd));
 		RHICmdList.SetScissorRect(
 			true,
-			Cmd.ScissorRect.Min.X,
-			Cmd.ScissorRect.Min.Y,
-			Cmd.ScissorRect.Max.X,
-			Cmd.ScissorRect.Max.Y);
-		RHICmdList.SetStreamSource(0, FrameVB, 0);
-		RHICmdList.DrawIndexedPrimitive(FrameIB, Cmd.BaseVertex, 0, Cmd.Mesh->NumVertices, Cmd.StartIndex, Cmd.Mesh->NumTriangles, 1);
+			ScissorRect.Min.X,
+			ScissorRect.Min.Y,
+			ScissorRect.Max.X,
+			ScissorRect.Max.Y);
+		DrawCommandGeometry(RHICmdList, Cmd);
 		break;
 	}
 	}
 }
 
-void FRmlDrawer::ExecutePushLayer(FRHICommandListImmediate& RHICmdList, const FRmlDrawCommand& Cmd, const FIntPoint& RTSize)
+void FRmlDrawer::ExecutePushLayer(FRHICommandListImmediate& RHICmdList, const FRmlPushLayerCommand& Cmd, const FIntPoint& RTSize)
 {
 	EndCurrentRenderPass(RHICmdList);
 
@@ -401,38 +534,25 @@ void FRmlDrawer::ExecutePushLayer(FRHICommandListImmediate& RHICmdList, const FR
 	BeginLayerRenderPass(RHICmdList, NewIndex, RTSize, ERenderTargetLoadAction::EClear);
 }
 
-void FRmlDrawer::ExecuteCompositeLayers(FRHICommandListImmediate& RHICmdList, const FRmlDrawCommand& Cmd,
+void FRmlDrawer::ExecuteCompositeLayers(FRHICommandListImmediate& RHICmdList, const FRmlCompositeLayersCommand& Cmd,
 	TShaderMapRef<FRmlShaderVs>& Vs, TShaderMapRef<FRmlShaderPs>& Ps, const FIntPoint& RTSize)
 {
 	EndCurrentRenderPass(RHICmdList);
 
+	const TConstArrayView<TSharedPtr<FCompiledRmlFilter>> Filters(FrameFilters.GetData() + Cmd.FirstFilter, Cmd.NumFilters);
+
 	FTextureRHIRef SrcRT = LayerStack.GetColorRT(Cmd.SourceLayer);
 	FTextureRHIRef DstRT = LayerStack.GetColorRT(Cmd.DestLayer);
 
-	// Check if ALL filters are identity (will be skipped by ApplyFilters).
-	// When true, the entire resolve → filter → composite pipeline can be replaced
+	// Reduce the chain to the passes that actually change pixels. No steps: every filter
+	// is an identity and the entire resolve → filter → composite pipeline can be replaced
 	// with a single scissored composite pass, saving massive bandwidth at high res.
-	bool bAllIdentity = true;
-	for (const auto& F : Cmd.Filters)
-	{
-		if (!F) continue;
-		switch (F->Type)
-		{
-		case ERmlFilterType::Passthrough:
-			if (F->BlendFactor < 1.0f) bAllIdentity = false;
-			break;
-		case ERmlFilterType::Blur:
-			if (F->Sigma >= 0.01f) bAllIdentity = false;
-			break;
-		case ERmlFilterType::ColorMatrix:
-			if (!F->ColorMatrix.Equals(FMatrix44f::Identity, KINDA_SMALL_NUMBER)) bAllIdentity = false;
-			break;
-		default:
-			bAllIdentity = false;
-			break;
-		}
-		if (!bAllIdentity) break;
-	}
+	// Without MSAA the same holds for a single fused per-pixel step (no ink overflow, and
+	// the source layer can be sampled directly): it runs as part of the composite.
+	TArray<FRmlFilterStep, TInlineAllocator<8>> Steps;
+	CompileFilterSteps(Filters, Steps);
+	const bool bAllIdentity = Steps.Num() == 0;
+	const bool bFuseIntoComposite = !bUseMSAA && Steps.Num() == 1 && !Steps[0].Filter;
 
 	// --- Common blend and stencil state (shared by all paths) ---
 	FRHIBlendState* CompBlend;
@@ -454,13 +574,13 @@ void FRmlDrawer::ExecuteCompositeLayers(FRHICommandListImmediate& RHICmdList, co
 		CompDSS = TStaticDepthStencilState<false, CF_Always>::GetRHI();
 
 	// ================================================================
-	// FAST PATH: All filters are identity — single scissored pass.
-	// Skips the separate MSAA resolve and PostprocessA detour entirely.
+	// FAST PATH: All filters are identity (or one fused step) — single scissored pass.
+	// Skips the separate MSAA resolve and filter region detour entirely.
 	// For MSAA: uses Texture2DMS manual resolve in the pixel shader.
 	// For non-MSAA: samples the source layer directly (has ShaderResource).
 	// Scissoring limits fill to the element bounds instead of fullscreen.
 	// ================================================================
-	if (bAllIdentity)
+	if (bAllIdentity || bFuseIntoComposite)
 	{
 		auto ShaderMap = GetGlobalShaderMap(ERHIFeatureLevel::SM5);
 
@@ -468,7 +588,10 @@ void FRmlDrawer::ExecuteCompositeLayers(FRHICommandListImmediate& RHICmdList, co
 		FRHIPixelShader* PixelShaderRHI;
 		TShaderMapRef<FRmlShaderPsMsaaResolve> MsaaResolvePs(ShaderMap);
 		TShaderMapRef<FRmlShaderPsPassthrough> PassPs(ShaderMap);
-		if (bUseMSAA)
+		TShaderMapRef<FRmlShaderPsFilterChain> FilterChainPs(ShaderMap);
+		if (bFuseIntoComposite)
+			PixelShaderRHI = FilterChainPs.GetPixelShader();
+		else if (bUseMSAA)
 			PixelShaderRHI = MsaaResolvePs.GetPixelShader();
 		else
 			PixelShaderRHI = PassPs.GetPixelShader();
@@ -501,12 +624,18 @@ void FRmlDrawer::ExecuteCompositeLayers(FRHICommandListImmediate& RHICmdList, co
 			RHICmdList.SetStencilRef(StencilRef);
 
 		Vs->SetParameters(RHICmdList, FMatrix44f::Identity);
-		if (bUseMSAA)
+		if (bFuseIntoComposite)
+		{
+			const FRmlFilterStep& Step = Steps[0];
+			FRHITexture* MaskTexture = Step.MaskTexture.IsValid() ? Step.MaskTexture.GetReference() : GWhiteTexture->TextureRHI.GetReference();
+			FilterChainPs->SetParameters(RHICmdList, PixelShaderRHI, SrcRT, Step.ColorMatrix, Step.Opacity, MaskTexture);
+		}
+		else if (bUseMSAA)
 			MsaaResolvePs->SetParameters(RHICmdList, PixelShaderRHI, SrcRT, MSAASamples);
 		else
 			PassPs->SetParameters(RHICmdList, PixelShaderRHI, SrcRT, 1.0f);
 
-		// Identity filters have no ink overflow — scissor to element bounds.
+		// Per-pixel filters have no ink overflow — scissor to element bounds.
 		RHICmdList.SetScissorRect(true,
 			Cmd.ScissorRect.Min.X, Cmd.ScissorRect.Min.Y,
 			Cmd.ScissorRect.Max.X, Cmd.ScissorRect.Max.Y);
@@ -527,7 +656,7 @@ void FRmlDrawer::ExecuteCompositeLayers(FRHICommandListImmediate& RHICmdList, co
 	// Compute padded scissor that covers filter ink overflow (blur extent + shadow offset).
 	// Pushed layers contain only the element's content — the rest is transparent.
 	FIntRect PaddedScissor = Cmd.ScissorRect;
-	for (const auto& F : Cmd.Filters)
+	for (const auto& F : Filters)
 	{
 		if (!F) continue;
 		if (F->Type == ERmlFilterType::Blur && F->Sigma >= 0.01f)
@@ -555,22 +684,25 @@ void FRmlDrawer::ExecuteCompositeLayers(FRHICommandListImmediate& RHICmdList, co
 		RTSize.X, RTSize.Y,
 		Cmd.ScissorRect.Min.X, Cmd.ScissorRect.Min.Y, Cmd.ScissorRect.Max.X, Cmd.ScissorRect.Max.Y,
 		PaddedScissor.Min.X, PaddedScissor.Min.Y, PaddedScissor.Max.X, PaddedScissor.Max.Y,
-		Cmd.Filters.Num());
-
-	// Step 1: Scissored resolve/blit source layer → PostprocessA.
-	// Clear_Store fast-clears to transparent (hardware fast clear, ~zero cost),
-	// then the scissored draw populates only the padded element region.
-	// Zeros outside ensure blur/shadow kernels read transparent at boundaries.
+		Filters.Num());
+
+	// Step 1: Resolve/blit the padded element out of the source layer into an
+	// element-sized filter target. Clear_Store fast-clears to transparent and the
+	// scissored draw populates only the padded element; zeros around it (and in the
+	// granularity slack) ensure blur/shadow kernels read transparent at boundaries.
+	// Every filter pass after this runs at element size, not layer size.
+	FRmlFilterRegion Region;
+	LayerStack.BeginFilterRegion(RHICmdList, PaddedScissor, Region);
+	const FIntRect LocalRect = Region.GetLocalRect();
 	{
 		auto ShaderMap = GetGlobalShaderMap(ERHIFeatureLevel::SM5);
 		TShaderMapRef<FRmlShaderPsMsaaResolve> MsaaResolvePs(ShaderMap);
 		TShaderMapRef<FRmlShaderPsPassthrough> ResolvePassPs(ShaderMap);
 
-		FRHIRenderPassInfo ResolvePassInfo(LayerStack.PostprocessA, ERenderTargetActions::Clear_Store);
+		FRHIRenderPassInfo ResolvePassInfo(Region.A, ERenderTargetActions::Clear_Store);
 		RHICmdList.BeginRenderPass(ResolvePassInfo, TEXT("RmlUI_ScissoredResolve"));
-		RHICmdList.SetViewport(0, 0, 0.0f, (float)RTSize.X, (float)RTSize.Y, 1.0f);
-		RHICmdList.SetScissorRect(true, PaddedScissor.Min.X, PaddedScissor.Min.Y,
-			PaddedScissor.Max.X, PaddedScissor.Max.Y);
+		RHICmdList.SetViewport(0, 0, 0.0f, (float)Region.Extent.X, (float)Region.Extent.Y, 1.0f);
+		RHICmdList.SetScissorRect(true, LocalRect.Min.X, LocalRect.Min.Y, LocalRect.Max.X, LocalRect.Max.Y);
 
 		FRHIPixelShader* PixelShaderRHI = bUseMSAA
 			? MsaaResolvePs.GetPixelShader() : ResolvePassPs.GetPixelShader();
@@ -589,20 +721,22 @@ void FRmlDrawer::ExecuteCompositeLayers(FRHICommandListImmediate& RHICmdList, co
 
 		Vs->SetParameters(RHICmdList, FMatrix44f::Identity);
 		if (bUseMSAA)
-			MsaaResolvePs->SetParameters(RHICmdList, PixelShaderRHI, SrcRT, MSAASamples);
+		{
+			MsaaResolvePs->SetParameters(RHICmdList, PixelShaderRHI, SrcRT, MSAASamples, Region.Origin);
+		}
 		else
-			ResolvePassPs->SetParameters(RHICmdList, PixelShaderRHI, SrcRT, 1.0f);
+		{
+			// Region UV 0-1 → layer UV of the Extent-sized rect at Origin.
+			const FVector2f UVScale((float)Region.Extent.X / (float)RTSize.X, (float)Region.Extent.Y / (float)RTSize.Y);
+			const FVector2f UVOffset((float)Region.Origin.X / (float)RTSize.X, (float)Region.Origin.Y / (float)RTSize.Y);
+			ResolvePassPs->SetParameters(RHICmdList, PixelShaderRHI, SrcRT, 1.0f, UVScale, UVOffset);
+		}
 		DrawFullscreenQuad(RHICmdList);
 		RHICmdList.EndRenderPass();
 	}
 
-	// Step 2: Apply filters (all passes scissored to PaddedScissor)
-	FTextureRHIRef FilteredSource = LayerStack.PostprocessA;
-	if (Cmd.Filters.Num() > 0)
-	{
-		FTextureRHIRef* Result = ApplyFilters(RHICmdList, Cmd.Filters, Vs, RTSize, PaddedScissor);
-		FilteredSource = *Result;
-	}
+	// Step 2: Apply filters (all passes in region space, scissored to the padded element)
+	FTextureRHIRef FilteredSource = *ApplyFilters(RHICmdList, Steps, Vs, Region, RTSize);
 
 	// Step 3: Composite filtered source onto destination layer (scissored)
 	FRHIRenderPassInfo CompPassInfo;
@@ -635,7 +769,12 @@ void FRmlDrawer::ExecuteCompositeLayers(FRHICommandListImmediate& RHICmdList, co
 	if (bClipMaskActive)
 		RHICmdList.SetStencilRef(StencilRef);
 
-	Vs->SetParameters(RHICmdList, FMatrix44f::Identity);
+	// Layer UV → region UV: the quad covers the layer, the region texture only the
+	// Extent-sized rect at Origin.
+	const FVector4f RegionUVRect(
+		(float)RTSize.X / (float)Region.Extent.X, (float)RTSize.Y / (float)Region.Extent.Y,
+		-(float)Region.Origin.X / (float)Region.Extent.X, -(float)Region.Origin.Y / (float)Region.Extent.Y);
+	Vs->SetParameters(RHICmdList, FMatrix44f::Identity, RegionUVRect);
 	PassPs->SetParameters(RHICmdList, PassPs.GetPixelShader(), FilteredSource, 1.0f);
 
 	// Scissor to padded element bounds — covers all filter ink overflow.
@@ -647,6 +786,7 @@ void FRmlDrawer::ExecuteCompositeLayers(FRHICommandListImmediate& RHICmdList, co
 	DrawFullscreenQuad(RHICmdList);
 
 	EndCurrentRenderPass(RHICmdList);
+	LayerStack.EndFilterRegion(Region);
 	BeginLayerRenderPass(RHICmdList, LayerStack.GetTopIndex(), RTSize, ERenderTargetLoadAction::ELoad);
 }
 
@@ -661,15 +801,16 @@ void FRmlDrawer::ExecutePopLayer(FRHICommandListImmediate& RHICmdList, const FIn
 	}
 }
 
-void FRmlDrawer::ExecuteSaveLayerAsTexture(FRHICommandListImmediate& RHICmdList, const FRmlDrawCommand& Cmd, const FIntPoint& RTSize)
+void FRmlDrawer::ExecuteSaveLayerAsTexture(FRHICommandListImmediate& RHICmdList, const FRmlSaveLayerAsTextureCommand& Cmd, const FIntPoint& RTSize)
 {
-	if (!Cmd.SavedTextureTarget) return;
+	FRmlTextureEntry* Target = GetTexture(Cmd.Target);
+	if (!Target) return;
 
 	const FIntRect& Region = Cmd.ScissorRect;
 	// Use the ideal texture size (matches GPU rasterizer pixel count) instead of
 	// the conservative scissor rect size (Floor/Ceil, can be 1px wider).
-	const int32 W = (Cmd.SaveTextureIdealSize.X > 0) ? Cmd.SaveTextureIdealSize.X : Region.Width();
-	const int32 H = (Cmd.SaveTextureIdealSize.Y > 0) ? Cmd.SaveTextureIdealSize.Y : Region.Height();
+	const int32 W = (Cmd.IdealSize.X > 0) ? Cmd.IdealSize.X : Region.Width();
+	const int32 H = (Cmd.IdealSize.Y > 0) ? Cmd.IdealSize.Y : Region.Height();
 	if (W <= 0 || H <= 0) return;
 
 	EndCurrentRenderPass(RHICmdList);
@@ -748,15 +889,15 @@ void FRmlDrawer::ExecuteSaveLayerAsTexture(FRHICommandListImmediate& RHICmdList,
 	}
 
 	// Store the RHI texture on the entry — subsequent draw commands will pick it up
-	Cmd.SavedTextureTarget->OverrideRHI = SavedRT;
+	Target->OverrideRHI = SavedRT;
 
 	// Resume rendering on the current top layer
 	BeginLayerRenderPass(RHICmdList, LayerStack.GetTopIndex(), RTSize, ERenderTargetLoadAction::ELoad);
 }
 
-void FRmlDrawer::ExecuteSaveLayerAsMaskImage(FRHICommandListImmediate& RHICmdList, const FRmlDrawCommand& Cmd, const FIntPoint& RTSize)
+void FRmlDrawer::ExecuteSaveLayerAsMaskImage(FRHICommandListImmediate& RHICmdList, const FRmlSaveLayerAsMaskImageCommand& Cmd, const FIntPoint& RTSize)
 {
-	if (!Cmd.SavedMaskTarget) return;
+	if (!Cmd.Target) return;
 
 	EndCurrentRenderPass(RHICmdList);
 
@@ -796,19 +937,17 @@ void FRmlDrawer::ExecuteSaveLayerAsMaskImage(FRHICommandListImmediate& RHICmdLis
 	RHICmdList.CopyTexture(ResolvedRT, LayerStack.BlendMaskRT, CopyInfo);
 
 	// Store as the mask filter's texture
-	Cmd.SavedMaskTarget->MaskTexture = LayerStack.BlendMaskRT;
+	Cmd.Target->MaskTexture = LayerStack.BlendMaskRT;
 
 	// Resume rendering
 	BeginLayerRenderPass(RHICmdList, LayerStack.GetTopIndex(), RTSize, ERenderTargetLoadAction::ELoad);
 }
 
-void FRmlDrawer::ExecuteDrawShader(FRHICommandListImmediate& RHICmdList, const FRmlDrawCommand& Cmd,
+void FRmlDrawer::ExecuteDrawShader(FRHICommandListImmediate& RHICmdList, const FRmlDrawShaderCommand& Cmd,
 	TShaderMapRef<FRmlShaderVs>& Vs, const FIntPoint& RTSize)
 {
-	if (!CompiledShaders || !CompiledShaders->Contains(Cmd.ShaderHandle))
-		return;
-
-	const FCompiledRmlShader& Shader = **CompiledShaders->Find(Cmd.ShaderHandle);
+	const FCompiledRmlShader& Shader = *FrameShaders[Cmd.Shader];
+	const FIntRect& ScissorRect = FrameScissors[Cmd.Scissor];
 
 	auto ShaderMap = GetGlobalShaderMap(ERHIFeatureLevel::SM5);
 	TShaderMapRef<FRmlShaderPsGradient> GradientPs(ShaderMap);
@@ -862,7 +1001,7 @@ void FRmlDrawer::ExecuteDrawShader(FRHICommandListImmediate& RHICmdList, const F
 	if (bClipMaskActive)
 		RHICmdList.SetStencilRef(StencilRef);
 
-	Vs->SetParameters(RHICmdList, Cmd.Transform);
+	Vs->SetParameters(RHICmdList, GetDrawTransform(Cmd));
 	switch (Shader.Type)
 	{
 	case ERmlShaderType::Gradient:
@@ -877,36 +1016,108 @@ void FRmlDrawer::ExecuteDrawShader(FRHICommandListImmediate& RHICmdList, const F
 
 	RHICmdList.SetScissorRect(
 		true,
-		Cmd.ScissorRect.Min.X,
-		Cmd.ScissorRect.Min.Y,
-		Cmd.ScissorRect.Max.X,
-		Cmd.ScissorRect.Max.Y);
+		ScissorRect.Min.X,
+		ScissorRect.Min.Y,
+		ScissorRect.Max.X,
+		ScissorRect.Max.Y);
 
-	RHICmdList.SetStreamSource(0, FrameVB, 0);
-	RHICmdList.DrawIndexedPrimitive(FrameIB, Cmd.BaseVertex, 0, Cmd.Mesh->NumVertices, Cmd.StartIndex, Cmd.Mesh->NumTriangles, 1);
+	DrawCommandGeometry(RHICmdList, Cmd);
 }
 
 // ============================================================================
 // Filter pipeline
 // ============================================================================
 
-FTextureRHIRef* FRmlDrawer::ApplyFilters(FRHICommandListImmediate& RHICmdList, const TArray<TSharedPtr<FCompiledRmlFilter>>& Filters,
-	TShaderMapRef<FRmlShaderVs>& Vs, const FIntPoint& RTSize, const FIntRect& ScissorRect)
+void FRmlDrawer::CompileFilterSteps(TConstArrayView<TSharedPtr<FCompiledRmlFilter>> Filters,
+	TArray<FRmlFilterStep, TInlineAllocator<8>>& OutSteps)
+{
+	OutSteps.Reset();
+
+	// The fused step being built, if the last filter was a per-pixel one.
+	int32 FusedIndex = INDEX_NONE;
+	auto GetFused = [&]() -> FRmlFilterStep&
+	{
+		if (FusedIndex == INDEX_NONE)
+			FusedIndex = OutSteps.AddDefaulted();
+		return OutSteps[FusedIndex];
+	};
+
+	for (const TSharedPtr<FCompiledRmlFilter>& FilterPtr : Filters)
+	{
+		if (!FilterPtr) continue;
+		const FCompiledRmlFilter& Filter = *FilterPtr;
+
+		switch (Filter.Type)
+		{
+		case ERmlFilterType::Passthrough:
+			if (Filter.BlendFactor < 1.0f)	// opacity(1) has no visual effect
+				GetFused().Opacity *= Filter.BlendFactor;
+			break;
+
+		case ERmlFilterType::ColorMatrix:
+			// Identity matrices (brightness(1) etc. from data-bound filter strings) fold
+			// away here, the product is checked below.
+		{
+			FRmlFilterStep& Step = GetFused();
+			Step.ColorMatrix = Step.ColorMatrix * Filter.ColorMatrix;
+			break;
+		}
+
+		case ERmlFilterType::MaskImage:
+			if (!Filter.MaskTexture.IsValid())
+				break;
+			// One mask texture per pass; a second mask starts a new fused step.
+			if (FusedIndex != INDEX_NONE && OutSteps[FusedIndex].MaskTexture.IsValid())
+				FusedIndex = INDEX_NONE;
+			GetFused().MaskTexture = Filter.MaskTexture;
+			break;
+
+		case ERmlFilterType::Blur:
+			if (Filter.Sigma < 0.01f)
+				break; // Skip no-op blur (edge case: animated values approaching 0)
+			OutSteps.AddDefaulted_GetRef().Filter = &Filter;
+			FusedIndex = INDEX_NONE;
+			break;
+
+		case ERmlFilterType::DropShadow:
+			OutSteps.AddDefaulted_GetRef().Filter = &Filter;
+			FusedIndex = INDEX_NONE;
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	// Drop fused steps that came out as identity.
+	OutSteps.RemoveAll([](const FRmlFilterStep& Step)
+	{
+		return !Step.Filter && !Step.MaskTexture.IsValid() && Step.Opacity >= 1.0f
+			&& Step.ColorMatrix.Equals(FMatrix44f::Identity, KINDA_SMALL_NUMBER);
+	});
+}
+
+FTextureRHIRef* FRmlDrawer::ApplyFilters(FRHICommandListImmediate& RHICmdList, TConstArrayView<FRmlFilterStep> Steps,
+	TShaderMapRef<FRmlShaderVs>& Vs, FRmlFilterRegion& Region, const FIntPoint& RTSize)
 {
-	if (Filters.Num() == 0)
-		return &LayerStack.PostprocessA;
+	if (Steps.Num() == 0)
+		return &Region.A;
+
+	// Every pass below renders into the region's textures: viewport = Extent,
+	// scissor = the padded element at the top-left.
+	const FIntPoint& Extent = Region.Extent;
+	const FIntRect ScissorRect = Region.GetLocalRect();
 
 	auto ShaderMap = GetGlobalShaderMap(ERHIFeatureLevel::SM5);
 	TShaderMapRef<FRmlShaderPs>             TexPs(ShaderMap);
 	TShaderMapRef<FRmlShaderPsPassthrough>  PassthroughPs(ShaderMap);
 	TShaderMapRef<FRmlShaderPsBlur>         BlurPs(ShaderMap);
 	TShaderMapRef<FRmlShaderPsDropShadow>   DropShadowPs(ShaderMap);
-	TShaderMapRef<FRmlShaderPsColorMatrix>  ColorMatrixPs(ShaderMap);
-	TShaderMapRef<FRmlShaderPsBlendMask>    BlendMaskPs(ShaderMap);
+	TShaderMapRef<FRmlShaderPsFilterChain>  FilterChainPs(ShaderMap);
 
-	// Current source/dest: ping-pong between PostprocessA and PostprocessB
-	FTextureRHIRef* Src = &LayerStack.PostprocessA;
-	FTextureRHIRef* Dst = &LayerStack.PostprocessB;
+	// Current source/dest: ping-pong between Region.A and Region.B
+	FTextureRHIRef* Src = &Region.A;
+	FTextureRHIRef* Dst = &Region.B;
 
 	auto SwapBuffers = [&]() { Swap(Src, Dst); };
 
@@ -918,7 +1129,7 @@ FTextureRHIRef* FRmlDrawer::ApplyFilters(FRHICommandListImmediate& RHICmdList, c
 		ERenderTargetActions Actions = bClear ? ERenderTargetActions::Clear_Store : ERenderTargetActions::DontLoad_Store;
 		FRHIRenderPassInfo PassInfo(WriteTex, Actions);
 		RHICmdList.BeginRenderPass(PassInfo, DebugName);
-		RHICmdList.SetViewport(0, 0, 0.0f, (float)RTSize.X, (float)RTSize.Y, 1.0f);
+		RHICmdList.SetViewport(0, 0, 0.0f, (float)Extent.X, (float)Extent.Y, 1.0f);
 		RHICmdList.SetScissorRect(true, ScissorRect.Min.X, ScissorRect.Min.Y,
 			ScissorRect.Max.X, ScissorRect.Max.Y);
 
@@ -940,39 +1151,35 @@ FTextureRHIRef* FRmlDrawer::ApplyFilters(FRHICommandListImmediate& RHICmdList, c
 		RHICmdList.EndRenderPass();
 	};
 
+	// Clear_Store: region targets come from the shared pool with someone else's pixels in
+	// them, and drop-shadow offsets read outside the scissor. Clearing an element-sized
+	// target is a fast clear.
 	auto BeginPostprocessPass = [&](FTextureRHIRef& Target)
 	{
-		FRHIRenderPassInfo PassInfo(Target, ERenderTargetActions::DontLoad_Store);
+		FRHIRenderPassInfo PassInfo(Target, ERenderTargetActions::Clear_Store);
 		RHICmdList.BeginRenderPass(PassInfo, TEXT("RmlUI_Filter"));
-		RHICmdList.SetViewport(0, 0, 0.0f, (float)RTSize.X, (float)RTSize.Y, 1.0f);
+		RHICmdList.SetViewport(0, 0, 0.0f, (float)Extent.X, (float)Extent.Y, 1.0f);
 		RHICmdList.SetScissorRect(true, ScissorRect.Min.X, ScissorRect.Min.Y,
 			ScissorRect.Max.X, ScissorRect.Max.Y);
 	};
 
-	for (int32 FilterIdx = 0; FilterIdx < Filters.Num(); ++FilterIdx)
+	for (const FRmlFilterStep& Step : Steps)
 	{
-		const TSharedPtr<FCompiledRmlFilter>& FilterPtr = Filters[FilterIdx];
-		if (!FilterPtr) continue;
-		const FCompiledRmlFilter& Filter = *FilterPtr;
-
-		switch (Filter.Type)
-		{
-		case ERmlFilterType::Passthrough:
+		if (!Step.Filter)
 		{
-			if (Filter.BlendFactor >= 1.0f)
-				break; // Identity: opacity(1) has no visual effect, skip pass
+			// Fused per-pixel step: color matrix, opacity and mask image in one pass.
 			BeginPostprocessPass(*Dst);
 
-			// Opaque replace — the shader already multiplies by BlendFactor, so the
+			// Opaque replace — the shader already applies opacity and mask, so the
 			// output is the final filtered image. Premul blend here would leak stale
-			// PostprocessB content through transparent areas (ghosting/permanent copies).
+			// Region.B content through transparent areas (ghosting/permanent copies).
 			auto* NoBlend = TStaticBlendState<>::GetRHI();
 
 			FGraphicsPipelineStateInitializer PSO;
 			RHICmdList.ApplyCachedRenderTargets(PSO);
 			PSO.BoundShaderState.VertexDeclarationRHI = FRmlMesh::GetMeshDeclaration();
 			PSO.BoundShaderState.VertexShaderRHI      = Vs.GetVertexShader();
-			PSO.BoundShaderState.PixelShaderRHI       = PassthroughPs.GetPixelShader();
+			PSO.BoundShaderState.PixelShaderRHI       = FilterChainPs.GetPixelShader();
 			PSO.PrimitiveType     = PT_TriangleList;
 			PSO.BlendState        = NoBlend;
 			PSO.RasterizerState   = TStaticRasterizerState<>::GetRHI();
@@ -980,14 +1187,24 @@ FTextureRHIRef* FRmlDrawer::ApplyFilters(FRHICommandListImmediate& RHICmdList, c
 
 			SetGraphicsPipelineState(RHICmdList, PSO, 0);
 			Vs->SetParameters(RHICmdList, FMatrix44f::Identity);
-			PassthroughPs->SetParameters(RHICmdList, PassthroughPs.GetPixelShader(), *Src, Filter.BlendFactor);
+
+			// The mask covers the whole layer; map region UVs onto it.
+			const FVector4f MaskUVRect(
+				(float)Extent.X / (float)RTSize.X, (float)Extent.Y / (float)RTSize.Y,
+				(float)Region.Origin.X / (float)RTSize.X, (float)Region.Origin.Y / (float)RTSize.Y);
+			FRHITexture* MaskTexture = Step.MaskTexture.IsValid() ? Step.MaskTexture.GetReference() : GWhiteTexture->TextureRHI.GetReference();
+			FilterChainPs->SetParameters(RHICmdList, FilterChainPs.GetPixelShader(), *Src,
+				Step.ColorMatrix, Step.Opacity, MaskTexture, MaskUVRect);
 			DrawFullscreenQuad(RHICmdList);
 
 			RHICmdList.EndRenderPass();
 			SwapBuffers();
-			break;
+			continue;
 		}
 
+		const FCompiledRmlFilter& Filter = *Step.Filter;
+		switch (Filter.Type)
+		{
 		case ERmlFilterType::Blur:
 		{
 			if (Filter.Sigma < 0.01f)
@@ -995,12 +1212,13 @@ FTextureRHIRef* FRmlDrawer::ApplyFilters(FRHICommandListImmediate& RHICmdList, c
 			// GL3-style downsample → blur → upsample.
 			// Run the entire chain in FP16 to avoid repeated 8-bit quantization
 			// of alpha gradients (box-shadow, drop-shadow, filter:blur).
-			// PostprocessBlurSrc + PostprocessTemp are both FP16.
+			// Region.BlurSrc + Region.BlurTemp are both FP16.
 			// bClear=true for BlurToFP16: ensures transparent outside scissor so blur
 			// kernel reads zeros (not undefined) at the boundary.
-			BlitScissored(*Src, LayerStack.PostprocessBlurSrc, TEXT("RmlUI_BlurToFP16"), /*bClear=*/true);
-			RenderBlur(RHICmdList, Filter.Sigma, LayerStack.PostprocessBlurSrc, LayerStack.PostprocessTemp, Vs, BlurPs, RTSize, ScissorRect);
-			BlitScissored(LayerStack.PostprocessBlurSrc, *Src, TEXT("RmlUI_BlurFromFP16"));
+			LayerStack.EnsureBlurTargets(RHICmdList, Region);
+			BlitScissored(*Src, Region.BlurSrc, TEXT("RmlUI_BlurToFP16"), /*bClear=*/true);
+			RenderBlur(RHICmdList, Filter.Sigma, Region.BlurSrc, Region.BlurTemp, Vs, BlurPs, Extent, ScissorRect);
+			BlitScissored(Region.BlurSrc, *Src, TEXT("RmlUI_BlurFromFP16"));
 			// Result is back in *Src — no swap needed.
 			break;
 		}
@@ -1011,7 +1229,7 @@ FTextureRHIRef* FRmlDrawer::ApplyFilters(FRHICommandListImmediate& RHICmdList, c
 			// Shadow goes into Dst, blur modifies Dst in-place using Temp,
 			// then original (Src) is drawn on top of shadow (Dst) with premul blend.
 
-			FVector2f TexelSize(1.0f / (float)RTSize.X, 1.0f / (float)RTSize.Y);
+			FVector2f TexelSize(1.0f / (float)Extent.X, 1.0f / (float)Extent.Y);
 			auto* NoBlend = TStaticBlendState<>::GetRHI();
 
 			// Step 1: Draw shadow from Src into Dst (no swap — Src stays as original)
@@ -1040,9 +1258,10 @@ FTextureRHIRef* FRmlDrawer::ApplyFilters(FRHICommandListImmediate& RHICmdList, c
 			// Run in FP16 to avoid 8-bit quantization of alpha gradients.
 			if (Filter.Sigma > 0.0f)
 			{
-				BlitScissored(*Dst, LayerStack.PostprocessBlurSrc, TEXT("RmlUI_DropShadowBlurToFP16"), /*bClear=*/true);
-				RenderBlur(RHICmdList, Filter.Sigma, LayerStack.PostprocessBlurSrc, LayerStack.PostprocessTemp, Vs, BlurPs, RTSize, ScissorRect);
-				BlitScissored(LayerStack.PostprocessBlurSrc, *Dst, TEXT("RmlUI_DropShadowBlurFromFP16"));
+				LayerStack.EnsureBlurTargets(RHICmdList, Region);
+				BlitScissored(*Dst, Region.BlurSrc, TEXT("RmlUI_DropShadowBlurToFP16"), /*bClear=*/true);
+				RenderBlur(RHICmdList, Filter.Sigma, Region.BlurSrc, Region.BlurTemp, Vs, BlurPs, Extent, ScissorRect);
+				BlitScissored(Region.BlurSrc, *Dst, TEXT("RmlUI_DropShadowBlurFromFP16"));
 			}
 
 			// Step 3: Overlay original (Src) on top of shadow (Dst) with premul blend
@@ -1050,7 +1269,7 @@ FTextureRHIRef* FRmlDrawer::ApplyFilters(FRHICommandListImmediate& RHICmdList, c
 			{
 				FRHIRenderPassInfo PassInfo(*Dst, ERenderTargetActions::Load_Store);
 				RHICmdList.BeginRenderPass(PassInfo, TEXT("RmlUI_DropShadowOverlay"));
-				RHICmdList.SetViewport(0, 0, 0.0f, (float)RTSize.X, (float)RTSize.Y, 1.0f);
+				RHICmdList.SetViewport(0, 0, 0.0f, (float)Extent.X, (float)Extent.Y, 1.0f);
 				RHICmdList.SetScissorRect(true, ScissorRect.Min.X, ScissorRect.Min.Y,
 					ScissorRect.Max.X, ScissorRect.Max.Y);
 
@@ -1080,82 +1299,12 @@ FTextureRHIRef* FRmlDrawer::ApplyFilters(FRHICommandListImmediate& RHICmdList, c
 			break;
 		}
 
-		case ERmlFilterType::ColorMatrix:
-		{
-			// Merge consecutive ColorMatrix filters into a single matrix multiplication.
-			// This turns N separate render passes into 1 when multiple color filters
-			// (brightness, contrast, sepia, etc.) are active simultaneously.
-			FMatrix44f MergedMatrix = Filter.ColorMatrix;
-			while (FilterIdx + 1 < Filters.Num())
-			{
-				const TSharedPtr<FCompiledRmlFilter>& NextPtr = Filters[FilterIdx + 1];
-				if (!NextPtr || NextPtr->Type != ERmlFilterType::ColorMatrix)
-					break;
-				MergedMatrix = MergedMatrix * NextPtr->ColorMatrix;
-				FilterIdx++;	// skip merged filter
-			}
-
-			if (MergedMatrix.Equals(FMatrix44f::Identity, KINDA_SMALL_NUMBER))
-				break; // Merged result is identity: no color transform, skip pass
-
-			BeginPostprocessPass(*Dst);
-
-			auto* NoBlend = TStaticBlendState<>::GetRHI();
-
-			FGraphicsPipelineStateInitializer PSO;
-			RHICmdList.ApplyCachedRenderTargets(PSO);
-			PSO.BoundShaderState.VertexDeclarationRHI = FRmlMesh::GetMeshDeclaration();
-			PSO.BoundShaderState.VertexShaderRHI      = Vs.GetVertexShader();
-			PSO.BoundShaderState.PixelShaderRHI       = ColorMatrixPs.GetPixelShader();
-			PSO.PrimitiveType     = PT_TriangleList;
-			PSO.BlendState        = NoBlend;
-			PSO.RasterizerState   = TStaticRasterizerState<>::GetRHI();
-			PSO.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
-
-			SetGraphicsPipelineState(RHICmdList, PSO, 0);
-			Vs->SetParameters(RHICmdList, FMatrix44f::Identity);
-			ColorMatrixPs->SetParameters(RHICmdList, ColorMatrixPs.GetPixelShader(), *Src, MergedMatrix);
-			DrawFullscreenQuad(RHICmdList);
-
-			RHICmdList.EndRenderPass();
-			SwapBuffers();
-			break;
-		}
-
-		case ERmlFilterType::MaskImage:
-		{
-			if (!Filter.MaskTexture.IsValid()) break;
-
-			BeginPostprocessPass(*Dst);
-
-			auto* NoBlend = TStaticBlendState<>::GetRHI();
-
-			FGraphicsPipelineStateInitializer PSO;
-			RHICmdList.ApplyCachedRenderTargets(PSO);
-			PSO.BoundShaderState.VertexDeclarationRHI = FRmlMesh::GetMeshDeclaration();
-			PSO.BoundShaderState.VertexShaderRHI      = Vs.GetVertexShader();
-			PSO.BoundShaderState.PixelShaderRHI       = BlendMaskPs.GetPixelShader();
-			PSO.PrimitiveType     = PT_TriangleList;
-			PSO.BlendState        = NoBlend;
-			PSO.RasterizerState   = TStaticRasterizerState<>::GetRHI();
-			PSO.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
-
-			SetGraphicsPipelineState(RHICmdList, PSO, 0);
-			Vs->SetParameters(RHICmdList, FMatrix44f::Identity);
-			BlendMaskPs->SetParameters(RHICmdList, BlendMaskPs.GetPixelShader(), *Src, Filter.MaskTexture);
-			DrawFullscreenQuad(RHICmdList);
-
-			RHICmdList.EndRenderPass();
-			SwapBuffers();
-			break;
-		}
-
 		default:
 			break;
 		}
 	}
 
-	return Src;  // Result is in *Src after ping-pong (could be PostprocessA or PostprocessB)
+	return Src;  // Result is in *Src after ping-pong (could be Region.A or Region.B)
 }
 
 // ============================================================================
@@ -1413,194 +1562,358 @@ void FRmlDrawer::RenderBlur(FRHICommandListImmediate& RHICmdList, float Sigma,
 }
 
 // ============================================================================
-// BuildFrameGeometry — render-thread pre-pass for shared VB/IB
+// MergeDrawBatches — render-thread pass that collapses runs of DrawMesh
 // ============================================================================
 
-void FRmlDrawer::BuildFrameGeometry(FRHICommandListImmediate& RHICmdList)
+void FRmlDrawer::MergeDrawBatches()
 {
-	// Accumulate all mesh vertices and indices from every command that has a mesh
-	// (DrawMesh, RenderToClipMask, DrawShader) into two flat arrays.
-	// We don't modify the indices — the GPU baseVertexIndex parameter offsets them.
+	++BatchEpoch;
 
-	TResourceArray<FRmlMesh::FVertexData> AllVerts;
-	TResourceArray<uint16>               AllIdx;
+	uint32 DrawsBefore = 0;
+	uint32 DrawsAfter = 0;
+	int32 NumVertices = 0;
 
-	for (auto& Cmd : CommandList)
+	// Collapse the current run into its first command; the rest are skipped.
+	auto FlushRun = [&]()
 	{
-		if (!Cmd.Mesh.IsValid()) continue;
-		FRmlMesh* M = Cmd.Mesh.Get();
-		if (M->NumVertices == 0 || M->NumTriangles == 0) continue;
+		if (MergeRun.Num() > 1)
+		{
+			MergeRun[0]->Mesh = FrameMeshes.Add(GetOrBuildBatch(MergeRun, NumVertices));
+			for (int32 i = 1; i < MergeRun.Num(); ++i)
+				MergeRun[i]->bSkip = true;
+
+			// Atlas UVs are baked into the batch, so it draws with the page itself.
+			FRmlTextureEntry* Page = GetBoundTexture(MergeRun[0]->Texture);
+			if (Page != GetTexture(MergeRun[0]->Texture))
+				MergeRun[0]->Texture = FrameTextures.Add(Page);
+		}
+		MergeRun.Reset();
+	};
 
-		// Record the slice offsets in the command (pre-pass writes, execute loop reads)
-		Cmd.BaseVertex = AllVerts.Num();
-		Cmd.StartIndex = AllIdx.Num();
+	for (FRmlCommand& Cmd : Commands)
+	{
+		if (Cmd.Type != ERmlCommand::DrawMesh)
+		{
+			FlushRun();
+			continue;
+		}
 
-		// Append — no index rewriting; DrawIndexedPrimitive's baseVertexIndex handles the offset
-		AllVerts.Append(M->Vertices.GetData(), M->Vertices.Num());
-		AllIdx.Append(M->Indices.GetData(), M->Indices.Num());
+		FRmlDrawMeshCommand& Draw = Cmd.As<FRmlDrawMeshCommand>();
+		const FRmlMesh* Mesh = FrameMeshes[Draw.Mesh];
+		++DrawsBefore;
+
+		// Adjacent DrawMesh commands have no state change between them (clip mask,
+		// layer, blend), so the only things that must match are texture, scissor
+		// and transform. Transform state is interned without the per-draw translation,
+		// so equal indices mean "same up to translation". Textures packed into the same
+		// atlas page count as the same texture. Indices are uint16 — stop before
+		// overflowing them.
+		if (MergeRun.Num() > 0)
+		{
+			const FRmlDrawMeshCommand& First = *MergeRun[0];
+			const bool bCompatible = GetBoundTexture(Draw.Texture) == GetBoundTexture(First.Texture)
+				&& Draw.Scissor == First.Scissor
+				&& Draw.Transform == First.Transform
+				&& NumVertices + Mesh->NumVertices <= MAX_uint16 + 1;
+			if (bCompatible)
+			{
+				MergeRun.Add(&Draw);
+				NumVertices += Mesh->NumVertices;
+				continue;
+			}
+			FlushRun();
+		}
+
+		MergeRun.Add(&Draw);
+		NumVertices = Mesh->NumVertices;
+		++DrawsAfter;
 	}
+	FlushRun();
 
-	if (AllVerts.Num() == 0)
+	// Drop batches that haven't matched for a couple of draws. Drawers are pooled
+	// across widgets, so allow a little slack before evicting.
+	for (auto It = BatchCache.CreateIterator(); It; ++It)
 	{
-		FrameVB.SafeRelease();
-		FrameIB.SafeRelease();
-		return;
+		if (BatchEpoch - It.Value().LastUsedEpoch > 2)
+			It.RemoveCurrent();
 	}
 
-	// Create ONE VB + IB for the entire frame. BUF_Volatile uses D3D12's upload-heap
-	// ring allocator — effectively free allocation, zero copy of data from CPU to GPU.
-	const int32 VBSize = sizeof(FRmlMesh::FVertexData) * AllVerts.Num();
-	FRHIResourceCreateInfo VInfo(TEXT("RmlFrameVB"), &AllVerts);
-	FrameVB = RHICreateVertexBuffer(VBSize, BUF_Volatile, VInfo);
-
-	const int32 IBSize = sizeof(uint16) * AllIdx.Num();
-	FRHIResourceCreateInfo IInfo(TEXT("RmlFrameIB"), &AllIdx);
-	FrameIB = RHICreateIndexBuffer(sizeof(uint16), IBSize, BUF_Volatile, IInfo);
+	INC_DWORD_STAT_BY(STAT_RmlUI_DrawsBeforeMerge, DrawsBefore);
+	INC_DWORD_STAT_BY(STAT_RmlUI_DrawsAfterMerge, DrawsAfter);
 }
 
-// DrawRenderThread — main entry point
-// ============================================================================
-
-void FRmlDrawer::DrawRenderThread(FRHICommandListImmediate& RHICmdList, const void* RenderTarget)
+FRmlMesh* FRmlDrawer::GetOrBuildBatch(TConstArrayView<FRmlDrawMeshCommand*> Run, int32 NumVertices)
 {
-	SCOPE_CYCLE_COUNTER(STAT_RmlUI_DrawRenderThread);
-	check(IsInRenderingThread() || IsInParallelRenderingThread());
+	const FVector2f Origin = Run[0]->Translation;
 
-	if (CommandList.Num() == 0)
+	auto GetUVRect = [this](const FRmlDrawMeshCommand* Draw) -> const FVector4f&
 	{
-		MarkFree();
-		return;
+		const FRmlTextureEntry* Texture = GetTexture(Draw->Texture);
+		return Texture ? Texture->AtlasUVRect : IdentityUVRect;
+	};
+
+	uint32 Hash = 0;
+	for (const FRmlDrawMeshCommand* Draw : Run)
+	{
+		Hash = HashCombineFast(Hash, GetTypeHash(FrameMeshes[Draw->Mesh]));
+		Hash = HashCombineFast(Hash, GetTypeHash(Draw->Translation - Origin));
+		Hash = HashCombineFast(Hash, GetTypeHash(GetUVRect(Draw)));
 	}
 
-	const FTextureRHIRef* RT = (const FTextureRHIRef*)RenderTarget;
-	const FIntPoint RTSize((*RT)->GetSizeX(), (*RT)->GetSizeY());
-	const EPixelFormat RTFormat = (*RT)->GetFormat();
+	for (auto It = BatchCache.CreateKeyIterator(Hash); It; ++It)
+	{
+		FRmlDrawBatch& Batch = It.Value();
+		bool bMatches = Batch.Sources.Num() == Run.Num();
+		for (int32 i = 0; bMatches && i < Run.Num(); ++i)
+		{
+			bMatches = Batch.Sources[i].Get() == FrameMeshes[Run[i]->Mesh]
+				&& Batch.Offsets[i] == Run[i]->Translation - Origin
+				&& Batch.UVRects[i] == GetUVRect(Run[i]);
+		}
+		if (bMatches)
+		{
+			Batch.LastUsedEpoch = BatchEpoch;
+			FrameBatches.Add(Batch.Merged);
+			return Batch.Merged.Get();
+		}
+	}
 
-	static bool bLoggedOnce = false;
-	if (!bLoggedOnce)
+	// Miss — bake a new merged mesh. Vertices are offset by the
+	// translation delta so the whole batch draws with the first command's transform,
+	// and UVs of atlas-packed textures are remapped into page space.
+	TSharedPtr<FRmlMesh, ESPMode::ThreadSafe> Merged = MakeShared<FRmlMesh, ESPMode::ThreadSafe>();
+	int32 NumIndices = 0;
+	for (const FRmlDrawMeshCommand* Draw : Run)
+		NumIndices += FrameMeshes[Draw->Mesh]->Indices.Num();
+	Merged->Vertices.Reserve(NumVertices);
+	Merged->Indices.Reserve(NumIndices);
+
+	FRmlDrawBatch& Batch = BatchCache.Add(Hash);
+	Batch.LastUsedEpoch = BatchEpoch;
+	for (const FRmlDrawMeshCommand* Draw : Run)
 	{
-		auto FmtToStr = [](EPixelFormat F) -> const TCHAR* {
-			switch (F)
-			{
-			case PF_B8G8R8A8:     return TEXT("B8G8R8A8");
-			case PF_R8G8B8A8:     return TEXT("R8G8B8A8");
-			case PF_FloatRGBA:    return TEXT("FloatRGBA");
-			case PF_A2B10G10R10:  return TEXT("A2B10G10R10");
-			default:              return TEXT("OTHER");
-			}
-		};
-		UE_LOG(LogUERmlUI, Log, TEXT("DrawRenderThread: SlateRT=%dx%d Format=%s InternalFormat=B8G8R8A8 MSAA=%d Samples=%d Cmds=%d"),
-			RTSize.X, RTSize.Y, FmtToStr(RTFormat), bUseMSAA ? 1 : 0, MSAASamples, CommandList.Num());
-		bLoggedOnce = true;
+		FRmlMesh& Src = *FrameMeshes[Draw->Mesh];
+		const FVector2f Offset = Draw->Translation - Origin;
+		const FVector4f& UVRect = GetUVRect(Draw);
+		const FVector2f UVScale(UVRect.X, UVRect.Y);
+		const FVector2f UVOffset(UVRect.Z, UVRect.W);
+		const uint16 Base = (uint16)Merged->Vertices.Num();
+
+		for (const FRmlMesh::FVertexData& V : Src.Vertices)
+		{
+			FRmlMesh::FVertexData& Dst = Merged->Vertices.Add_GetRef(V);
+			Dst.Position += Offset;
+			Dst.UV = Dst.UV * UVScale + UVOffset;
+		}
+		for (uint16 Index : Src.Indices)
+			Merged->Indices.Add(Base + Index);
+
+		Batch.Sources.Add(Src.AsShared());
+		Batch.Offsets.Add(Offset);
+		Batch.UVRects.Add(UVRect);
 	}
+	Merged->NumVertices  = Merged->Vertices.Num();
+	Merged->NumTriangles = Merged->Indices.Num() / 3;
 
-	EnsureRenderResources(RHICmdList, RTSize, RTFormat);
+	Batch.Merged = Merged;
+	FrameBatches.Add(Merged);
+	return Merged.Get();
+}
 
-	// Pre-pass: accumulate all mesh geometry into one shared VB/IB for the frame.
-	// This replaces N×(RHICreateVertexBuffer + RHICreateIndexBuffer) with 1+1 per frame.
-	BuildFrameGeometry(RHICmdList);
+// ============================================================================
+// BuildFrameGeometry — render-thread pre-pass for shared VB/IB
+// ============================================================================
 
-	auto ShaderMap = GetGlobalShaderMap(ERHIFeatureLevel::SM5);
-	TShaderMapRef<FRmlShaderVs>      Vs(ShaderMap);
-	TShaderMapRef<FRmlShaderPs>      Ps(ShaderMap);
-	TShaderMapRef<FRmlShaderPsNoTex> PsNoTex(ShaderMap);
+void FRmlDrawer::BuildFrameGeometry(FRHICommandListImmediate& RHICmdList)
+{
+	// Accumulate all mesh vertices and indices from every command that has a mesh
+	// (DrawMesh, RenderToClipMask, DrawShader) into two flat arrays.
+	// We don't modify the indices — the GPU baseVertexIndex parameter offsets them.
+	//
+	// Meshes that have been drawn in GeometryRetainFrames distinct frames are
+	// treated as static: they are copied once into the persistent geometry arena
+	// and drawn from there, so a mostly-static UI uploads only what changed.
 
-	auto* PremulBlend = TStaticBlendState<CW_RGBA,
-		BO_Add, BF_One, BF_InverseSourceAlpha,
-		BO_Add, BF_One, BF_InverseSourceAlpha>::GetRHI();
+	FRmlGeometryArena& Arena = FRmlGeometryArena::Get();
+	Arena.ProcessPendingFrees();
 
-	// Reset state
-	bClipMaskActive = false;
-	StencilRef = 0;
-	bInRenderPass = false;
-	LayerStack.Reset();
+	const bool bRetain = GeometryRetainFrames > 0 && GeometryArenaBytes > 0;
+	const uint32 FrameNumber = GFrameCounterRenderThread;
 
-	// --- BeginFrame: push base layer ---
-	int32 BaseLayerIndex = LayerStack.Push(RHICmdList);
-	check(BaseLayerIndex == 0);
+	TResourceArray<FRmlMesh::FVertexData> AllVerts;
+	TResourceArray<uint16>               AllIdx;
 
-	// BeginFrame: copy Slate RT background into our internal layer 0 via shader blit.
-	// MSAA: populates all samples; Non-MSAA: handles format conversion (A2B10G10R10→B8G8R8A8).
-	// At EndFrame, we blit back (with MSAA resolve if needed).
+	// Meshes appended to AllVerts this frame — a mesh drawn several times is uploaded once.
+	TMap<FRmlMesh*, TPair<int32, int32>> FrameSlices;
+
+	uint32 BytesUploaded = 0;
+	uint32 BytesFromArena = 0;
+	uint32 MeshesPromoted = 0;
+
+	for (FRmlCommand& Base : Commands)
 	{
-		FRHICopyTextureInfo CopyInfo;
-		RHICmdList.CopyTexture(*RT, ResolveTarget, CopyInfo);
+		if (Base.bSkip || !Base.HasGeometry()) continue;
+		FRmlGeometryCommand& Cmd = static_cast<FRmlGeometryCommand&>(Base);
+		FRmlMesh* M = FrameMeshes[Cmd.Mesh];
+		if (!M || M->NumVertices == 0 || M->NumTriangles == 0) continue;
 
-		BeginLayerRenderPass(RHICmdList, 0, RTSize, ERenderTargetLoadAction::EClear, /*bClearStencil=*/ true);
+		if (bRetain)
+		{
+			if (M->LastDrawnFrame != FrameNumber)
+			{
+				M->LastDrawnFrame = FrameNumber;
+				++M->FramesDrawn;
+			}
 
-		TShaderMapRef<FRmlShaderPsPassthrough> BlitPs(ShaderMap);
+			if (!Arena.IsResident(M->ArenaAlloc) && M->FramesDrawn >= GeometryRetainFrames
+				&& M->ArenaFailedSerial != Arena.GetFreeSerial())
+			{
+				// Either never promoted, or the arena was recreated since (stale generation).
+				// A full arena is not rescanned every frame: the mesh waits until
+				// something has been freed before trying again.
+				M->ArenaAlloc = FRmlArenaAllocation();
+				if (Arena.Allocate(RHICmdList, *M, GeometryArenaBytes, M->ArenaAlloc))
+				{
+					M->ArenaFailedSerial = 0;
+					BytesUploaded += M->GetDataSize();
+					++MeshesPromoted;
+				}
+				else
+				{
+					M->ArenaFailedSerial = Arena.GetFreeSerial();
+				}
+			}
 
-		FGraphicsPipelineStateInitializer PSOBlit;
-		RHICmdList.ApplyCachedRenderTargets(PSOBlit);
-		PSOBlit.BoundShaderState.VertexDeclarationRHI = FRmlMesh::GetMeshDeclaration();
-		PSOBlit.BoundShaderState.VertexShaderRHI      = Vs.GetVertexShader();
-		PSOBlit.BoundShaderState.PixelShaderRHI       = BlitPs.GetPixelShader();
-		PSOBlit.PrimitiveType     = PT_TriangleList;
-		PSOBlit.BlendState        = TStaticBlendState<>::GetRHI();  // opaque overwrite
-		PSOBlit.RasterizerState   = TStaticRasterizerState<>::GetRHI();
-		PSOBlit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+			if (Arena.IsResident(M->ArenaAlloc))
+			{
+				Cmd.bArenaGeometry = true;
+				Cmd.BaseVertex = M->ArenaAlloc.VertexOffset;
+				Cmd.StartIndex = M->ArenaAlloc.IndexOffset;
+				BytesFromArena += M->GetDataSize();
+				continue;
+			}
+		}
 
-		SetGraphicsPipelineState(RHICmdList, PSOBlit, 0);
-		Vs->SetParameters(RHICmdList, FMatrix44f::Identity);
-		BlitPs->SetParameters(RHICmdList, BlitPs.GetPixelShader(), ResolveTarget, 1.0f);
-		RHICmdList.SetScissorRect(false, 0, 0, 0, 0);
-		DrawFullscreenQuad(RHICmdList);
+		Cmd.bArenaGeometry = false;
+		if (const TPair<int32, int32>* Slice = FrameSlices.Find(M))
+		{
+			Cmd.BaseVertex = Slice->Key;
+			Cmd.StartIndex = Slice->Value;
+			continue;
+		}
+
+		// Record the slice offsets in the command (pre-pass writes, execute loop reads)
+		Cmd.BaseVertex = AllVerts.Num();
+		Cmd.StartIndex = AllIdx.Num();
+		FrameSlices.Add(M, TPair<int32, int32>(Cmd.BaseVertex, Cmd.StartIndex));
+
+		// Append — no index rewriting; DrawIndexedPrimitive's baseVertexIndex handles the offset
+		AllVerts.Append(M->Vertices.GetData(), M->Vertices.Num());
+		AllIdx.Append(M->Indices.GetData(), M->Indices.Num());
+		BytesUploaded += M->GetDataSize();
+	}
+
+	INC_DWORD_STAT_BY(STAT_RmlUI_GeometryBytesUploaded, BytesUploaded);
+	INC_DWORD_STAT_BY(STAT_RmlUI_GeometryBytesFromArena, BytesFromArena);
+	INC_DWORD_STAT_BY(STAT_RmlUI_GeometryMeshesPromoted, MeshesPromoted);
+	SET_MEMORY_STAT(STAT_RmlUI_GeometryArenaUsed, Arena.GetUsedBytes());
+
+	if (AllVerts.Num() == 0)
+	{
+		FrameVB.SafeRelease();
+		FrameIB.SafeRelease();
+		return;
 	}
 
+	// Create ONE VB + IB for the entire frame. BUF_Volatile uses D3D12's upload-heap
+	// ring allocator — effectively free allocation, zero copy of data from CPU to GPU.
+	const int32 VBSize = sizeof(FRmlMesh::FVertexData) * AllVerts.Num();
+	FRHIResourceCreateInfo VInfo(TEXT("RmlFrameVB"), &AllVerts);
+	FrameVB = RHICreateVertexBuffer(VBSize, BUF_Volatile, VInfo);
+
+	const int32 IBSize = sizeof(uint16) * AllIdx.Num();
+	FRHIResourceCreateInfo IInfo(TEXT("RmlFrameIB"), &AllIdx);
+	FrameIB = RHICreateIndexBuffer(sizeof(uint16), IBSize, BUF_Volatile, IInfo);
+}
+
+// ============================================================================
+// Command execution
+// ============================================================================
+
+void FRmlDrawer::ExecuteCommands(FRHICommandListImmediate& RHICmdList, const FIntPoint& RTSize)
+{
+	auto ShaderMap = GetGlobalShaderMap(ERHIFeatureLevel::SM5);
+	TShaderMapRef<FRmlShaderVs>      Vs(ShaderMap);
+	TShaderMapRef<FRmlShaderPs>      Ps(ShaderMap);
+	TShaderMapRef<FRmlShaderPsNoTex> PsNoTex(ShaderMap);
+
+	auto* PremulBlend = TStaticBlendState<CW_RGBA,
+		BO_Add, BF_One, BF_InverseSourceAlpha,
+		BO_Add, BF_One, BF_InverseSourceAlpha>::GetRHI();
+
 	// Build initial PSOs
 	FGraphicsPipelineStateInitializer PSOTex, PSONoTex;
 	BuildDrawPSOs(RHICmdList, PSOTex, PSONoTex, Vs, Ps, PsNoTex, PremulBlend);
 
 	FRmlTextureEntry* CurTexture = nullptr;
 	bool bPSODirty = true;	// need to set initial PSO on first draw
+	bool bDrawPSOBound = false;
 
 	// --- Process command buffer ---
-	for (auto& Cmd : CommandList)
+	for (const FRmlCommand& Cmd : Commands)
 	{
+		if (Cmd.bSkip)
+			continue;
+
+		// Every other command binds its own PSO / shader parameters / scissor.
+		if (Cmd.Type != ERmlCommand::DrawMesh)
+			InvalidateBoundDrawState();
+
 		switch (Cmd.Type)
 		{
 		case ERmlCommand::DrawMesh:
 		{
+			const FRmlDrawMeshCommand& Draw = Cmd.As<FRmlDrawMeshCommand>();
 			if (bPSODirty)
 			{
 				BuildDrawPSOs(RHICmdList, PSOTex, PSONoTex, Vs, Ps, PsNoTex, PremulBlend);
 				CurTexture = nullptr;	// force re-bind
 				bPSODirty = false;
+				bDrawPSOBound = false;
 			}
 
-			FRmlTextureEntry* NewTex = Cmd.Texture.Get();
-			if (CurTexture == nullptr && NewTex == nullptr)
+			// First draw after a state change. Runs of untextured draws keep
+			// CurTexture == nullptr, so track the bound PSO separately rather than
+			// re-setting it (and re-binding transform/scissor) for every draw.
+			if (!bDrawPSOBound)
 			{
-				// First draw, no texture
-				SetGraphicsPipelineState(RHICmdList, PSONoTex, 0);
-			}
-			else if (CurTexture == nullptr && NewTex != nullptr)
-			{
-				SetGraphicsPipelineState(RHICmdList, PSOTex, 0);
+				SetGraphicsPipelineState(RHICmdList, GetTexture(Draw.Texture) ? PSOTex : PSONoTex, 0);
+				InvalidateBoundDrawState();
+				bDrawPSOBound = true;
 			}
 
-			ExecuteDrawMesh(RHICmdList, Cmd, Vs, Ps, PsNoTex, PSOTex, PSONoTex, CurTexture);
+			ExecuteDrawMesh(RHICmdList, Draw, Vs, Ps, PsNoTex, PSOTex, PSONoTex, CurTexture);
 			break;
 		}
 
 		case ERmlCommand::EnableClipMask:
-			ExecuteEnableClipMask(RHICmdList, Cmd);
+			ExecuteEnableClipMask(RHICmdList, Cmd.As<FRmlEnableClipMaskCommand>());
 			bPSODirty = true;
 			break;
 
 		case ERmlCommand::RenderToClipMask:
-			ExecuteRenderToClipMask(RHICmdList, Cmd, Vs, PsNoTex);
+			ExecuteRenderToClipMask(RHICmdList, Cmd.As<FRmlRenderToClipMaskCommand>(), Vs, PsNoTex);
 			bPSODirty = true;
 			break;
 
 		case ERmlCommand::PushLayer:
-			ExecutePushLayer(RHICmdList, Cmd, RTSize);
+			ExecutePushLayer(RHICmdList, Cmd.As<FRmlPushLayerCommand>(), RTSize);
 			bPSODirty = true;
 			CurTexture = nullptr;
 			break;
 
 		case ERmlCommand::CompositeLayers:
-			ExecuteCompositeLayers(RHICmdList, Cmd, Vs, Ps, RTSize);
+			ExecuteCompositeLayers(RHICmdList, Cmd.As<FRmlCompositeLayersCommand>(), Vs, Ps, RTSize);
 			bPSODirty = true;
 			CurTexture = nullptr;
 			break;
@@ -1612,24 +1925,151 @@ void FRmlDrawer::DrawRenderThread(FRHICommandListImmediate& RHICmdList, const vo
 			break;
 
 		case ERmlCommand::DrawShader:
-			ExecuteDrawShader(RHICmdList, Cmd, Vs, RTSize);
+			ExecuteDrawShader(RHICmdList, Cmd.As<FRmlDrawShaderCommand>(), Vs, RTSize);
 			bPSODirty = true;
 			CurTexture = nullptr;
 			break;
 
 		case ERmlCommand::SaveLayerAsTexture:
-			ExecuteSaveLayerAsTexture(RHICmdList, Cmd, RTSize);
+			ExecuteSaveLayerAsTexture(RHICmdList, Cmd.As<FRmlSaveLayerAsTextureCommand>(), RTSize);
 			bPSODirty = true;
 			CurTexture = nullptr;
 			break;
 
 		case ERmlCommand::SaveLayerAsMaskImage:
-			ExecuteSaveLayerAsMaskImage(RHICmdList, Cmd, RTSize);
+			ExecuteSaveLayerAsMaskImage(RHICmdList, Cmd.As<FRmlSaveLayerAsMaskImageCommand>(), RTSize);
 			bPSODirty = true;
 			CurTexture = nullptr;
 			break;
 		}
 	}
+}
+
+// ============================================================================
+// DrawRenderThread — main entry point
+// ============================================================================
+
+void FRmlDrawer::DrawRenderThread(FRHICommandListImmediate& RHICmdList, const void* RenderTarget)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RmlUI_DrawRenderThread);
+	check(IsInRenderingThread() || IsInParallelRenderingThread());
+
+	// A cached layer is composited even when nothing was recorded this frame.
+	if (Commands.Num() == 0 && !CachedLayer.IsValid())
+	{
+		ResetRecording();
+		MarkFree();
+		return;
+	}
+
+	const FTextureRHIRef* RT = (const FTextureRHIRef*)RenderTarget;
+	const FIntPoint RTSize((*RT)->GetSizeX(), (*RT)->GetSizeY());
+	const EPixelFormat RTFormat = (*RT)->GetFormat();
+
+	static bool bLoggedOnce = false;
+	if (!bLoggedOnce)
+	{
+		auto FmtToStr = [](EPixelFormat F) -> const TCHAR* {
+			switch (F)
+			{
+			case PF_B8G8R8A8:     return TEXT("B8G8R8A8");
+			case PF_R8G8B8A8:     return TEXT("R8G8B8A8");
+			case PF_FloatRGBA:    return TEXT("FloatRGBA");
+			case PF_A2B10G10R10:  return TEXT("A2B10G10R10");
+			default:              return TEXT("OTHER");
+			}
+		};
+		UE_LOG(LogUERmlUI, Log, TEXT("DrawRenderThread: SlateRT=%dx%d Format=%s InternalFormat=B8G8R8A8 MSAA=%d Samples=%d Cmds=%d"),
+			RTSize.X, RTSize.Y, FmtToStr(RTFormat), bUseMSAA ? 1 : 0, MSAASamples, Commands.Num());
+		bLoggedOnce = true;
+	}
+
+	EnsureRenderResources(RHICmdList, RTSize, RTFormat);
+
+	if (CachedLayer.IsValid())
+	{
+		DrawCachedLayer(RHICmdList, *RT, RTSize);
+		CachedLayer.Reset();
+		ResetRecording();
+		MarkFree();
+		return;
+	}
+
+	// Merge adjacent compatible draws before laying out geometry — merged batches
+	// are regular meshes from here on (uploaded, retained, drawn like any other).
+	if (bMergeDraws)
+		MergeDrawBatches();
+
+	// Pre-pass: accumulate all mesh geometry into one shared VB/IB for the frame.
+	// This replaces N×(RHICreateVertexBuffer + RHICreateIndexBuffer) with 1+1 per frame.
+	BuildFrameGeometry(RHICmdList);
+
+	// Most frames are plain textured and untextured quads: skip the copy-in, the
+	// blit-out and the MSAA resolve. sRGB targets would blend in a different space
+	// than layer 0 does, so they keep the layer path.
+	const bool bDirect = bAllowDirectRendering
+		&& !bNeedsLayerStack
+		&& (!bUseMSAA || !bNeedsMultisampling)
+		&& !EnumHasAnyFlags((*RT)->GetFlags(), ETextureCreateFlags::SRGB);
+	if (bDirect)
+	{
+		DrawDirect(RHICmdList, *RT, RTSize);
+		ResetRecording();
+		MarkFree();
+		return;
+	}
+
+	auto ShaderMap = GetGlobalShaderMap(ERHIFeatureLevel::SM5);
+	TShaderMapRef<FRmlShaderVs>      Vs(ShaderMap);
+
+	// Reset state
+	InvalidateBoundDrawState();
+	bClipMaskActive = false;
+	StencilRef = 0;
+	bInRenderPass = false;
+	LayerStack.Reset();
+	LayerStack.BeginFrame(RHICmdList);
+
+	// Resolve target — keeps Slate RT format so CopyTexture (format-matching) works in MSAA path.
+	// Only used as a temporary copy of the Slate RT background, not for layer compositing.
+	ResolveTarget = LayerStack.AcquireTarget(RHICmdList,
+		FRDGTextureDesc::Create2D(RTSize, RTFormat, FClearValueBinding::Transparent,
+			TexCreate_RenderTargetable | TexCreate_ShaderResource),
+		TEXT("RmlUI_Resolve"));
+
+	// --- BeginFrame: push base layer ---
+	int32 BaseLayerIndex = LayerStack.Push(RHICmdList);
+	check(BaseLayerIndex == 0);
+
+	// BeginFrame: copy Slate RT background into our internal layer 0 via shader blit.
+	// MSAA: populates all samples; Non-MSAA: handles format conversion (A2B10G10R10→B8G8R8A8).
+	// At EndFrame, we blit back (with MSAA resolve if needed).
+	{
+		FRHICopyTextureInfo CopyInfo;
+		RHICmdList.CopyTexture(*RT, ResolveTarget, CopyInfo);
+
+		BeginLayerRenderPass(RHICmdList, 0, RTSize, ERenderTargetLoadAction::EClear, /*bClearStencil=*/ true);
+
+		TShaderMapRef<FRmlShaderPsPassthrough> BlitPs(ShaderMap);
+
+		FGraphicsPipelineStateInitializer PSOBlit;
+		RHICmdList.ApplyCachedRenderTargets(PSOBlit);
+		PSOBlit.BoundShaderState.VertexDeclarationRHI = FRmlMesh::GetMeshDeclaration();
+		PSOBlit.BoundShaderState.VertexShaderRHI      = Vs.GetVertexShader();
+		PSOBlit.BoundShaderState.PixelShaderRHI       = BlitPs.GetPixelShader();
+		PSOBlit.PrimitiveType     = PT_TriangleList;
+		PSOBlit.BlendState        = TStaticBlendState<>::GetRHI();  // opaque overwrite
+		PSOBlit.RasterizerState   = TStaticRasterizerState<>::GetRHI();
+		PSOBlit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+
+		SetGraphicsPipelineState(RHICmdList, PSOBlit, 0);
+		Vs->SetParameters(RHICmdList, FMatrix44f::Identity);
+		BlitPs->SetParameters(RHICmdList, BlitPs.GetPixelShader(), ResolveTarget, 1.0f);
+		RHICmdList.SetScissorRect(false, 0, 0, 0, 0);
+		DrawFullscreenQuad(RHICmdList);
+	}
+
+	ExecuteCommands(RHICmdList, RTSize);
 
 	// --- EndFrame ---
 	EndCurrentRenderPass(RHICmdList);
@@ -1683,7 +2123,278 @@ void FRmlDrawer::DrawRenderThread(FRHICommandListImmediate& RHICmdList, const vo
 	// Cleanup
 	LayerStack.Pop();
 	check(LayerStack.GetActiveCount() == 0);
+	ResolveTarget.SafeRelease();
+	LayerStack.EndFrame();
 
-	CommandList.Reset();
+	ResetRecording();
 	MarkFree();
 }
+
+// ============================================================================
+// Direct path
+// ============================================================================
+
+void FRmlDrawer::DrawDirect(FRHICommandListImmediate& RHICmdList, const FTextureRHIRef& RT, const FIntPoint& RTSize)
+{
+	INC_DWORD_STAT(STAT_RmlUI_DirectFrames);
+
+	InvalidateBoundDrawState();
+	bClipMaskActive = false;
+	StencilRef = 0;
+
+	// No depth-stencil: the stream has no clip-mask commands. PSOs are built from
+	// the cached render targets, so they match the Slate target's format.
+	FRHIRenderPassInfo PassInfo(RT, ERenderTargetActions::Load_Store);
+	RHICmdList.BeginRenderPass(PassInfo, TEXT("RmlUI_Direct"));
+	RHICmdList.SetViewport(0, 0, 0.0f, (float)RTSize.X, (float)RTSize.Y, 1.0f);
+	bInRenderPass = true;
+
+	ExecuteCommands(RHICmdList, RTSize);
+
+	EndCurrentRenderPass(RHICmdList);
+}
+
+// ============================================================================
+// Cached layer
+// ============================================================================
+
+bool FRmlDrawer::CanRedrawPartially()
+{
+	for (const FRmlCommand& Cmd : Commands)
+	{
+		if (Cmd.bSkip)
+			continue;
+		if (Cmd.Type == ERmlCommand::SaveLayerAsTexture || Cmd.Type == ERmlCommand::SaveLayerAsMaskImage)
+			return false;
+		if (Cmd.Type == ERmlCommand::CompositeLayers && Cmd.As<FRmlCompositeLayersCommand>().NumFilters > 0)
+			return false;
+	}
+	return true;
+}
+
+void FRmlDrawer::DrawCachedLayer(FRHICommandListImmediate& RHICmdList, const FTextureRHIRef& RT, const FIntPoint& RTSize)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RmlUI_CachedLayer);
+	FRmlCachedLayer& Layer = *CachedLayer;
+	const FIntRect FullRect(FIntPoint::ZeroValue, RTSize);
+
+	FIntRect DirtyRect = CachedLayerDirtyRect;
+	if (!Layer.Texture.IsValid() || Layer.Texture->GetSizeXY() != RTSize)
+	{
+		FRHITextureCreateDesc Desc = FRHITextureCreateDesc::Create2D(TEXT("RmlUI_CachedLayer"), RTSize.X, RTSize.Y, PF_B8G8R8A8);
+		Desc.Flags = ETextureCreateFlags::RenderTargetable | ETextureCreateFlags::ShaderResource;
+		Desc.ClearValue = FClearValueBinding::Transparent;
+		Layer.Texture = RHICmdList.CreateTexture(Desc);
+		DirtyRect = FullRect;
+	}
+	DirtyRect.Clip(FullRect);
+
+	auto ShaderMap = GetGlobalShaderMap(ERHIFeatureLevel::SM5);
+	TShaderMapRef<FRmlShaderVs>            Vs(ShaderMap);
+	TShaderMapRef<FRmlShaderPsPassthrough> BlitPs(ShaderMap);
+
+	FGraphicsPipelineStateInitializer PSOBlit;
+	PSOBlit.BoundShaderState.VertexDeclarationRHI = FRmlMesh::GetMeshDeclaration();
+	PSOBlit.BoundShaderState.VertexShaderRHI      = Vs.GetVertexShader();
+	PSOBlit.BoundShaderState.PixelShaderRHI       = BlitPs.GetPixelShader();
+	PSOBlit.PrimitiveType     = PT_TriangleList;
+	PSOBlit.RasterizerState   = TStaticRasterizerState<>::GetRHI();
+	PSOBlit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+
+	if (DirtyRect.Area() > 0)
+	{
+		INC_DWORD_STAT_BY(STAT_RmlUI_CachedLayerPixelsRedrawn, DirtyRect.Area());
+
+		if (Commands.Num() > 0)
+		{
+			if (bMergeDraws)
+				MergeDrawBatches();
+			BuildFrameGeometry(RHICmdList);
+
+			if (DirtyRect != FullRect && !CanRedrawPartially())
+				DirtyRect = FullRect;
+
+			// Nothing outside the dirty rect may change: clamp every scissor to it.
+			// Layer 0 starts cleared, so clamped draws blend exactly as in a full redraw.
+			if (DirtyRect != FullRect)
+			{
+				for (FIntRect& Scissor : FrameScissors)
+					Scissor.Clip(DirtyRect);
+				for (FRmlCommand& Cmd : Commands)
+				{
+					if (Cmd.Type == ERmlCommand::CompositeLayers)
+						Cmd.As<FRmlCompositeLayersCommand>().ScissorRect.Clip(DirtyRect);
+				}
+			}
+
+			InvalidateBoundDrawState();
+			bClipMaskActive = false;
+			StencilRef = 0;
+			bInRenderPass = false;
+			LayerStack.Reset();
+			LayerStack.BeginFrame(RHICmdList);
+
+			const int32 BaseLayerIndex = LayerStack.Push(RHICmdList);
+			check(BaseLayerIndex == 0);
+			BeginLayerRenderPass(RHICmdList, 0, RTSize, ERenderTargetLoadAction::EClear, /*bClearStencil=*/ true);
+			ExecuteCommands(RHICmdList, RTSize);
+			EndCurrentRenderPass(RHICmdList);
+
+			FTextureRHIRef Source = LayerStack.GetColorRT(0);
+			if (bUseMSAA)
+			{
+				FRHIRenderPassInfo ResolvePassInfo;
+				ResolvePassInfo.ColorRenderTargets[0].RenderTarget = Source;
+				ResolvePassInfo.ColorRenderTargets[0].ResolveTarget = LayerStack.PostprocessA;
+				ResolvePassInfo.ColorRenderTargets[0].Action = MakeRenderTargetActions(ERenderTargetLoadAction::ELoad, ERenderTargetStoreAction::EMultisampleResolve);
+				ResolvePassInfo.ResolveRect = FResolveRect(DirtyRect.Min.X, DirtyRect.Min.Y, DirtyRect.Max.X, DirtyRect.Max.Y);
+				RHICmdList.BeginRenderPass(ResolvePassInfo, TEXT("RmlUI_CachedLayerResolve"));
+				RHICmdList.EndRenderPass();
+				Source = LayerStack.PostprocessA;
+			}
+
+			// Both are 1x B8G8R8A8, so the dirty part is a plain copy.
+			FRHICopyTextureInfo CopyInfo;
+			CopyInfo.Size = FIntVector(DirtyRect.Width(), DirtyRect.Height(), 1);
+			CopyInfo.SourcePosition = FIntVector(DirtyRect.Min.X, DirtyRect.Min.Y, 0);
+			CopyInfo.DestPosition = CopyInfo.SourcePosition;
+			RHICmdList.CopyTexture(Source, Layer.Texture, CopyInfo);
+
+			LayerStack.Pop();
+			check(LayerStack.GetActiveCount() == 0);
+			LayerStack.EndFrame();
+		}
+		else
+		{
+			// Everything in the dirty rect went away (e.g. the last document was hidden):
+			// overwrite it with transparent black.
+			FRHIRenderPassInfo ClearPassInfo(Layer.Texture, ERenderTargetActions::Load_Store);
+			RHICmdList.BeginRenderPass(ClearPassInfo, TEXT("RmlUI_CachedLayerClear"));
+			RHICmdList.SetViewport(0, 0, 0.0f, (float)RTSize.X, (float)RTSize.Y, 1.0f);
+			RHICmdList.ApplyCachedRenderTargets(PSOBlit);
+			PSOBlit.BlendState = TStaticBlendState<>::GetRHI();
+			SetGraphicsPipelineState(RHICmdList, PSOBlit, 0);
+			Vs->SetParameters(RHICmdList, FMatrix44f::Identity);
+			BlitPs->SetParameters(RHICmdList, BlitPs.GetPixelShader(), GBlackTexture->TextureRHI, 0.0f);
+			RHICmdList.SetScissorRect(true, DirtyRect.Min.X, DirtyRect.Min.Y, DirtyRect.Max.X, DirtyRect.Max.Y);
+			DrawFullscreenQuad(RHICmdList);
+			RHICmdList.EndRenderPass();
+		}
+	}
+
+	// Composite: one premultiplied quad over the Slate target, limited to the UI's bounds.
+	FIntRect ContentRect = CachedLayerContentRect;
+	ContentRect.Clip(FullRect);
+	if (ContentRect.Area() > 0)
+	{
+		FRHIRenderPassInfo CompositePassInfo(RT, ERenderTargetActions::Load_Store);
+		RHICmdList.BeginRenderPass(CompositePassInfo, TEXT("RmlUI_CachedLayerComposite"));
+		RHICmdList.SetViewport(0, 0, 0.0f, (float)RTSize.X, (float)RTSize.Y, 1.0f);
+		RHICmdList.ApplyCachedRenderTargets(PSOBlit);
+		PSOBlit.BlendState = TStaticBlendState<CW_RGBA,
+			BO_Add, BF_One, BF_InverseSourceAlpha,
+			BO_Add, BF_One, BF_InverseSourceAlpha>::GetRHI();
+		SetGraphicsPipelineState(RHICmdList, PSOBlit, 0);
+		Vs->SetParameters(RHICmdList, FMatrix44f::Identity);
+		BlitPs->SetParameters(RHICmdList, BlitPs.GetPixelShader(), Layer.Texture, 1.0f);
+		RHICmdList.SetScissorRect(true, ContentRect.Min.X, ContentRect.Min.Y, ContentRect.Max.X, ContentRect.Max.Y);
+		DrawFullscreenQuad(RHICmdList);
+		RHICmdList.EndRenderPass();
+	}
+}
+
+void FRmlDrawer::ResetRecording()
+{
+	bNeedsLayerStack = false;
+	bNeedsMultisampling = false;
+	Commands.Reset();
+	FrameMeshes.Reset();
+	FrameBatches.Reset();
+	FrameTextures.Reset();
+	FrameTransforms.Reset();
+	FrameScissors.Reset();
+	FrameFilters.Reset();
+	FrameShaders.Reset();
+	TransformLookup.Reset();
+	ScissorLookup.Reset();
+}
+
+int32 FRmlDrawer::InternTransform(const FMatrix44f& Transform)
+{
+	// Rotation, skew or perspective turn axis-aligned edges into diagonal ones.
+	if (Transform.M[0][1] != 0.0f || Transform.M[1][0] != 0.0f || Transform.M[0][3] != 0.0f || Transform.M[1][3] != 0.0f)
+		bNeedsMultisampling = true;
+
+	const uint32 Hash = FCrc::MemCrc32(&Transform, sizeof(FMatrix44f));
+	if (const int32* Found = TransformLookup.Find(Hash))
+	{
+		if (FMemory::Memcmp(&FrameTransforms[*Found], &Transform, sizeof(FMatrix44f)) == 0)
+			return *Found;
+	}
+	// New state (or a CRC collision, which just costs a duplicate entry).
+	const int32 Index = FrameTransforms.Add(Transform);
+	TransformLookup.Add(Hash, Index);
+	return Index;
+}
+
+int32 FRmlDrawer::InternScissor(const FIntRect& Rect)
+{
+	if (const int32* Found = ScissorLookup.Find(Rect))
+		return *Found;
+	const int32 Index = FrameScissors.Add(Rect);
+	ScissorLookup.Add(Rect, Index);
+	return Index;
+}
+
+// ============================================================================
+// Recording benchmark
+// ============================================================================
+
+#if !UE_BUILD_SHIPPING
+// Measures game-thread recording cost only: N EmplaceMesh calls into a scratch
+// drawer, repeated so the stream and tables reach steady-state capacity.
+// Draws cycle through NumTextures transient 1x1 textures, switching every other
+// draw, so both the texture-table append and the repeat-texture dedup are hit.
+// Usage: rmlui.BenchRecord [NumDraws=10000] [Iterations=50] [NumTextures=4]
+static FAutoConsoleCommand GRmlBenchRecordCmd(
+	TEXT("rmlui.BenchRecord"),
+	TEXT("Time recording N DrawMesh commands into an FRmlDrawer. Args: [NumDraws=10000] [Iterations=50] [NumTextures=4]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 NumDraws    = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+		const int32 Iterations  = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 50;
+		const int32 NumTextures = Args.Num() > 2 ? FMath::Max(1, FCString::Atoi(*Args[2])) : 4;
+
+		FRmlDrawer Drawer(true);
+		FRmlMesh Mesh;
+		TArray<TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>> Textures;
+		for (int32 i = 0; i < NumTextures; ++i)
+			Textures.Add(MakeShared<FRmlTextureEntry, ESPMode::ThreadSafe>(UTexture2D::CreateTransient(1, 1, PF_R8G8B8A8)));
+
+		double BestSeconds = TNumericLimits<double>::Max();
+		double TotalSeconds = 0.0;
+		for (int32 Iter = 0; Iter < Iterations; ++Iter)
+		{
+			Drawer.ResetRecording();
+			const double Start = FPlatformTime::Seconds();
+			// State is interned once, as the render interface does on SetTransform / SetScissorRegion.
+			const int32 Transform = Drawer.InternTransform(FMatrix44f::Identity);
+			const int32 Scissor = Drawer.InternScissor(FIntRect(0, 0, 1920, 1080));
+			for (int32 i = 0; i < NumDraws; ++i)
+			{
+				// Grid-like layout: every draw has its own translation, as in RmlUi.
+				const FVector2f Translation((float)(i % 100) * 16.0f, (float)(i / 100) * 16.0f);
+				Drawer.EmplaceMesh(&Mesh, Textures[(i >> 1) % NumTextures].Get(), Transform, Translation, Scissor);
+			}
+			const double Elapsed = FPlatformTime::Seconds() - Start;
+			BestSeconds = FMath::Min(BestSeconds, Elapsed);
+			TotalSeconds += Elapsed;
+		}
+
+		UE_LOG(LogUERmlUI, Display, TEXT("BenchRecord: %d draws x %d iterations, %d textures — best %.3f ms (%.1f ns/draw), mean %.3f ms, %d commands"),
+			NumDraws, Iterations, NumTextures,
+			BestSeconds * 1000.0, BestSeconds * 1e9 / NumDraws,
+			TotalSeconds * 1000.0 / Iterations, Drawer.GetNumCommands());
+		Drawer.ResetRecording();
+	}));
+#endif
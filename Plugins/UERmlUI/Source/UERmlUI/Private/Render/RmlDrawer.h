@@ -1,29 +1,15 @@
 #pragma once
 
 #include "RmlShader.h"
+#include "RendererInterface.h"
+#include "RenderGraphResources.h"
 #include "RmlUi/Core/RenderInterface.h"
 
+namespace Rml { class ElementDocument; }
 class FRmlMesh;
 class FRmlTextureEntry;
 using FRmlTextureEntryPtr = TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>;
 
-// ============================================================================
-// Command buffer types
-// ============================================================================
-
-enum class ERmlCommand : uint8
-{
-	DrawMesh,
-	EnableClipMask,
-	RenderToClipMask,
-	PushLayer,
-	CompositeLayers,
-	PopLayer,
-	DrawShader,
-	SaveLayerAsTexture,
-	SaveLayerAsMaskImage,
-};
-
 // ============================================================================
 // Compiled filter/shader data
 // ============================================================================
@@ -49,6 +35,19 @@ struct FCompiledRmlFilter
 	FTextureRHIRef MaskTexture;
 };
 
+// One pass of a filter chain as ApplyFilters runs it. Blur and drop-shadow are
+// kept as they are. Runs of opacity, color-matrix and mask-image filters are fused:
+// each is linear in premultiplied color and leaves the color matrix's alpha column
+// alone, so any sequence of them is one matrix times one (per-pixel) scalar.
+struct FRmlFilterStep
+{
+	const FCompiledRmlFilter* Filter = nullptr;	// Blur or DropShadow; null for a fused step
+
+	FMatrix44f		ColorMatrix = FMatrix44f::Identity;
+	float			Opacity = 1.0f;
+	FTextureRHIRef	MaskTexture;				// at most one mask per fused step
+};
+
 enum class ERmlShaderType : uint8
 {
 	Invalid,
@@ -76,161 +75,238 @@ struct FCompiledRmlShader
 	TArray<FLinearColor> StopColors;
 };
 
-struct FRmlDrawCommand
+// ============================================================================
+// Command stream
+// ============================================================================
+//
+// Commands are recorded on the game thread into a linear byte arena as packed,
+// trivially-copyable records of varying size. Records own nothing: meshes,
+// textures and transforms are indices into the drawer's per-frame tables, and
+// the objects behind them are kept alive by FUERmlRenderResources' frame fence
+// (deferred releases) until the render thread has finished with the frame.
+// Recording a draw is a bump allocation plus a few stores — no refcount traffic
+// and, once the arena has grown to its steady-state size, no heap allocation.
+
+enum class ERmlCommand : uint8
+{
+	DrawMesh,
+	EnableClipMask,
+	RenderToClipMask,
+	PushLayer,
+	CompositeLayers,
+	PopLayer,
+	DrawShader,
+	SaveLayerAsTexture,
+	SaveLayerAsMaskImage,
+};
+
+// Common record header. Size is the full record size, so the stream can be
+// walked without knowing every record type.
+struct FRmlCommand
 {
-	ERmlCommand Type;
+	ERmlCommand	Type;
+	bool		bSkip = false;		// set by render-thread passes (e.g. merged into a previous draw)
+	uint16		Size = 0;
 
-	// DrawMesh / RenderToClipMask / DrawShader
-	TSharedPtr<FRmlMesh, ESPMode::ThreadSafe> Mesh;
-	FRmlTextureEntryPtr Texture;
-	FMatrix44f Transform;
-	FIntRect ScissorRect;
+	bool HasGeometry() const
+	{
+		return Type == ERmlCommand::DrawMesh || Type == ERmlCommand::RenderToClipMask || Type == ERmlCommand::DrawShader;
+	}
+
+	template<typename T> T& As()
+	{
+		check(T::StaticType == Type);
+		return static_cast<T&>(*this);
+	}
+	template<typename T> const T& As() const
+	{
+		check(T::StaticType == Type);
+		return static_cast<const T&>(*this);
+	}
+};
+
+// Shared part of every command that draws a mesh (DrawMesh / RenderToClipMask / DrawShader).
+struct FRmlGeometryCommand : FRmlCommand
+{
+	int32		Mesh = INDEX_NONE;		// FrameMeshes
+	int32		Transform = INDEX_NONE;	// FrameTransforms — interned state, without the per-draw translation
+	int32		Scissor = INDEX_NONE;	// FrameScissors — interned state
+	// RmlUi's per-draw translation, applied on top of Transform on the render thread.
+	// Draws sharing Transform differ at most by this, which the merge pass relies on.
+	FVector2f	Translation = FVector2f::ZeroVector;
 
 	// Filled by DrawRenderThread pre-pass: offsets into the frame-level shared VB/IB.
 	// BaseVertex is added to each index by the GPU; StartIndex is the first index to read.
-	int32 BaseVertex = 0;
-	int32 StartIndex = 0;
+	int32		BaseVertex = 0;
+	int32		StartIndex = 0;
+	// True when BaseVertex/StartIndex index into FRmlGeometryArena instead of FrameVB/FrameIB.
+	bool		bArenaGeometry = false;
+};
+
+struct FRmlDrawMeshCommand : FRmlGeometryCommand
+{
+	static constexpr ERmlCommand StaticType = ERmlCommand::DrawMesh;
+
+	int32		Texture = INDEX_NONE;	// FrameTextures, INDEX_NONE = untextured
+};
+
+struct FRmlRenderToClipMaskCommand : FRmlGeometryCommand
+{
+	static constexpr ERmlCommand StaticType = ERmlCommand::RenderToClipMask;
 
-	// RenderToClipMask
 	Rml::ClipMaskOperation ClipOp = Rml::ClipMaskOperation::Set;
+};
 
-	// EnableClipMask
-	bool bClipMaskEnable = false;
+struct FRmlDrawShaderCommand : FRmlGeometryCommand
+{
+	static constexpr ERmlCommand StaticType = ERmlCommand::DrawShader;
 
-	// PushLayer / CompositeLayers / PopLayer
-	int32 SourceLayer = -1;
-	int32 DestLayer = -1;
-	Rml::BlendMode BlendMode = Rml::BlendMode::Blend;
-	TArray<TSharedPtr<FCompiledRmlFilter>> Filters;		// resolved at recording time
+	int32		Shader = INDEX_NONE;	// FrameShaders
+	int32		Texture = INDEX_NONE;
+};
 
-	// DrawShader
-	Rml::CompiledShaderHandle ShaderHandle = 0;
+struct FRmlEnableClipMaskCommand : FRmlCommand
+{
+	static constexpr ERmlCommand StaticType = ERmlCommand::EnableClipMask;
 
-	// SaveLayerAsTexture / SaveLayerAsMaskImage
-	FRmlTextureEntryPtr SavedTextureTarget;				// render thread sets OverrideRHI
-	FCompiledRmlFilter* SavedMaskTarget = nullptr;		// render thread sets MaskTexture
-	FIntPoint SaveTextureIdealSize = FIntPoint::ZeroValue;	// exact physical size matching GPU rasterizer
+	bool		bEnable = false;
+};
 
-	// Factory methods
-	static FRmlDrawCommand MakeDrawMesh(
-		TSharedPtr<FRmlMesh, ESPMode::ThreadSafe> InMesh,
-		FRmlTextureEntryPtr InTexture,
-		const FMatrix44f& InTransform,
-		const FIntRect& InScissorRect)
-	{
-		FRmlDrawCommand Cmd;
-		Cmd.Type = ERmlCommand::DrawMesh;
-		Cmd.Mesh = MoveTemp(InMesh);
-		Cmd.Texture = MoveTemp(InTexture);
-		Cmd.Transform = InTransform;
-		Cmd.ScissorRect = InScissorRect;
-		return Cmd;
-	}
+struct FRmlPushLayerCommand : FRmlCommand
+{
+	static constexpr ERmlCommand StaticType = ERmlCommand::PushLayer;
 
-	static FRmlDrawCommand MakeEnableClipMask(bool bEnable)
-	{
-		FRmlDrawCommand Cmd;
-		Cmd.Type = ERmlCommand::EnableClipMask;
-		Cmd.bClipMaskEnable = bEnable;
-		return Cmd;
-	}
+	int32		DestLayer = -1;
+};
 
-	static FRmlDrawCommand MakeRenderToClipMask(
-		Rml::ClipMaskOperation Op,
-		TSharedPtr<FRmlMesh, ESPMode::ThreadSafe> InMesh,
-		const FMatrix44f& InTransform,
-		const FIntRect& InScissorRect)
-	{
-		FRmlDrawCommand Cmd;
-		Cmd.Type = ERmlCommand::RenderToClipMask;
-		Cmd.ClipOp = Op;
-		Cmd.Mesh = MoveTemp(InMesh);
-		Cmd.Transform = InTransform;
-		Cmd.ScissorRect = InScissorRect;
-		return Cmd;
-	}
+struct FRmlCompositeLayersCommand : FRmlCommand
+{
+	static constexpr ERmlCommand StaticType = ERmlCommand::CompositeLayers;
 
-	static FRmlDrawCommand MakePushLayer(int32 LayerIndex)
-	{
-		FRmlDrawCommand Cmd;
-		Cmd.Type = ERmlCommand::PushLayer;
-		Cmd.DestLayer = LayerIndex;
-		return Cmd;
-	}
+	int32		SourceLayer = -1;
+	int32		DestLayer = -1;
+	Rml::BlendMode BlendMode = Rml::BlendMode::Blend;
+	FIntRect	ScissorRect;
+	int32		FirstFilter = 0;		// range in FrameFilters, resolved at recording time
+	int32		NumFilters = 0;
+};
 
-	static FRmlDrawCommand MakeCompositeLayers(
-		int32 Src, int32 Dst,
-		Rml::BlendMode Mode,
-		TArray<TSharedPtr<FCompiledRmlFilter>>&& InFilters,
-		const FIntRect& InScissorRect)
-	{
-		FRmlDrawCommand Cmd;
-		Cmd.Type = ERmlCommand::CompositeLayers;
-		Cmd.SourceLayer = Src;
-		Cmd.DestLayer = Dst;
-		Cmd.BlendMode = Mode;
-		Cmd.Filters = MoveTemp(InFilters);
-		Cmd.ScissorRect = InScissorRect;
-		return Cmd;
-	}
+struct FRmlPopLayerCommand : FRmlCommand
+{
+	static constexpr ERmlCommand StaticType = ERmlCommand::PopLayer;
+};
 
-	static FRmlDrawCommand MakePopLayer()
-	{
-		FRmlDrawCommand Cmd;
-		Cmd.Type = ERmlCommand::PopLayer;
-		return Cmd;
-	}
+struct FRmlSaveLayerAsTextureCommand : FRmlCommand
+{
+	static constexpr ERmlCommand StaticType = ERmlCommand::SaveLayerAsTexture;
 
-	static FRmlDrawCommand MakeDrawShader(
-		Rml::CompiledShaderHandle InShader,
-		TSharedPtr<FRmlMesh, ESPMode::ThreadSafe> InMesh,
-		FRmlTextureEntryPtr InTexture,
-		const FMatrix44f& InTransform,
-		const FIntRect& InScissorRect)
-	{
-		FRmlDrawCommand Cmd;
-		Cmd.Type = ERmlCommand::DrawShader;
-		Cmd.ShaderHandle = InShader;
-		Cmd.Mesh = MoveTemp(InMesh);
-		Cmd.Texture = MoveTemp(InTexture);
-		Cmd.Transform = InTransform;
-		Cmd.ScissorRect = InScissorRect;
-		return Cmd;
-	}
+	int32		Target = INDEX_NONE;			// FrameTextures — render thread sets OverrideRHI
+	FIntRect	ScissorRect;
+	FIntPoint	IdealSize = FIntPoint::ZeroValue;	// exact physical size matching GPU rasterizer
+};
+
+struct FRmlSaveLayerAsMaskImageCommand : FRmlCommand
+{
+	static constexpr ERmlCommand StaticType = ERmlCommand::SaveLayerAsMaskImage;
+
+	FCompiledRmlFilter* Target = nullptr;		// render thread sets MaskTexture
+	FIntRect	ScissorRect;
+};
 
-	static FRmlDrawCommand MakeSaveLayerAsTexture(FRmlTextureEntryPtr Target, const FIntRect& InScissorRect, const FIntPoint& InIdealSize)
+class FRmlCommandStream
+{
+public:
+	template<typename T>
+	T& Emplace()
 	{
-		FRmlDrawCommand Cmd;
-		Cmd.Type = ERmlCommand::SaveLayerAsTexture;
-		Cmd.SavedTextureTarget = MoveTemp(Target);
-		Cmd.ScissorRect = InScissorRect;
-		Cmd.SaveTextureIdealSize = InIdealSize;
-		return Cmd;
+		static_assert(std::is_trivially_destructible_v<T>, "Command records are never destructed");
+		constexpr int32 RecordSize = (int32)Align(sizeof(T), RecordAlignment);
+		static_assert(RecordSize <= MAX_uint16, "Command record too large");
+
+		const int32 Offset = Data.AddUninitialized(RecordSize);
+		T* Cmd = new (Data.GetData() + Offset) T();
+		Cmd->Type = T::StaticType;
+		Cmd->Size = (uint16)RecordSize;
+		++NumCommands;
+		return *Cmd;
 	}
 
-	static FRmlDrawCommand MakeSaveLayerAsMaskImage(FCompiledRmlFilter* Target, const FIntRect& InScissorRect)
+	// Keeps the allocation — steady-state recording never touches the allocator.
+	void Reset() { Data.Reset(); NumCommands = 0; }
+	int32 Num() const { return NumCommands; }
+	int32 GetAllocatedBytes() const { return Data.GetAllocatedSize(); }
+
+	struct FIterator
 	{
-		FRmlDrawCommand Cmd;
-		Cmd.Type = ERmlCommand::SaveLayerAsMaskImage;
-		Cmd.SavedMaskTarget = Target;
-		Cmd.ScissorRect = InScissorRect;
-		return Cmd;
-	}
+		uint8* Ptr;
+		FRmlCommand& operator*() const { return *reinterpret_cast<FRmlCommand*>(Ptr); }
+		FIterator& operator++() { Ptr += reinterpret_cast<FRmlCommand*>(Ptr)->Size; return *this; }
+		bool operator!=(const FIterator& Other) const { return Ptr != Other.Ptr; }
+	};
+	FIterator begin() { return { Data.GetData() }; }
+	FIterator end()   { return { Data.GetData() + Data.Num() }; }
+
+private:
+	static constexpr uint32 RecordAlignment = 8;
+	TArray<uint8, TAlignedHeapAllocator<16>>	Data;
+	int32										NumCommands = 0;
 };
 
 // ============================================================================
 // Layer stack — manages per-layer render targets
 // ============================================================================
+//
+// Layers, the depth/stencil buffer and the postprocess targets are only alive for
+// the frame that uses them: BeginFrame/Push take them from the engine's render
+// target pool (GRenderTargetPool) and EndFrame hands them back, so every drawer
+// and widget draws out of one shared set instead of each keeping its own. The pool
+// matches on exact size and format; a resize just stops asking for the old size and
+// the pool ages those targets out.
 
 struct FRmlLayer
 {
 	FTextureRHIRef ColorRT;		// MSAA or 1x
 };
 
+// Element-sized targets for one CompositeLayers filter chain. Texel (0,0) maps to
+// Origin on the layer; the padded element covers [0, Size) and the rest of the
+// Extent-sized textures stays transparent. Extent is Size rounded up to a coarse
+// granularity so elements that resize or animate keep hitting the same pool entries.
+struct FRmlFilterRegion
+{
+	FIntPoint		Origin = FIntPoint::ZeroValue;
+	FIntPoint		Size = FIntPoint::ZeroValue;
+	FIntPoint		Extent = FIntPoint::ZeroValue;
+
+	FTextureRHIRef	A;			// 8-bit ping-pong pair
+	FTextureRHIRef	B;
+	FTextureRHIRef	BlurSrc;	// FP16 pair for RenderBlur, acquired on first blur
+	FTextureRHIRef	BlurTemp;
+
+	TArray<TRefCountPtr<IPooledRenderTarget>, TInlineAllocator<4>> Pooled;
+
+	FIntRect GetLocalRect() const { return FIntRect(FIntPoint::ZeroValue, Size); }
+};
+
 class FRmlLayerStack
 {
 public:
-	void EnsureResources(FRHICommandListImmediate& RHICmdList, const FIntPoint& Size, EPixelFormat Format, int32 NumSamples);
+	// Record the size/format/sample count the next frames are drawn at. Allocates nothing.
+	void EnsureResources(const FIntPoint& Size, EPixelFormat Format, int32 NumSamples);
+
+	// Acquire depth/stencil and PostprocessA from the pool for one layer-path frame.
+	void BeginFrame(FRHICommandListImmediate& RHICmdList);
+	// Return everything acquired since BeginFrame to the pool.
+	void EndFrame();
+	// Any other transient target for this frame, released by EndFrame.
+	FTextureRHIRef AcquireTarget(FRHICommandListImmediate& RHICmdList, const FRDGTextureDesc& Desc, const TCHAR* Name);
+
+	// Filter chain targets for the padded element rect, clipped to the layer. Returned
+	// to the pool by EndFilterRegion as soon as the composite is done.
+	void BeginFilterRegion(FRHICommandListImmediate& RHICmdList, const FIntRect& Rect, FRmlFilterRegion& OutRegion);
+	void EnsureBlurTargets(FRHICommandListImmediate& RHICmdList, FRmlFilterRegion& Region);
+	void EndFilterRegion(FRmlFilterRegion& Region);
+
 	void Reset();
 
 	// Push a new layer, returning its index
@@ -244,15 +320,13 @@ public:
 	int32 GetTopIndex() const { return ActiveCount - 1; }
 	int32 GetActiveCount() const { return ActiveCount; }
 
-	// Shared resources
+	// Shared resources (pooled, valid between BeginFrame and EndFrame)
 	FTextureRHIRef SharedDepthStencil;
 
-	// Postprocess buffers (1x, shader-readable)
+	// Postprocess buffer (1x, shader-readable): MSAA resolves for SaveLayer* and the final blit.
+	// Filters run in element-sized targets instead, see FRmlFilterRegion.
 	FTextureRHIRef PostprocessA;
-	FTextureRHIRef PostprocessB;
-	FTextureRHIRef PostprocessTemp;		// blur temp (FP16)
-	FTextureRHIRef PostprocessBlurSrc;	// blur SourceDest (FP16) — paired with PostprocessTemp for all-FP16 blur chain
-	FTextureRHIRef BlendMaskRT;			// SaveLayerAsMaskImage
+	FTextureRHIRef BlendMaskRT;			// SaveLayerAsMaskImage — not pooled, compiled filters keep referencing it
 
 private:
 	TArray<FRmlLayer> Layers;
@@ -261,9 +335,43 @@ private:
 	FIntPoint CachedSize = FIntPoint::ZeroValue;
 	EPixelFormat CachedFormat = PF_Unknown;
 
+	// Pool elements held this frame; dropping the refs is what returns them.
+	TArray<TRefCountPtr<IPooledRenderTarget>> FrameTargets;
+
+	TRefCountPtr<IPooledRenderTarget> AcquirePooled(FRHICommandListImmediate& RHICmdList, const FRDGTextureDesc& Desc, const TCHAR* Name);
+	void ReleasePooled(TRefCountPtr<IPooledRenderTarget>& Target);
+
 	void AllocLayer(FRHICommandListImmediate& RHICmdList, int32 Index);
 };
 
+// ============================================================================
+// Cached widget layer — SRmlWidget's partial-redraw mode
+// ============================================================================
+//
+// The UI of one widget, rendered over transparent black and kept across frames.
+// The game thread works out which part of it changed (see FUERmlRenderInterface::
+// EndRender); the drawer re-renders only that rectangle into the texture and
+// composites the texture onto the Slate target with a single premultiplied quad.
+// A frame where nothing changed costs that one quad and nothing else.
+
+struct FRmlCachedLayer
+{
+	// Game thread: what was composited last frame, to diff the next one against.
+	struct FDocumentBounds
+	{
+		const Rml::ElementDocument*	Document = nullptr;
+		FIntRect					Bounds;		// physical pixels
+	};
+	TArray<FDocumentBounds>	Documents;
+	FMatrix44f				RenderMatrix = FMatrix44f::Identity;
+	FSlateRect				ViewportRect;
+	uint32					ContentSerial = 0;
+	bool					bInvalidated = true;	// redraw everything next frame
+
+	// Render thread
+	FTextureRHIRef			Texture;				// 1x B8G8R8A8, premultiplied
+};
+
 // ============================================================================
 // Main drawer — Slate custom element
 // ============================================================================
@@ -277,33 +385,50 @@ public:
 	virtual void DrawRenderThread(FRHICommandListImmediate& RHICmdList, const void* RenderTarget) override;
 	// ~End ICustomSlateElement API
 
-	// Game-thread command recording
+	// Game-thread command recording. Pointers are not retained beyond the frame —
+	// the caller keeps them alive until the drawer is free again.
+	// Transform / Scissor are indices returned by InternTransform / InternScissor.
 	FORCEINLINE void EmplaceMesh(
-		TSharedPtr<FRmlMesh, ESPMode::ThreadSafe> InMesh,
-		FRmlTextureEntryPtr InTexture,
-		const FMatrix44f& InTransform,
-		const FIntRect& InScissorRect)
+		FRmlMesh* InMesh,
+		FRmlTextureEntry* InTexture,
+		int32 InTransform,
+		const FVector2f& InTranslation,
+		int32 InScissor)
 	{
-		CommandList.Add(FRmlDrawCommand::MakeDrawMesh(MoveTemp(InMesh), MoveTemp(InTexture), InTransform, InScissorRect));
+		FRmlDrawMeshCommand& Cmd = Commands.Emplace<FRmlDrawMeshCommand>();
+		Cmd.Mesh = FrameMeshes.Add(InMesh);
+		Cmd.Texture = AddTexture(InTexture);
+		Cmd.Transform = InTransform;
+		Cmd.Translation = InTranslation;
+		Cmd.Scissor = InScissor;
 	}
 
 	void EmplaceEnableClipMask(bool bEnable)
 	{
-		CommandList.Add(FRmlDrawCommand::MakeEnableClipMask(bEnable));
+		Commands.Emplace<FRmlEnableClipMaskCommand>().bEnable = bEnable;
+		bNeedsLayerStack |= bEnable;
 	}
 
 	void EmplaceRenderToClipMask(
 		Rml::ClipMaskOperation Op,
-		TSharedPtr<FRmlMesh, ESPMode::ThreadSafe> InMesh,
-		const FMatrix44f& InTransform,
-		const FIntRect& InScissorRect)
+		FRmlMesh* InMesh,
+		int32 InTransform,
+		const FVector2f& InTranslation,
+		int32 InScissor)
 	{
-		CommandList.Add(FRmlDrawCommand::MakeRenderToClipMask(Op, MoveTemp(InMesh), InTransform, InScissorRect));
+		FRmlRenderToClipMaskCommand& Cmd = Commands.Emplace<FRmlRenderToClipMaskCommand>();
+		bNeedsLayerStack = true;
+		Cmd.ClipOp = Op;
+		Cmd.Mesh = FrameMeshes.Add(InMesh);
+		Cmd.Transform = InTransform;
+		Cmd.Translation = InTranslation;
+		Cmd.Scissor = InScissor;
 	}
 
 	void EmplacePushLayer(int32 LayerIndex)
 	{
-		CommandList.Add(FRmlDrawCommand::MakePushLayer(LayerIndex));
+		Commands.Emplace<FRmlPushLayerCommand>().DestLayer = LayerIndex;
+		bNeedsLayerStack = true;
 	}
 
 	void EmplaceCompositeLayers(
@@ -312,54 +437,155 @@ public:
 		TArray<TSharedPtr<FCompiledRmlFilter>>&& Filters,
 		const FIntRect& InScissorRect)
 	{
-		CommandList.Add(FRmlDrawCommand::MakeCompositeLayers(Src, Dst, Mode, MoveTemp(Filters), InScissorRect));
+		FRmlCompositeLayersCommand& Cmd = Commands.Emplace<FRmlCompositeLayersCommand>();
+		bNeedsLayerStack = true;
+		Cmd.SourceLayer = Src;
+		Cmd.DestLayer = Dst;
+		Cmd.BlendMode = Mode;
+		Cmd.ScissorRect = InScissorRect;
+		Cmd.FirstFilter = FrameFilters.Num();
+		Cmd.NumFilters = Filters.Num();
+		FrameFilters.Append(MoveTemp(Filters));
 	}
 
 	void EmplacePopLayer()
 	{
-		CommandList.Add(FRmlDrawCommand::MakePopLayer());
+		Commands.Emplace<FRmlPopLayerCommand>();
+		bNeedsLayerStack = true;
 	}
 
 	void EmplaceDrawShader(
-		Rml::CompiledShaderHandle InShader,
-		TSharedPtr<FRmlMesh, ESPMode::ThreadSafe> InMesh,
-		FRmlTextureEntryPtr InTexture,
-		const FMatrix44f& InTransform,
-		const FIntRect& InScissorRect)
+		TSharedPtr<FCompiledRmlShader> InShader,
+		FRmlMesh* InMesh,
+		FRmlTextureEntry* InTexture,
+		int32 InTransform,
+		const FVector2f& InTranslation,
+		int32 InScissor)
 	{
-		CommandList.Add(FRmlDrawCommand::MakeDrawShader(InShader, MoveTemp(InMesh), MoveTemp(InTexture), InTransform, InScissorRect));
+		FRmlDrawShaderCommand& Cmd = Commands.Emplace<FRmlDrawShaderCommand>();
+		Cmd.Shader = FrameShaders.Add(MoveTemp(InShader));
+		Cmd.Mesh = FrameMeshes.Add(InMesh);
+		Cmd.Texture = AddTexture(InTexture);
+		Cmd.Transform = InTransform;
+		Cmd.Translation = InTranslation;
+		Cmd.Scissor = InScissor;
 	}
 
-	void EmplaceSaveLayerAsTexture(FRmlTextureEntryPtr Target, const FIntRect& InScissorRect, const FIntPoint& InIdealSize)
+	void EmplaceSaveLayerAsTexture(FRmlTextureEntry* Target, const FIntRect& InScissorRect, const FIntPoint& InIdealSize)
 	{
-		CommandList.Add(FRmlDrawCommand::MakeSaveLayerAsTexture(MoveTemp(Target), InScissorRect, InIdealSize));
+		FRmlSaveLayerAsTextureCommand& Cmd = Commands.Emplace<FRmlSaveLayerAsTextureCommand>();
+		bNeedsLayerStack = true;
+		Cmd.Target = FrameTextures.Add(Target);
+		Cmd.ScissorRect = InScissorRect;
+		Cmd.IdealSize = InIdealSize;
 	}
 
 	void EmplaceSaveLayerAsMaskImage(FCompiledRmlFilter* Target, const FIntRect& InScissorRect)
 	{
-		CommandList.Add(FRmlDrawCommand::MakeSaveLayerAsMaskImage(Target, InScissorRect));
+		FRmlSaveLayerAsMaskImageCommand& Cmd = Commands.Emplace<FRmlSaveLayerAsMaskImageCommand>();
+		bNeedsLayerStack = true;
+		Cmd.Target = Target;
+		Cmd.ScissorRect = InScissorRect;
 	}
 
+	// Per-frame state tables. The render interface interns its transform / scissor
+	// once per state change (not per draw) and passes the index to every draw.
+	int32 InternTransform(const FMatrix44f& Transform);
+	int32 InternScissor(const FIntRect& Rect);
+
+	// Recorded geometry has edges that only MSAA smooths (see FRmlMesh::bNeedsMultisampling).
+	void MarkNeedsMultisampling() { bNeedsMultisampling = true; }
+
+	// Drop everything recorded so far, keeping allocations for the next frame.
+	void ResetRecording();
+	int32 GetNumCommands() const { return Commands.Num(); }
+
 	bool IsFree() const { return bIsFree; }
 	void MarkUsing() { bIsFree = false; }
 	void MarkFree()  { bIsFree = true; }
 	void SetMSAASamples(int32 Samples) { MSAASamples = FMath::Max(Samples, 1); bUseMSAA = MSAASamples > 1; }
-
-	// Compiled shader storage (owned by RenderInterface, shared via pointer)
-	TMap<Rml::CompiledShaderHandle, TSharedPtr<FCompiledRmlShader>>* CompiledShaders = nullptr;
+	// RetainFrames <= 0 disables the arena (every mesh goes through the volatile path).
+	void SetGeometryRetention(int32 RetainFrames, int32 ArenaBytes) { GeometryRetainFrames = RetainFrames; GeometryArenaBytes = ArenaBytes; }
+	void SetMergeDraws(bool bEnable) { bMergeDraws = bEnable; }
+	void SetDirectRendering(bool bEnable) { bAllowDirectRendering = bEnable; }
+	// Render into InLayer instead of directly onto the Slate target. Only DirtyRect is
+	// redrawn (empty = reuse the texture as is); ContentRect bounds the composite.
+	void SetCachedLayer(const TSharedPtr<FRmlCachedLayer, ESPMode::ThreadSafe>& InLayer, const FIntRect& InDirtyRect, const FIntRect& InContentRect)
+	{
+		CachedLayer = InLayer;
+		CachedLayerDirtyRect = InDirtyRect;
+		CachedLayerContentRect = InContentRect;
+	}
+	// Frame-fence serial and game frame, assigned by the render interface when the drawer is handed out.
+	void SetFrameSerial(uint64 Serial, uint64 Frame) { FrameSerial = Serial; HandoutFrame = Frame; }
+	uint64 GetFrameSerial() const { return FrameSerial; }
+	uint64 GetHandoutFrame() const { return HandoutFrame; }
 
 private:
-	TArray<FRmlDrawCommand>	CommandList;
+	FRmlCommandStream		Commands;
 	bool					bIsFree;
+	uint64					FrameSerial = 0;
+	uint64					HandoutFrame = 0;
 	bool					bUseMSAA = true;
 	int32					MSAASamples = 4;
+	int32					GeometryRetainFrames = 3;
+	int32					GeometryArenaBytes = 16 * 1024 * 1024;
+	bool					bMergeDraws = true;
+	bool					bAllowDirectRendering = true;
+
+	// Eligibility for the direct path, tracked while recording: frames without layers,
+	// clip masks or snapshots, and with nothing MSAA would change, are drawn straight
+	// onto the Slate target instead of through layer 0.
+	bool					bNeedsLayerStack = false;
+	bool					bNeedsMultisampling = false;
+
+	// Per-frame tables referenced by index from the command stream. Raw pointers —
+	// lifetime is guaranteed by the render interface's frame fence, not refcounts.
+	// Consecutive draws almost always share a texture, so textures are deduplicated
+	// against the previous entry; transforms and scissors are fully interned.
+	TArray<FRmlMesh*>						FrameMeshes;
+	TArray<FRmlTextureEntry*>				FrameTextures;
+	TArray<FMatrix44f>						FrameTransforms;
+	TArray<FIntRect>						FrameScissors;
+	TArray<TSharedPtr<FCompiledRmlFilter>>	FrameFilters;	// CompositeLayers only — rare, kept owning
+	TArray<TSharedPtr<FCompiledRmlShader>>	FrameShaders;	// DrawShader only, kept owning like filters
+	TMap<uint32, int32>						TransformLookup;	// CRC of matrix -> FrameTransforms index
+	TMap<FIntRect, int32>					ScissorLookup;
+
+	FORCEINLINE int32 AddTexture(FRmlTextureEntry* Texture)
+	{
+		if (!Texture)
+			return INDEX_NONE;
+		if (FrameTextures.Num() > 0 && FrameTextures.Last() == Texture)
+			return FrameTextures.Num() - 1;
+		return FrameTextures.Add(Texture);
+	}
+
+	FRmlTextureEntry* GetTexture(int32 Index) const { return Index != INDEX_NONE ? FrameTextures[Index] : nullptr; }
+	// Texture actually bound for a draw: the atlas page for packed textures.
+	FRmlTextureEntry* GetBoundTexture(int32 Index) const;
+	static inline const FVector4f IdentityUVRect = FVector4f(1.0f, 1.0f, 0.0f, 0.0f);
+
+	// Final vertex transform for a draw: T(Translation) * FrameTransforms[Transform].
+	FMatrix44f GetDrawTransform(const FRmlGeometryCommand& Cmd) const
+	{
+		// Pre-multiplying by a translation only changes row 3.
+		FMatrix44f M = FrameTransforms[Cmd.Transform];
+		for (int32 Col = 0; Col < 4; ++Col)
+			M.M[3][Col] += Cmd.Translation.X * M.M[0][Col] + Cmd.Translation.Y * M.M[1][Col];
+		return M;
+	}
+
+	// Cached-layer mode for this frame (SetCachedLayer), reset once drawn.
+	TSharedPtr<FRmlCachedLayer, ESPMode::ThreadSafe>	CachedLayer;
+	FIntRect											CachedLayerDirtyRect;
+	FIntRect											CachedLayerContentRect;
 
 	// Render resources
 	FRmlLayerStack	LayerStack;
-	FTextureRHIRef	ResolveTarget;		// always 1x, for final composite
+	FTextureRHIRef	ResolveTarget;		// always 1x, copy of the Slate RT; pooled per frame
 	FBufferRHIRef	QuadVB;
 	FBufferRHIRef	QuadIB;
-	FIntPoint		CachedRTSize;
 
 	// Per-frame shared geometry buffer. Accumulated from all mesh commands during the
 	// pre-pass in DrawRenderThread. One RHICreateVertexBuffer/IndexBuffer per frame
@@ -367,49 +593,108 @@ private:
 	FBufferRHIRef	FrameVB;
 	FBufferRHIRef	FrameIB;
 
+	// Merged-draw cache. A run of DrawMesh commands that merges into the same batch
+	// as on a previous frame reuses the baked mesh, so static batches are built once
+	// and then promoted to the geometry arena like any other static mesh. Entries hold
+	// strong refs to their source meshes, which keeps the pointer comparison sound.
+	// The hash only picks the bucket: runs are matched on their full key, and runs that
+	// collide get entries of their own instead of replacing each other.
+	struct FRmlDrawBatch
+	{
+		TArray<TSharedPtr<FRmlMesh, ESPMode::ThreadSafe>>	Sources;
+		TArray<FVector2f>									Offsets;
+		TArray<FVector4f>									UVRects;
+		TSharedPtr<FRmlMesh, ESPMode::ThreadSafe>			Merged;
+		uint32												LastUsedEpoch = 0;
+	};
+	TMultiMap<uint32, FRmlDrawBatch>	BatchCache;
+	uint32								BatchEpoch = 0;
+	// Merged meshes referenced from FrameMeshes, owned until the recording is reset so
+	// evicting a cache entry never frees a mesh the frame still draws.
+	TArray<TSharedPtr<FRmlMesh, ESPMode::ThreadSafe>>	FrameBatches;
+
 	// Stencil state tracking
 	bool			bClipMaskActive = false;
 	int32			StencilRef = 0;
 
+	// Vertex transform / scissor last bound by ExecuteDrawMesh, so consecutive draws
+	// with the same state skip the RHI calls. Anything else that touches the vertex
+	// shader parameters, the PSO or the scissor must call InvalidateBoundDrawState.
+	int32			BoundTransform = INDEX_NONE;
+	FVector2f		BoundTranslation = FVector2f::ZeroVector;
+	FVector4f		BoundUVRect = IdentityUVRect;
+	int32			BoundScissor = INDEX_NONE;
+	void InvalidateBoundDrawState() { BoundTransform = INDEX_NONE; BoundScissor = INDEX_NONE; }
+
 	void EnsureRenderResources(FRHICommandListImmediate& RHICmdList, const FIntPoint& RTSize, EPixelFormat RTFormat);
 
 	// Pre-pass: accumulate all mesh vertices/indices into FrameVB/FrameIB and fill
 	// BaseVertex/StartIndex in each DrawMesh/DrawShader/RenderToClipMask command.
+	// Meshes drawn in GeometryRetainFrames distinct frames are promoted to the
+	// persistent FRmlGeometryArena and skip the per-frame upload from then on.
 	void BuildFrameGeometry(FRHICommandListImmediate& RHICmdList);
 
+	// Collapse runs of adjacent DrawMesh commands that share texture (or atlas page),
+	// scissor and transform (up to translation, which is baked into the vertices) into one draw.
+	void MergeDrawBatches();
+	FRmlMesh* GetOrBuildBatch(TConstArrayView<FRmlDrawMeshCommand*> Run, int32 NumVertices);
+	TArray<FRmlDrawMeshCommand*>	MergeRun;		// scratch for MergeDrawBatches
+
+	// Bind the command's geometry source (arena or frame VB/IB) and issue the draw.
+	void DrawCommandGeometry(FRHICommandListImmediate& RHICmdList, const FRmlGeometryCommand& Cmd);
+
+	// Run the recorded commands against the layer stack. Layer 0 must be pushed and
+	// its render pass begun; leaves the last render pass open.
+	void ExecuteCommands(FRHICommandListImmediate& RHICmdList, const FIntPoint& RTSize);
+
+	// Direct path: draw the commands straight onto the Slate target.
+	void DrawDirect(FRHICommandListImmediate& RHICmdList, const FTextureRHIRef& RT, const FIntPoint& RTSize);
+
+	// Cached-layer mode: redraw the dirty part of CachedLayer, then composite it onto RT.
+	void DrawCachedLayer(FRHICommandListImmediate& RHICmdList, const FTextureRHIRef& RT, const FIntPoint& RTSize);
+	// Composites, filters and layer snapshots read pixels outside their own draws,
+	// so a stream containing them can't be redrawn through a partial scissor.
+	bool CanRedrawPartially();
+
 	// Command executors
-	void ExecuteDrawMesh(FRHICommandListImmediate& RHICmdList, const FRmlDrawCommand& Cmd,
+	void ExecuteDrawMesh(FRHICommandListImmediate& RHICmdList, const FRmlDrawMeshCommand& Cmd,
 		TShaderMapRef<FRmlShaderVs>& Vs, TShaderMapRef<FRmlShaderPs>& Ps, TShaderMapRef<FRmlShaderPsNoTex>& PsNoTex,
 		FGraphicsPipelineStateInitializer& PSOTex, FGraphicsPipelineStateInitializer& PSONoTex,
 		FRmlTextureEntry*& CurTexture);
 
-	void ExecuteEnableClipMask(FRHICommandListImmediate& RHICmdList, const FRmlDrawCommand& Cmd);
+	void ExecuteEnableClipMask(FRHICommandListImmediate& RHICmdList, const FRmlEnableClipMaskCommand& Cmd);
 
-	void ExecuteRenderToClipMask(FRHICommandListImmediate& RHICmdList, const FRmlDrawCommand& Cmd,
+	void ExecuteRenderToClipMask(FRHICommandListImmediate& RHICmdList, const FRmlRenderToClipMaskCommand& Cmd,
 		TShaderMapRef<FRmlShaderVs>& Vs, TShaderMapRef<FRmlShaderPsNoTex>& PsNoTex);
 
-	void ExecutePushLayer(FRHICommandListImmediate& RHICmdList, const FRmlDrawCommand& Cmd, const FIntPoint& RTSize);
+	void ExecutePushLayer(FRHICommandListImmediate& RHICmdList, const FRmlPushLayerCommand& Cmd, const FIntPoint& RTSize);
 
-	void ExecuteCompositeLayers(FRHICommandListImmediate& RHICmdList, const FRmlDrawCommand& Cmd,
+	void ExecuteCompositeLayers(FRHICommandListImmediate& RHICmdList, const FRmlCompositeLayersCommand& Cmd,
 		TShaderMapRef<FRmlShaderVs>& Vs, TShaderMapRef<FRmlShaderPs>& Ps, const FIntPoint& RTSize);
 
 	void ExecutePopLayer(FRHICommandListImmediate& RHICmdList, const FIntPoint& RTSize);
 
-	void ExecuteDrawShader(FRHICommandListImmediate& RHICmdList, const FRmlDrawCommand& Cmd,
+	void ExecuteDrawShader(FRHICommandListImmediate& RHICmdList, const FRmlDrawShaderCommand& Cmd,
 		TShaderMapRef<FRmlShaderVs>& Vs, const FIntPoint& RTSize);
 
-	void ExecuteSaveLayerAsTexture(FRHICommandListImmediate& RHICmdList, const FRmlDrawCommand& Cmd, const FIntPoint& RTSize);
-	void ExecuteSaveLayerAsMaskImage(FRHICommandListImmediate& RHICmdList, const FRmlDrawCommand& Cmd, const FIntPoint& RTSize);
+	void ExecuteSaveLayerAsTexture(FRHICommandListImmediate& RHICmdList, const FRmlSaveLayerAsTextureCommand& Cmd, const FIntPoint& RTSize);
+	void ExecuteSaveLayerAsMaskImage(FRHICommandListImmediate& RHICmdList, const FRmlSaveLayerAsMaskImageCommand& Cmd, const FIntPoint& RTSize);
 
 	// Helpers
 	void BeginLayerRenderPass(FRHICommandListImmediate& RHICmdList, int32 LayerIndex, const FIntPoint& RTSize,
 		ERenderTargetLoadAction LoadAction, bool bClearStencil = false);
 	void EndCurrentRenderPass(FRHICommandListImmediate& RHICmdList);
 	void DrawFullscreenQuad(FRHICommandListImmediate& RHICmdList);
-	// Returns pointer to the buffer containing the result (PostprocessA or PostprocessB).
-	// ScissorRect: padded element bounds — all filter passes are scissored to this rect.
-	FTextureRHIRef* ApplyFilters(FRHICommandListImmediate& RHICmdList, const TArray<TSharedPtr<FCompiledRmlFilter>>& Filters,
-		TShaderMapRef<FRmlShaderVs>& Vs, const FIntPoint& RTSize, const FIntRect& ScissorRect);
+	// Reduce a filter list to the passes that actually have to run. No steps means
+	// the whole chain is an identity.
+	static void CompileFilterSteps(TConstArrayView<TSharedPtr<FCompiledRmlFilter>> Filters,
+		TArray<FRmlFilterStep, TInlineAllocator<8>>& OutSteps);
+	// Runs the steps on Region.A (the extracted element) and returns the buffer holding
+	// the result (Region.A or Region.B). All passes work in region space, scissored to
+	// Region.GetLocalRect(); RTSize is only needed to address full-layer mask textures.
+	FTextureRHIRef* ApplyFilters(FRHICommandListImmediate& RHICmdList, TConstArrayView<FRmlFilterStep> Steps,
+		TShaderMapRef<FRmlShaderVs>& Vs, FRmlFilterRegion& Region, const FIntPoint& RTSize);
+	// RTSize is the size of SourceDest/Temp, ScissorRect the part of them holding content.
 	void RenderBlur(FRHICommandListImmediate& RHICmdList, float Sigma,
 		FTextureRHIRef& SourceDest, FTextureRHIRef& Temp,
 		TShaderMapRef<FRmlShaderVs>& Vs, TShaderMapRef<FRmlShaderPsBlur>& BlurPs,
@@ -0,0 +1,183 @@
+#include "RmlGeometryArena.h"
+#include "RmlMesh.h"
+#include "Logging.h"
+#include "RHICommandList.h"
+#include "Algo/BinarySearch.h"
+
+// Set once the global arena has been destroyed. FRmlMesh instances owned by the
+// (static) render interface can outlive it during module teardown; their frees
+// are dropped instead of touching a dead queue.
+static bool GRmlGeometryArenaDestroyed = false;
+
+static TGlobalResource<FRmlGeometryArena> GRmlGeometryArena;
+
+FRmlGeometryArena& FRmlGeometryArena::Get()
+{
+	return GRmlGeometryArena;
+}
+
+void FRmlGeometryArena::EnqueueFree(const FRmlArenaAllocation& Alloc)
+{
+	if (!Alloc.IsValid() || GRmlGeometryArenaDestroyed)
+		return;
+	GRmlGeometryArena.PendingFrees.Enqueue(Alloc);
+}
+
+FRmlGeometryArena::~FRmlGeometryArena()
+{
+	GRmlGeometryArenaDestroyed = true;
+}
+
+// ============================================================================
+// FRangeAllocator
+// ============================================================================
+
+void FRmlGeometryArena::FRangeAllocator::Reset(int32 InCapacity)
+{
+	Capacity = InCapacity;
+	Used = 0;
+	FreeRanges.Reset();
+	if (Capacity > 0)
+		FreeRanges.Add({ 0, Capacity });
+}
+
+int32 FRmlGeometryArena::FRangeAllocator::Alloc(int32 Size)
+{
+	for (int32 i = 0; i < FreeRanges.Num(); ++i)
+	{
+		FRange& Range = FreeRanges[i];
+		if (Range.Size < Size)
+			continue;
+
+		const int32 Offset = Range.Offset;
+		Range.Offset += Size;
+		Range.Size -= Size;
+		if (Range.Size == 0)
+			FreeRanges.RemoveAt(i, 1, EAllowShrinking::No);
+		Used += Size;
+		return Offset;
+	}
+	return INDEX_NONE;
+}
+
+void FRmlGeometryArena::FRangeAllocator::Free(int32 Offset, int32 Size)
+{
+	// Insert sorted, then merge with the neighbours it touches.
+	const int32 Insert = Algo::LowerBoundBy(FreeRanges, Offset, [](const FRange& R) { return R.Offset; });
+	FreeRanges.Insert({ Offset, Size }, Insert);
+	Used -= Size;
+
+	if (Insert + 1 < FreeRanges.Num() && FreeRanges[Insert].Offset + FreeRanges[Insert].Size == FreeRanges[Insert + 1].Offset)
+	{
+		FreeRanges[Insert].Size += FreeRanges[Insert + 1].Size;
+		FreeRanges.RemoveAt(Insert + 1, 1, EAllowShrinking::No);
+	}
+	if (Insert > 0 && FreeRanges[Insert - 1].Offset + FreeRanges[Insert - 1].Size == FreeRanges[Insert].Offset)
+	{
+		FreeRanges[Insert - 1].Size += FreeRanges[Insert].Size;
+		FreeRanges.RemoveAt(Insert, 1, EAllowShrinking::No);
+	}
+}
+
+// ============================================================================
+// FRmlGeometryArena
+// ============================================================================
+
+void FRmlGeometryArena::ProcessPendingFrees()
+{
+	check(IsInRenderingThread() || IsInParallelRenderingThread());
+
+	FRmlArenaAllocation Alloc;
+	while (PendingFrees.Dequeue(Alloc))
+	{
+		// Allocations from before the last ReleaseRHI refer to buffers that no longer exist.
+		if (Alloc.Generation != Generation)
+			continue;
+		VertexAllocator.Free(Alloc.VertexOffset, Alloc.NumVertices);
+		IndexAllocator.Free(Alloc.IndexOffset, Alloc.NumIndices);
+		++FreeSerial;
+	}
+}
+
+bool FRmlGeometryArena::Allocate(FRHICommandListImmediate& RHICmdList, const FRmlMesh& Mesh, int32 CapacityBytes, FRmlArenaAllocation& OutAlloc)
+{
+	const int32 NumVerts = Mesh.Vertices.Num();
+	const int32 NumIdx   = Mesh.Indices.Num();
+	if (NumVerts == 0 || NumIdx == 0)
+		return false;
+
+	if (!VertexBuffer.IsValid())
+	{
+		// Split the byte budget assuming ~2 indices per vertex (quads use 1.5,
+		// rounded-border meshes slightly more).
+		constexpr int32 BytesPerVertexSlot = sizeof(FRmlMesh::FVertexData) + 2 * sizeof(uint16);
+		const int32 VertexCapacity = FMath::Max(CapacityBytes / BytesPerVertexSlot, 1024);
+		const int32 IndexCapacity  = VertexCapacity * 2;
+
+		FRHIResourceCreateInfo VInfo(TEXT("RmlUI_ArenaVB"));
+		VertexBuffer = RHICmdList.CreateVertexBuffer(sizeof(FRmlMesh::FVertexData) * VertexCapacity, BUF_Static, VInfo);
+
+		FRHIResourceCreateInfo IInfo(TEXT("RmlUI_ArenaIB"));
+		IndexBuffer = RHICmdList.CreateIndexBuffer(sizeof(uint16), sizeof(uint16) * IndexCapacity, BUF_Static, IInfo);
+
+		VertexAllocator.Reset(VertexCapacity);
+		IndexAllocator.Reset(IndexCapacity);
+
+		UE_LOG(LogUERmlUI, Log, TEXT("GeometryArena: created %d vertex / %d index slots (%.1f MB)"),
+			VertexCapacity, IndexCapacity, GetCapacityBytes() / (1024.0 * 1024.0));
+	}
+
+	const int32 VertexOffset = VertexAllocator.Alloc(NumVerts);
+	if (VertexOffset == INDEX_NONE)
+		return false;
+
+	const int32 IndexOffset = IndexAllocator.Alloc(NumIdx);
+	if (IndexOffset == INDEX_NONE)
+	{
+		VertexAllocator.Free(VertexOffset, NumVerts);
+		return false;
+	}
+
+	// Sub-range write into the static buffers. The RHI stages the data and copies
+	// it on the command list, so in-flight draws from other slices are unaffected.
+	const uint32 VBytes = sizeof(FRmlMesh::FVertexData) * NumVerts;
+	void* VDst = RHICmdList.LockBuffer(VertexBuffer, sizeof(FRmlMesh::FVertexData) * VertexOffset, VBytes, RLM_WriteOnly);
+	FMemory::Memcpy(VDst, Mesh.Vertices.GetData(), VBytes);
+	RHICmdList.UnlockBuffer(VertexBuffer);
+
+	const uint32 IBytes = sizeof(uint16) * NumIdx;
+	void* IDst = RHICmdList.LockBuffer(IndexBuffer, sizeof(uint16) * IndexOffset, IBytes, RLM_WriteOnly);
+	FMemory::Memcpy(IDst, Mesh.Indices.GetData(), IBytes);
+	RHICmdList.UnlockBuffer(IndexBuffer);
+
+	OutAlloc.VertexOffset = VertexOffset;
+	OutAlloc.NumVertices  = NumVerts;
+	OutAlloc.IndexOffset  = IndexOffset;
+	OutAlloc.NumIndices   = NumIdx;
+	OutAlloc.Generation   = Generation;
+	return true;
+}
+
+int64 FRmlGeometryArena::GetUsedBytes() const
+{
+	return (int64)VertexAllocator.GetUsed() * sizeof(FRmlMesh::FVertexData)
+		 + (int64)IndexAllocator.GetUsed() * sizeof(uint16);
+}
+
+int64 FRmlGeometryArena::GetCapacityBytes() const
+{
+	return (int64)VertexAllocator.GetCapacity() * sizeof(FRmlMesh::FVertexData)
+		 + (int64)IndexAllocator.GetCapacity() * sizeof(uint16);
+}
+
+void FRmlGeometryArena::ReleaseRHI()
+{
+	VertexBuffer.SafeRelease();
+	IndexBuffer.SafeRelease();
+	VertexAllocator.Reset(0);
+	IndexAllocator.Reset(0);
+	// Invalidate every outstanding FRmlArenaAllocation — those meshes fall back to
+	// the volatile path and get re-promoted once the buffers are recreated.
+	++Generation;
+	++FreeSerial;
+}
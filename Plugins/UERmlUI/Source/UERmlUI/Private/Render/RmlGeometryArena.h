@@ -0,0 +1,87 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "RenderResource.h"
+#include "Containers/Queue.h"
+
+class FRmlMesh;
+
+// Slice of the persistent arena owned by one retained FRmlMesh.
+// Offsets are in elements (vertices / uint16 indices), not bytes.
+struct FRmlArenaAllocation
+{
+	int32	VertexOffset = INDEX_NONE;
+	int32	NumVertices  = 0;
+	int32	IndexOffset  = INDEX_NONE;
+	int32	NumIndices   = 0;
+	uint32	Generation   = 0;	// arena generation at allocation time — stale after ReleaseRHI
+
+	bool IsValid() const { return VertexOffset != INDEX_NONE; }
+};
+
+// Persistent, sub-allocated static VB/IB for FRmlMesh geometry that has proven
+// static (drawn in N distinct frames). Meshes living in the arena are drawn
+// straight from it; only new or transient meshes go through the per-frame
+// BUF_Volatile path in FRmlDrawer::BuildFrameGeometry.
+//
+// Render-thread only, except EnqueueFree which may be called from any thread
+// (FRmlMesh is destroyed by whichever thread drops the last reference).
+class FRmlGeometryArena : public FRenderResource
+{
+public:
+	static FRmlGeometryArena& Get();
+
+	// Queue a slice for release. Drained on the render thread by ProcessPendingFrees.
+	static void EnqueueFree(const FRmlArenaAllocation& Alloc);
+
+	virtual ~FRmlGeometryArena();
+
+	// Apply frees queued since the last call.
+	void ProcessPendingFrees();
+
+	// Copy the mesh into the arena. Buffers are created lazily on first use, sized
+	// from CapacityBytes. Returns false (OutAlloc untouched) when the arena is full.
+	bool Allocate(FRHICommandListImmediate& RHICmdList, const FRmlMesh& Mesh, int32 CapacityBytes, FRmlArenaAllocation& OutAlloc);
+
+	bool IsResident(const FRmlArenaAllocation& Alloc) const { return Alloc.IsValid() && Alloc.Generation == Generation && VertexBuffer.IsValid(); }
+
+	// Bumped whenever space is returned to the arena (a slice freed, or the buffers
+	// released). A failed Allocate can only succeed after this changes.
+	uint32 GetFreeSerial() const { return FreeSerial; }
+
+	FRHIBuffer* GetVertexBuffer() const { return VertexBuffer.GetReference(); }
+	FRHIBuffer* GetIndexBuffer() const { return IndexBuffer.GetReference(); }
+	int64 GetUsedBytes() const;
+	int64 GetCapacityBytes() const;
+
+	// ~Begin FRenderResource API
+	virtual void ReleaseRHI() override;
+	virtual FString GetFriendlyName() const override { return TEXT("FRmlGeometryArena"); }
+	// ~End FRenderResource API
+
+private:
+	// First-fit free-list allocator over [0, Capacity). Free ranges are kept sorted
+	// by offset and coalesced on release so long sessions don't fragment.
+	class FRangeAllocator
+	{
+	public:
+		void Reset(int32 InCapacity);
+		int32 Alloc(int32 Size);
+		void Free(int32 Offset, int32 Size);
+		int32 GetCapacity() const { return Capacity; }
+		int32 GetUsed() const { return Used; }
+	private:
+		struct FRange { int32 Offset; int32 Size; };
+		TArray<FRange>	FreeRanges;
+		int32			Capacity = 0;
+		int32			Used = 0;
+	};
+
+	FRangeAllocator		VertexAllocator;
+	FRangeAllocator		IndexAllocator;
+	FBufferRHIRef		VertexBuffer;
+	FBufferRHIRef		IndexBuffer;
+	uint32				Generation = 1;
+	uint32				FreeSerial = 1;
+
+	TQueue<FRmlArenaAllocation, EQueueMode::Mpsc>	PendingFrees;
+};
@@ -2,6 +2,14 @@
 #include "RmlUi/Core/Vertex.h"
 #include "RmlUi/Core/Span.h"
 
+FRmlMesh::~FRmlMesh()
+{
+	// The last reference may be dropped on the game thread (ReleaseGeometry) or on
+	// the render thread (command list reset); either way the slice is returned to
+	// the arena on the render thread.
+	FRmlGeometryArena::EnqueueFree(ArenaAlloc);
+}
+
 void FRmlMesh::Setup(Rml::Span<const Rml::Vertex> InVertices, Rml::Span<const int> InIndices)
 {
 	const int32 NumVerts = (int32)InVertices.size();
@@ -9,6 +17,7 @@ void FRmlMesh::Setup(Rml::Span<const Rml::Vertex> InVertices, Rml::Span<const in
 
 	// copy vertices
 	Vertices.SetNumUninitialized(NumVerts);
+	Bounds.Init();
 	for (int32 i = 0; i < NumVerts; ++i)
 	{
 		const Rml::Vertex& V = InVertices[i];
@@ -16,6 +25,7 @@ void FRmlMesh::Setup(Rml::Span<const Rml::Vertex> InVertices, Rml::Span<const in
 			FVector2f(V.position.x, V.position.y),
 			FVector2f(V.tex_coord.x, V.tex_coord.y),
 			FColor(V.colour.red, V.colour.green, V.colour.blue, V.colour.alpha));
+		Bounds += Vertices[i].Position;
 	}
 
 	// copy indices (uint16 limits meshes to 65535 vertices)
@@ -29,6 +39,37 @@ void FRmlMesh::Setup(Rml::Span<const Rml::Vertex> InVertices, Rml::Span<const in
 
 	NumVertices  = NumVerts;
 	NumTriangles = NumIdx / 3;
+
+	// Outline edges are the ones used by a single triangle; toggling each edge in a
+	// set leaves exactly those. Vertices duplicated across an inner edge make it look
+	// like an outline, which only errs towards keeping MSAA.
+	TSet<uint32> OutlineEdges;
+	OutlineEdges.Reserve(NumIdx);
+	for (int32 i = 0; i + 2 < NumIdx; i += 3)
+	{
+		for (int32 Corner = 0; Corner < 3; ++Corner)
+		{
+			const uint16 A = Indices[i + Corner];
+			const uint16 B = Indices[i + (Corner + 1) % 3];
+			const uint32 Key = A < B ? ((uint32)A << 16) | B : ((uint32)B << 16) | A;
+			bool bAlreadyInSet = false;
+			OutlineEdges.Add(Key, &bAlreadyInSet);
+			if (bAlreadyInSet)
+				OutlineEdges.Remove(Key);
+		}
+	}
+
+	bNeedsMultisampling = false;
+	for (uint32 Key : OutlineEdges)
+	{
+		const FVector2f& A = Vertices[Key >> 16].Position;
+		const FVector2f& B = Vertices[Key & 0xFFFF].Position;
+		if (A.X != B.X && A.Y != B.Y)
+		{
+			bNeedsMultisampling = true;
+			break;
+		}
+	}
 }
 
 FVertexDeclarationRHIRef FRmlMesh::GetMeshDeclaration()
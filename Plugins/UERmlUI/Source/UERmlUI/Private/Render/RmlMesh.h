@@ -1,4 +1,5 @@
 #pragma once
+#include "RmlGeometryArena.h"
 
 namespace Rml
 {
@@ -6,11 +7,13 @@ namespace Rml
 	template<typename T> class Span;
 }
 
-// CPU-only mesh container. RHI buffers are owned by FRmlDrawer's per-frame
-// shared VB/IB; this struct just holds the vertex/index data for the pre-pass.
+// CPU-side mesh container. RHI buffers are owned by FRmlDrawer's per-frame
+// shared VB/IB, or by FRmlGeometryArena once the mesh has been promoted.
 class FRmlMesh : public TSharedFromThis<FRmlMesh, ESPMode::ThreadSafe>
 {
 public:
+	~FRmlMesh();
+
 	struct FVertexData
 	{
 		FVector2f	Position;
@@ -31,4 +34,20 @@ public:
 	TResourceArray<uint16>			Indices;
 	int32							NumVertices = 0;
 	int32							NumTriangles = 0;
+	FBox2f							Bounds = FBox2f(ForceInit);	// local vertex bounds, before translation
+	// True when an outline edge is neither horizontal nor vertical (rounded corners,
+	// rotated shapes): only such meshes look different without MSAA.
+	bool							bNeedsMultisampling = false;
+
+	// Size of the vertex + index data as uploaded to the GPU.
+	int32 GetDataSize() const { return Vertices.Num() * sizeof(FVertexData) + Indices.Num() * sizeof(uint16); }
+
+	// Render-thread retention tracking (see FRmlDrawer::BuildFrameGeometry).
+	// FramesDrawn counts distinct frames, not draws — a mesh drawn twice in one
+	// frame is not any more "static" than one drawn once.
+	uint32							LastDrawnFrame = MAX_uint32;
+	int32							FramesDrawn = 0;
+	FRmlArenaAllocation				ArenaAlloc;
+	// Arena free serial at the last failed promotion; no retry until it changes.
+	uint32							ArenaFailedSerial = 0;
 };
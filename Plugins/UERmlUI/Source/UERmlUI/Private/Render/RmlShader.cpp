@@ -10,8 +10,7 @@ IMPLEMENT_SHADER_TYPE(, FRmlShaderPsNoTex, TEXT("/Plugin/UERmlUI/Private/RmlShad
 IMPLEMENT_SHADER_TYPE(, FRmlShaderPsPassthrough, TEXT("/Plugin/UERmlUI/Private/RmlShader.usf"), TEXT("RmlFilter_Passthrough"), SF_Pixel);
 IMPLEMENT_SHADER_TYPE(, FRmlShaderPsBlur, TEXT("/Plugin/UERmlUI/Private/RmlShader.usf"), TEXT("RmlFilter_Blur"), SF_Pixel);
 IMPLEMENT_SHADER_TYPE(, FRmlShaderPsDropShadow, TEXT("/Plugin/UERmlUI/Private/RmlShader.usf"), TEXT("RmlFilter_DropShadow"), SF_Pixel);
-IMPLEMENT_SHADER_TYPE(, FRmlShaderPsColorMatrix, TEXT("/Plugin/UERmlUI/Private/RmlShader.usf"), TEXT("RmlFilter_ColorMatrix"), SF_Pixel);
-IMPLEMENT_SHADER_TYPE(, FRmlShaderPsBlendMask, TEXT("/Plugin/UERmlUI/Private/RmlShader.usf"), TEXT("RmlFilter_BlendMask"), SF_Pixel);
+IMPLEMENT_SHADER_TYPE(, FRmlShaderPsFilterChain, TEXT("/Plugin/UERmlUI/Private/RmlShader.usf"), TEXT("RmlFilter_Chain"), SF_Pixel);
 
 // MSAA resolve shader
 IMPLEMENT_SHADER_TYPE(, FRmlShaderPsMsaaResolve, TEXT("/Plugin/UERmlUI/Private/RmlShader.usf"), TEXT("RmlFilter_MsaaResolve"), SF_Pixel);
@@ -21,12 +21,16 @@ public:
 		: FGlobalShader(Initializer)
 	{
 		InTransform.Bind(Initializer.ParameterMap, TEXT("InTransform"));
+		InUVRect.Bind(Initializer.ParameterMap, TEXT("InUVRect"));
 	}
 
-	void SetParameters(FRHICommandList& RHICmdList, const FMatrix44f& TransformValue)
+	// UVRect remaps vertex UVs (UV * xy + zw) for textures packed into an atlas page.
+	void SetParameters(FRHICommandList& RHICmdList, const FMatrix44f& TransformValue,
+		const FVector4f& UVRect = FVector4f(1.0f, 1.0f, 0.0f, 0.0f))
 	{
 		FRHIBatchedShaderParameters& Params = RHICmdList.GetScratchShaderParameters();
 		SetShaderValue(Params, InTransform, TransformValue);
+		SetShaderValue(Params, InUVRect, UVRect);
 		RHICmdList.SetBatchedShaderParameters(RHICmdList.GetBoundVertexShader(), Params);
 	}
 
@@ -36,6 +40,7 @@ public:
 	}
 private:
 	LAYOUT_FIELD(FShaderParameter, InTransform)
+	LAYOUT_FIELD(FShaderParameter, InUVRect)
 };
 
 // ============================================================================
@@ -239,57 +244,24 @@ private:
 };
 
 // ============================================================================
-// Filter: Color Matrix
+// Filter: fused per-pixel chain (color matrix × opacity × mask image)
 // ============================================================================
 
-class FRmlShaderPsColorMatrix : public FGlobalShader
+class FRmlShaderPsFilterChain : public FGlobalShader
 {
-	DECLARE_SHADER_TYPE(FRmlShaderPsColorMatrix, Global)
+	DECLARE_SHADER_TYPE(FRmlShaderPsFilterChain, Global)
 public:
-	FRmlShaderPsColorMatrix() {}
-	FRmlShaderPsColorMatrix(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+	FRmlShaderPsFilterChain() {}
+	FRmlShaderPsFilterChain(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
 		: FGlobalShader(Initializer)
 	{
 		InTexture.Bind(Initializer.ParameterMap, TEXT("InTexture"));
 		InTextureSampler.Bind(Initializer.ParameterMap, TEXT("InTextureSampler"));
 		InColorMatrix.Bind(Initializer.ParameterMap, TEXT("InColorMatrix"));
-	}
-
-	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
-	{
-		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
-	}
-
-	void SetParameters(FRHICommandList& RHICmdList, FRHIPixelShader* ShaderRHI, FRHITexture* Texture, const FMatrix44f& Matrix)
-	{
-		FRHIBatchedShaderParameters& Params = RHICmdList.GetScratchShaderParameters();
-		SetTextureParameter(Params, InTexture, Texture);
-		SetSamplerParameter(Params, InTextureSampler, TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI());
-		SetShaderValue(Params, InColorMatrix, Matrix);
-		RHICmdList.SetBatchedShaderParameters(ShaderRHI, Params);
-	}
-private:
-	LAYOUT_FIELD(FShaderResourceParameter, InTexture)
-	LAYOUT_FIELD(FShaderResourceParameter, InTextureSampler)
-	LAYOUT_FIELD(FShaderParameter, InColorMatrix)
-};
-
-// ============================================================================
-// Filter: Blend Mask
-// ============================================================================
-
-class FRmlShaderPsBlendMask : public FGlobalShader
-{
-	DECLARE_SHADER_TYPE(FRmlShaderPsBlendMask, Global)
-public:
-	FRmlShaderPsBlendMask() {}
-	FRmlShaderPsBlendMask(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
-		: FGlobalShader(Initializer)
-	{
-		InTexture.Bind(Initializer.ParameterMap, TEXT("InTexture"));
-		InTextureSampler.Bind(Initializer.ParameterMap, TEXT("InTextureSampler"));
+		InOpacity.Bind(Initializer.ParameterMap, TEXT("InOpacity"));
 		InMaskTexture.Bind(Initializer.ParameterMap, TEXT("InMaskTexture"));
 		InMaskSampler.Bind(Initializer.ParameterMap, TEXT("InMaskSampler"));
+		InMaskUVRect.Bind(Initializer.ParameterMap, TEXT("InMaskUVRect"));
 	}
 
 	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
@@ -297,20 +269,31 @@ public:
 		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
 	}
 
-	void SetParameters(FRHICommandList& RHICmdList, FRHIPixelShader* ShaderRHI, FRHITexture* Texture, FRHITexture* MaskTexture)
+	// MaskTexture: pass a white texture when the step has no mask. MaskUVRect maps the
+	// filter texture's UVs onto the mask (UV * xy + zw), for filter chains that run in
+	// an element-sized region of the layer.
+	void SetParameters(FRHICommandList& RHICmdList, FRHIPixelShader* ShaderRHI, FRHITexture* Texture,
+		const FMatrix44f& Matrix, float Opacity, FRHITexture* MaskTexture,
+		const FVector4f& MaskUVRect = FVector4f(1.0f, 1.0f, 0.0f, 0.0f))
 	{
 		FRHIBatchedShaderParameters& Params = RHICmdList.GetScratchShaderParameters();
 		SetTextureParameter(Params, InTexture, Texture);
 		SetSamplerParameter(Params, InTextureSampler, TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI());
+		SetShaderValue(Params, InColorMatrix, Matrix);
+		SetShaderValue(Params, InOpacity, Opacity);
 		SetTextureParameter(Params, InMaskTexture, MaskTexture);
 		SetSamplerParameter(Params, InMaskSampler, TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI());
+		SetShaderValue(Params, InMaskUVRect, MaskUVRect);
 		RHICmdList.SetBatchedShaderParameters(ShaderRHI, Params);
 	}
 private:
 	LAYOUT_FIELD(FShaderResourceParameter, InTexture)
 	LAYOUT_FIELD(FShaderResourceParameter, InTextureSampler)
+	LAYOUT_FIELD(FShaderParameter, InColorMatrix)
+	LAYOUT_FIELD(FShaderParameter, InOpacity)
 	LAYOUT_FIELD(FShaderResourceParameter, InMaskTexture)
 	LAYOUT_FIELD(FShaderResourceParameter, InMaskSampler)
+	LAYOUT_FIELD(FShaderParameter, InMaskUVRect)
 };
 
 // ============================================================================
@@ -327,6 +310,7 @@ public:
 	{
 		InMsaaTexture.Bind(Initializer.ParameterMap, TEXT("InMsaaTexture"));
 		InSampleCount.Bind(Initializer.ParameterMap, TEXT("InSampleCount"));
+		InPixelOffset.Bind(Initializer.ParameterMap, TEXT("InPixelOffset"));
 	}
 
 	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
@@ -334,16 +318,21 @@ public:
 		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
 	}
 
-	void SetParameters(FRHICommandList& RHICmdList, FRHIPixelShader* ShaderRHI, FRHITexture* MsaaTexture, int32 NumSamples)
+	// PixelOffset is added to the output pixel position to get the source texel, so a
+	// region of the layer can be resolved into the top-left of a smaller target.
+	void SetParameters(FRHICommandList& RHICmdList, FRHIPixelShader* ShaderRHI, FRHITexture* MsaaTexture, int32 NumSamples,
+		const FIntPoint& PixelOffset = FIntPoint::ZeroValue)
 	{
 		FRHIBatchedShaderParameters& Params = RHICmdList.GetScratchShaderParameters();
 		SetTextureParameter(Params, InMsaaTexture, MsaaTexture);
 		SetShaderValue(Params, InSampleCount, NumSamples);
+		SetShaderValue(Params, InPixelOffset, FIntVector2(PixelOffset.X, PixelOffset.Y));
 		RHICmdList.SetBatchedShaderParameters(ShaderRHI, Params);
 	}
 private:
 	LAYOUT_FIELD(FShaderResourceParameter, InMsaaTexture)
 	LAYOUT_FIELD(FShaderParameter, InSampleCount)
+	LAYOUT_FIELD(FShaderParameter, InPixelOffset)
 };
 
 // ============================================================================
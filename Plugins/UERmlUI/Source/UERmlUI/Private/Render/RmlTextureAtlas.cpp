@@ -0,0 +1,359 @@
+#include "RmlTextureAtlas.h"
+#include "Render/TextureEntries.h"
+#include "Logging.h"
+#include "Engine/Texture2D.h"
+#include "Algo/BinarySearch.h"
+#include "Math/RandomStream.h"
+#include "HAL/IConsoleManager.h"
+
+// ============================================================================
+// FRmlAtlasPacker
+// ============================================================================
+
+void FRmlAtlasPacker::Reset(int32 InSize)
+{
+	Size = InSize;
+	NumAllocs = 0;
+	UsedArea = 0;
+	Shelves.Reset();
+	FreeBands.Reset();
+	if (Size > 0)
+		FreeBands.Add({ 0, Size });
+}
+
+int32 FRmlAtlasPacker::AllocSpan(TArray<FSpan>& Spans, int32 Length)
+{
+	for (int32 i = 0; i < Spans.Num(); ++i)
+	{
+		FSpan& Span = Spans[i];
+		if (Span.Length < Length)
+			continue;
+
+		const int32 Start = Span.Start;
+		Span.Start += Length;
+		Span.Length -= Length;
+		if (Span.Length == 0)
+			Spans.RemoveAt(i, 1, EAllowShrinking::No);
+		return Start;
+	}
+	return INDEX_NONE;
+}
+
+void FRmlAtlasPacker::FreeSpan(TArray<FSpan>& Spans, int32 Start, int32 Length)
+{
+	// Insert sorted, then merge with the neighbours it touches.
+	const int32 Insert = Algo::LowerBoundBy(Spans, Start, [](const FSpan& S) { return S.Start; });
+	Spans.Insert({ Start, Length }, Insert);
+
+	if (Insert + 1 < Spans.Num() && Spans[Insert].Start + Spans[Insert].Length == Spans[Insert + 1].Start)
+	{
+		Spans[Insert].Length += Spans[Insert + 1].Length;
+		Spans.RemoveAt(Insert + 1, 1, EAllowShrinking::No);
+	}
+	if (Insert > 0 && Spans[Insert - 1].Start + Spans[Insert - 1].Length == Spans[Insert].Start)
+	{
+		Spans[Insert - 1].Length += Spans[Insert].Length;
+		Spans.RemoveAt(Insert, 1, EAllowShrinking::No);
+	}
+}
+
+bool FRmlAtlasPacker::AllocInShelf(FShelf& Shelf, int32 Width, FIntPoint& OutPos)
+{
+	const int32 X = AllocSpan(Shelf.FreeSpans, Width);
+	if (X == INDEX_NONE)
+		return false;
+	++Shelf.NumAllocs;
+	OutPos = FIntPoint(X, Shelf.Y);
+	return true;
+}
+
+bool FRmlAtlasPacker::Alloc(FIntPoint ItemSize, FIntPoint& OutPos)
+{
+	if (ItemSize.X <= 0 || ItemSize.Y <= 0 || ItemSize.X > Size || ItemSize.Y > Size)
+		return false;
+
+	auto HasRoom = [&ItemSize](const FShelf& Shelf)
+	{
+		if (Shelf.Height < ItemSize.Y)
+			return false;
+		for (const FSpan& Span : Shelf.FreeSpans)
+		{
+			if (Span.Length >= ItemSize.X)
+				return true;
+		}
+		return false;
+	};
+
+	// Tightest existing shelf that wastes at most half its height.
+	auto FindShelf = [&](int32 MaxHeight) -> FShelf*
+	{
+		FShelf* Best = nullptr;
+		for (FShelf& Shelf : Shelves)
+		{
+			if (Shelf.Height <= MaxHeight && (!Best || Shelf.Height < Best->Height) && HasRoom(Shelf))
+				Best = &Shelf;
+		}
+		return Best;
+	};
+
+	FShelf* Shelf = FindShelf(ItemSize.Y * 2);
+	if (!Shelf)
+	{
+		// Open a new shelf. Heights are rounded up so similar items share shelves.
+		int32 Height = FMath::Min(Align(ItemSize.Y, 4), Size);
+		int32 Y = AllocSpan(FreeBands, Height);
+		if (Y == INDEX_NONE && Height != ItemSize.Y)
+		{
+			Height = ItemSize.Y;
+			Y = AllocSpan(FreeBands, Height);
+		}
+
+		if (Y != INDEX_NONE)
+		{
+			const int32 Insert = Algo::LowerBoundBy(Shelves, Y, [](const FShelf& S) { return S.Y; });
+			Shelf = &Shelves.InsertDefaulted_GetRef(Insert);
+			Shelf->Y = Y;
+			Shelf->Height = Height;
+			Shelf->FreeSpans.Add({ 0, Size });
+		}
+		else
+		{
+			// Page is out of vertical space — accept any shelf tall enough.
+			Shelf = FindShelf(MAX_int32);
+		}
+	}
+
+	if (!Shelf || !AllocInShelf(*Shelf, ItemSize.X, OutPos))
+		return false;
+
+	++NumAllocs;
+	UsedArea += (int64)ItemSize.X * ItemSize.Y;
+	return true;
+}
+
+void FRmlAtlasPacker::Free(const FIntRect& Rect)
+{
+	const int32 Index = Algo::BinarySearchBy(Shelves, Rect.Min.Y, [](const FShelf& S) { return S.Y; });
+	if (!ensureMsgf(Index != INDEX_NONE, TEXT("FRmlAtlasPacker::Free: no shelf at y=%d"), Rect.Min.Y))
+		return;
+
+	FShelf& Shelf = Shelves[Index];
+	FreeSpan(Shelf.FreeSpans, Rect.Min.X, Rect.Width());
+	--NumAllocs;
+	UsedArea -= (int64)Rect.Width() * Rect.Height();
+
+	if (--Shelf.NumAllocs == 0)
+	{
+		FreeSpan(FreeBands, Shelf.Y, Shelf.Height);
+		Shelves.RemoveAt(Index, 1, EAllowShrinking::No);
+	}
+}
+
+bool FRmlAtlasPacker::SelfTest(FString& OutError)
+{
+	constexpr int32 PageSize = 512;
+	FRmlAtlasPacker Packer(PageSize);
+	FRandomStream Random(0x524D4C);
+	TArray<FIntRect> Live;
+	int64 LiveArea = 0;
+	int32 NumRejected = 0;
+
+	for (int32 Step = 0; Step < 20000; ++Step)
+	{
+		// Bias towards allocation until the page fills up, then churn.
+		if (Live.Num() == 0 || Random.FRand() < 0.55f)
+		{
+			// Mostly small items (glyph-effect sized) with the odd large one.
+			const int32 MaxDim = Random.FRand() < 0.9f ? 48 : 160;
+			const FIntPoint ItemSize(Random.RandRange(1, MaxDim), Random.RandRange(1, MaxDim));
+			FIntPoint Pos;
+			if (!Packer.Alloc(ItemSize, Pos))
+			{
+				++NumRejected;
+				continue;
+			}
+
+			const FIntRect Rect(Pos, Pos + ItemSize);
+			if (Rect.Min.X < 0 || Rect.Min.Y < 0 || Rect.Max.X > PageSize || Rect.Max.Y > PageSize)
+			{
+				OutError = FString::Printf(TEXT("step %d: rect [%d,%d]-[%d,%d] outside the page"),
+					Step, Rect.Min.X, Rect.Min.Y, Rect.Max.X, Rect.Max.Y);
+				return false;
+			}
+			for (const FIntRect& Other : Live)
+			{
+				if (Rect.Intersect(Other))
+				{
+					OutError = FString::Printf(TEXT("step %d: rect [%d,%d]-[%d,%d] overlaps [%d,%d]-[%d,%d]"),
+						Step, Rect.Min.X, Rect.Min.Y, Rect.Max.X, Rect.Max.Y,
+						Other.Min.X, Other.Min.Y, Other.Max.X, Other.Max.Y);
+					return false;
+				}
+			}
+			Live.Add(Rect);
+			LiveArea += (int64)ItemSize.X * ItemSize.Y;
+		}
+		else
+		{
+			const int32 Index = Random.RandRange(0, Live.Num() - 1);
+			const FIntRect Rect = Live[Index];
+			Live.RemoveAtSwap(Index);
+			LiveArea -= (int64)Rect.Width() * Rect.Height();
+			Packer.Free(Rect);
+		}
+
+		if (Packer.GetNumAllocs() != Live.Num() || Packer.GetUsedArea() != LiveArea)
+		{
+			OutError = FString::Printf(TEXT("step %d: packer tracks %d allocs / %lld texels, expected %d / %lld"),
+				Step, Packer.GetNumAllocs(), Packer.GetUsedArea(), Live.Num(), LiveArea);
+			return false;
+		}
+	}
+
+	if (NumRejected == 0)
+	{
+		OutError = TEXT("the page never filled up — the run did not exercise the out-of-space paths");
+		return false;
+	}
+
+	for (const FIntRect& Rect : Live)
+		Packer.Free(Rect);
+
+	FIntPoint Pos;
+	if (!Packer.IsEmpty() || !Packer.Alloc(FIntPoint(PageSize, PageSize), Pos) || Pos != FIntPoint::ZeroValue)
+	{
+		OutError = TEXT("freeing every rect did not give the whole page back");
+		return false;
+	}
+	return true;
+}
+
+// ============================================================================
+// FRmlTextureAtlas
+// ============================================================================
+
+FRmlTextureAtlas::FRmlTextureAtlas(int32 InPageSize, int32 InMaxTextureSize)
+	: PageSize(FMath::Max(InPageSize, 64))
+	, MaxTextureSize(FMath::Clamp(InMaxTextureSize, 0, PageSize / 2 - 2 * Padding))
+{
+}
+
+bool FRmlTextureAtlas::CanPack(Rml::Vector2i Dimensions) const
+{
+	return Dimensions.x > 0 && Dimensions.y > 0
+		&& Dimensions.x <= MaxTextureSize && Dimensions.y <= MaxTextureSize;
+}
+
+FRmlTextureAtlas::FPage& FRmlTextureAtlas::AddPage()
+{
+	// Match LoadTextureFromRaw settings so packed and standalone textures sample alike.
+	UTexture2D* Texture = UTexture2D::CreateTransient(PageSize, PageSize, PF_R8G8B8A8);
+	Texture->SRGB = false;
+	Texture->Filter = TF_Bilinear;
+	Texture->NeverStream = true;
+	Texture->UpdateResource();
+
+	FPage& Page = Pages.AddDefaulted_GetRef();
+	Page.Entry = MakeShared<FRmlTextureEntry, ESPMode::ThreadSafe>(Texture);
+	Page.Entry->bPremultiplied = true;
+	Page.Packer.Reset(PageSize);
+
+	UE_LOG(LogUERmlUI, Log, TEXT("TextureAtlas: added %dx%d page (%d total)"), PageSize, PageSize, Pages.Num());
+	return Page;
+}
+
+TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe> FRmlTextureAtlas::Add(Rml::Span<const Rml::byte> Source, Rml::Vector2i Dimensions)
+{
+	check(CanPack(Dimensions));
+	const FIntPoint Padded(Dimensions.x + 2 * Padding, Dimensions.y + 2 * Padding);
+
+	FPage* Target = nullptr;
+	FIntPoint Pos;
+	for (FPage& Page : Pages)
+	{
+		if (Page.Packer.Alloc(Padded, Pos))
+		{
+			Target = &Page;
+			break;
+		}
+	}
+	if (!Target)
+	{
+		Target = &AddPage();
+		verify(Target->Packer.Alloc(Padded, Pos));
+	}
+
+	// Copy into a padded buffer whose border repeats the edge texels.
+	const int32 SrcPitch = Dimensions.x * 4;
+	const int32 DstPitch = Padded.X * 4;
+	uint8* Data = new uint8[DstPitch * Padded.Y];
+	for (int32 Y = 0; Y < Padded.Y; ++Y)
+	{
+		const uint8* SrcRow = Source.data() + FMath::Clamp(Y - Padding, 0, Dimensions.y - 1) * SrcPitch;
+		uint8* DstRow = Data + Y * DstPitch;
+		FMemory::Memcpy(DstRow + Padding * 4, SrcRow, SrcPitch);
+		for (int32 X = 0; X < Padding; ++X)
+		{
+			FMemory::Memcpy(DstRow + X * 4, SrcRow, 4);
+			FMemory::Memcpy(DstRow + (Padding + Dimensions.x + X) * 4, SrcRow + SrcPitch - 4, 4);
+		}
+	}
+
+	auto* Region = new FUpdateTextureRegion2D(Pos.X, Pos.Y, 0, 0, Padded.X, Padded.Y);
+	CastChecked<UTexture2D>(Target->Entry->BoundTexture.Get())->UpdateTextureRegions(0, 1u, Region, DstPitch, 4, Data,
+		[](uint8* D, const FUpdateTextureRegion2D* R) { delete[] D; delete R; });
+
+	auto Entry = MakeShared<FRmlTextureEntry, ESPMode::ThreadSafe>();
+	Entry->bPremultiplied = true;
+	Entry->AtlasPage = Target->Entry;
+	Entry->AtlasRect = FIntRect(Pos, Pos + Padded);
+	const float InvSize = 1.0f / PageSize;
+	Entry->AtlasUVRect = FVector4f(
+		Dimensions.x * InvSize, Dimensions.y * InvSize,
+		(Pos.X + Padding) * InvSize, (Pos.Y + Padding) * InvSize);
+	return Entry;
+}
+
+void FRmlTextureAtlas::Remove(const FRmlTextureEntry& Entry)
+{
+	const int32 Index = Pages.IndexOfByPredicate([&Entry](const FPage& Page) { return Page.Entry == Entry.AtlasPage; });
+	if (!ensureMsgf(Index != INDEX_NONE, TEXT("TextureAtlas: entry references an evicted page")))
+		return;
+
+	FPage& Page = Pages[Index];
+	Page.Packer.Free(Entry.AtlasRect);
+
+	// Keep one page around so a texture that is regenerated every few frames
+	// doesn't create and destroy a page each time.
+	if (Page.Packer.IsEmpty() && Pages.Num() > 1)
+	{
+		Pages.RemoveAtSwap(Index);
+		UE_LOG(LogUERmlUI, Log, TEXT("TextureAtlas: evicted empty page (%d left)"), Pages.Num());
+	}
+}
+
+int32 FRmlTextureAtlas::GetNumPacked() const
+{
+	int32 Count = 0;
+	for (const FPage& Page : Pages)
+		Count += Page.Packer.GetNumAllocs();
+	return Count;
+}
+
+// ============================================================================
+// Self-check
+// ============================================================================
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommand GRmlAtlasSelfTestCmd(
+	TEXT("rmlui.AtlasSelfTest"),
+	TEXT("Run a randomized alloc/free sequence through the texture atlas packer and validate it."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FString Error;
+		if (FRmlAtlasPacker::SelfTest(Error))
+			UE_LOG(LogUERmlUI, Display, TEXT("AtlasSelfTest: passed"));
+		else
+			UE_LOG(LogUERmlUI, Error, TEXT("AtlasSelfTest: FAILED — %s"), *Error);
+	}));
+#endif
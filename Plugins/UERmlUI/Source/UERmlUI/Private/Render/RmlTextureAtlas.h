@@ -0,0 +1,100 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "RmlUi/Core/Types.h"
+
+class FRmlTextureEntry;
+
+// Shelf packer over a square page. Allocations are grouped into horizontal shelves;
+// each shelf keeps a sorted, coalesced list of free horizontal spans, and the page
+// keeps one for the free vertical bands between shelves. Freeing the last item of a
+// shelf gives its band back, so a page that empties out is fully reusable.
+// Pure bookkeeping — no rendering dependencies.
+class FRmlAtlasPacker
+{
+public:
+	explicit FRmlAtlasPacker(int32 InSize = 0) { Reset(InSize); }
+
+	void Reset(int32 InSize);
+
+	// Returns false (OutPos untouched) when the page has no room for Size.
+	bool Alloc(FIntPoint Size, FIntPoint& OutPos);
+	// Rect must be exactly what a previous Alloc returned.
+	void Free(const FIntRect& Rect);
+
+	bool IsEmpty() const { return NumAllocs == 0; }
+	int32 GetNumAllocs() const { return NumAllocs; }
+	int64 GetUsedArea() const { return UsedArea; }
+	int32 GetSize() const { return Size; }
+
+	// Randomized alloc/free run that checks live rects never overlap or leave the
+	// page, and that freeing everything gives the whole page back.
+	static bool SelfTest(FString& OutError);
+
+private:
+	struct FSpan
+	{
+		int32	Start;
+		int32	Length;
+	};
+	static int32 AllocSpan(TArray<FSpan>& Spans, int32 Length);
+	static void FreeSpan(TArray<FSpan>& Spans, int32 Start, int32 Length);
+
+	struct FShelf
+	{
+		int32			Y;
+		int32			Height;
+		int32			NumAllocs = 0;
+		TArray<FSpan>	FreeSpans;
+	};
+	bool AllocInShelf(FShelf& Shelf, int32 Width, FIntPoint& OutPos);
+
+	TArray<FShelf>	Shelves;		// sorted by Y
+	TArray<FSpan>	FreeBands;		// vertical ranges not owned by any shelf
+	int32			Size = 0;
+	int32			NumAllocs = 0;
+	int64			UsedArea = 0;
+};
+
+// Packs small generated textures (font-effect layers, box-shadows, gradients baked
+// by RmlUi) into shared UTexture2D pages. A packed texture is an FRmlTextureEntry
+// whose AtlasPage points at the page entry that actually gets bound; the drawer
+// remaps its UVs with AtlasUVRect. Draws of different packed textures on the same
+// page share a texture binding and can be merged into one draw call.
+//
+// Not thread-safe; FUERmlRenderResources only touches it under its lock. Regions must
+// only be freed once no in-flight drawer can still sample them — FUERmlRenderResources
+// does that from its frame fence.
+class FRmlTextureAtlas
+{
+public:
+	FRmlTextureAtlas(int32 InPageSize, int32 InMaxTextureSize);
+
+	bool CanPack(Rml::Vector2i Dimensions) const;
+
+	// Copy the premultiplied RGBA8 pixels into a page (a new one if none has room).
+	TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe> Add(Rml::Span<const Rml::byte> Source, Rml::Vector2i Dimensions);
+
+	// Return the entry's region to its page. Empty pages beyond the first are evicted;
+	// the page texture itself lives on until the last entry referencing it is gone.
+	void Remove(const FRmlTextureEntry& Entry);
+
+	int32 GetNumPages() const { return Pages.Num(); }
+	int32 GetNumPacked() const;
+	int32 GetPageSize() const { return PageSize; }
+
+private:
+	struct FPage
+	{
+		TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>	Entry;
+		FRmlAtlasPacker										Packer;
+	};
+	FPage& AddPage();
+
+	TArray<FPage>	Pages;
+	int32			PageSize;
+	int32			MaxTextureSize;
+
+	// Border around every packed texture, filled by extruding its edge texels so
+	// bilinear sampling at the edges never reads a neighbour.
+	static constexpr int32 Padding = 1;
+};
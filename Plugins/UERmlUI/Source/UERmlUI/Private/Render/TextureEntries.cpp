@@ -3,6 +3,7 @@
 #include "Engine/TextureRenderTarget2D.h"
 #include "TextureResource.h"
 #include "RHICommandList.h"
+#include "RenderUtils.h"
 
 FRmlTextureEntry::FRmlTextureEntry(UTexture* InTexture, FString InTexturePath)
 	: BoundTexture(InTexture)
@@ -20,7 +21,8 @@ FRHITexture* FRmlTextureEntry::GetTextureRHI()
 {
 	if (OverrideRHI.IsValid())
 		return OverrideRHI.GetReference();
-	if (!BoundTexture) return nullptr;
+	// Nothing bound yet (async load still decoding): draw transparent.
+	if (!BoundTexture) return GBlackTransparentTexture->TextureRHI.GetReference();
 	FTextureResource* Res = BoundTexture->GetResource();
 	if (!Res) return nullptr;
 	return Res->TextureRHI.GetReference();
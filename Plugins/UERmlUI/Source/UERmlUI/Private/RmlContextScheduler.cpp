@@ -0,0 +1,86 @@
+#include "RmlContextScheduler.h"
+#include "RmlUiSettings.h"
+#include "Async/ParallelFor.h"
+#include "Framework/Application/SlateApplication.h"
+#include "RmlUi/Core/Context.h"
+
+DECLARE_STATS_GROUP(TEXT("RmlUI_Game"), STATGROUP_RmlUI_Game, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("RmlUI Parallel Context Update"), STAT_RmlUI_ParallelContextUpdate, STATGROUP_RmlUI_Game);
+DECLARE_CYCLE_STAT(TEXT("RmlUI Context Update Task"),     STAT_RmlUI_ContextUpdateTask,     STATGROUP_RmlUI_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RmlUI Batched Contexts"), STAT_RmlUI_BatchedContexts,     STATGROUP_RmlUI_Game);
+
+FRmlContextScheduler& FRmlContextScheduler::Get()
+{
+	static FRmlContextScheduler Instance;
+	return Instance;
+}
+
+void FRmlContextScheduler::Register(Rml::Context* Context)
+{
+	check(IsInGameThread());
+	if (!Context)
+		return;
+	Entries.FindOrAdd(Context);
+
+	if (!PreTickHandle.IsValid() && FSlateApplication::IsInitialized())
+		PreTickHandle = FSlateApplication::Get().OnPreTick().AddRaw(this, &FRmlContextScheduler::OnSlatePreTick);
+}
+
+void FRmlContextScheduler::Unregister(Rml::Context* Context)
+{
+	check(IsInGameThread());
+	Entries.Remove(Context);
+}
+
+bool FRmlContextScheduler::ConsumeBatchedUpdate(Rml::Context* Context)
+{
+	FEntry* Entry = Entries.Find(Context);
+	if (!Entry)
+		return false;
+	Entry->LastTickFrame = GFrameCounter;
+	return Entry->LastBatchFrame == GFrameCounter;
+}
+
+void FRmlContextScheduler::UpdateContexts(TArrayView<Rml::Context* const> Contexts)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RmlUI_ParallelContextUpdate);
+	INC_DWORD_STAT_BY(STAT_RmlUI_BatchedContexts, Contexts.Num());
+
+	// One context per task: a context is the unit that shares no elements with the others.
+	ParallelFor(Contexts.Num(), [Contexts](int32 Index)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RmlUI_ContextUpdateTask);
+		Contexts[Index]->Update();
+	});
+}
+
+void FRmlContextScheduler::Shutdown()
+{
+	if (PreTickHandle.IsValid() && FSlateApplication::IsInitialized())
+		FSlateApplication::Get().OnPreTick().Remove(PreTickHandle);
+	PreTickHandle.Reset();
+	Entries.Reset();
+}
+
+void FRmlContextScheduler::OnSlatePreTick(float DeltaTime)
+{
+	if (!URmlUiSettings::Get()->bParallelContextUpdate)
+		return;
+
+	// Only contexts whose widget is still ticking: hidden widgets are not ticked by Slate
+	// and their contexts should not advance either.
+	TArray<Rml::Context*, TInlineAllocator<16>> Batch;
+	for (const TPair<Rml::Context*, FEntry>& Pair : Entries)
+	{
+		if (Pair.Value.LastTickFrame + 1 >= GFrameCounter)
+			Batch.Add(Pair.Key);
+	}
+
+	// A single context gains nothing over updating it in its widget's Tick.
+	if (Batch.Num() < 2)
+		return;
+
+	UpdateContexts(Batch);
+	for (Rml::Context* Context : Batch)
+		Entries[Context].LastBatchFrame = GFrameCounter;
+}
@@ -1,4 +1,5 @@
 ﻿#include "RmlDocument.h"
+#include "RmlContextScheduler.h"
 #include "RmlUi/Core.h"
 
 bool URmlDocument::Init(Rml::Context* InCtx, const FString& InDocPath)
@@ -37,6 +38,9 @@ bool URmlDocument::Init(Rml::Context* InCtx, const FString& InDocPath)
 
 	BoundContext = InCtx;
 
+	// ProcessEvent calls into Blueprint, so the context must not be updated on a worker.
+	FRmlContextScheduler::Get().Unregister(InCtx);
+
 	OnInit();
 
 	return true;
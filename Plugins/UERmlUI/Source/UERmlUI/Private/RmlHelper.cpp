@@ -2,6 +2,8 @@
 #include "IImageWrapperModule.h"
 #include "IImageWrapper.h"
 #include "TextureResource.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
 #include "RmlUi/Core.h"
 #include "Logging.h"
 
@@ -161,37 +163,110 @@ UTexture2D* FRmlHelper::LoadTextureFromRaw(const uint8* InSource, FIntPoint InSi
 
 UTexture2D* FRmlHelper::LoadTextureFromFile(const FString& InFilePath)
 {
-	TArray64<uint8>* Data = new TArray64<uint8>();
-	FFileHelper::LoadFileToArray(*Data, *InFilePath);
-	if (Data->Num() == 0) { delete Data; return nullptr; }
-
 	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
-	EImageFormat ImageFormat = ImageWrapperModule.DetectImageFormat(Data->GetData(), Data->Num());
-	if (ImageFormat == EImageFormat::Invalid) { delete Data; return nullptr; }
 
-	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(ImageFormat);
-	if (!ImageWrapper->SetCompressed(Data->GetData(), Data->Num())) { delete Data; return nullptr; }
+	TArray64<uint8> Pixels;
+	FIntPoint Size;
+	if (!DecodeImageFile(ImageWrapperModule, InFilePath, Pixels, Size))
+		return nullptr;
+	return CreateTextureFromPixels(MoveTemp(Pixels), Size);
+}
+
+bool FRmlHelper::DecodeImageFile(IImageWrapperModule& InImageWrapperModule, const FString& InFilePath, TArray64<uint8>& OutPixels, FIntPoint& OutSize)
+{
+	TArray64<uint8> Data;
+	FFileHelper::LoadFileToArray(Data, *InFilePath);
+	if (Data.Num() == 0) return false;
 
-	FIntPoint Size(ImageWrapper->GetWidth(), ImageWrapper->GetHeight());
-	ImageWrapper->GetRaw(ERGBFormat::RGBA, 8, *Data);
+	EImageFormat ImageFormat = InImageWrapperModule.DetectImageFormat(Data.GetData(), Data.Num());
+	if (ImageFormat == EImageFormat::Invalid) return false;
+
+	TSharedPtr<IImageWrapper> ImageWrapper = InImageWrapperModule.CreateImageWrapper(ImageFormat);
+	if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(Data.GetData(), Data.Num())) return false;
+
+	OutSize = FIntPoint(ImageWrapper->GetWidth(), ImageWrapper->GetHeight());
+	return ImageWrapper->GetRaw(ERGBFormat::RGBA, 8, OutPixels);
+}
 
-	UTexture2D* LoadedTexture = UTexture2D::CreateTransient(Size.X, Size.Y, EPixelFormat::PF_R8G8B8A8);
+UTexture2D* FRmlHelper::CreateTextureFromPixels(TArray64<uint8>&& InPixels, FIntPoint InSize)
+{
+	check(InPixels.Num() >= (int64)InSize.X * InSize.Y * 4);
+
+	UTexture2D* LoadedTexture = UTexture2D::CreateTransient(InSize.X, InSize.Y, EPixelFormat::PF_R8G8B8A8);
 	LoadedTexture->SRGB = false;
 	LoadedTexture->Filter = TF_Bilinear;
 	LoadedTexture->NeverStream = true;
 	LoadedTexture->UpdateResource();
 
-	FUpdateTextureRegion2D* TextureRegion = new FUpdateTextureRegion2D(0, 0, 0, 0, Size.X, Size.Y);
+	FUpdateTextureRegion2D* TextureRegion = new FUpdateTextureRegion2D(0, 0, 0, 0, InSize.X, InSize.Y);
 
+	// The region update runs on the render thread — hand it the buffer.
+	TArray64<uint8>* Data = new TArray64<uint8>(MoveTemp(InPixels));
 	auto DataCleanup = [FileData=Data](uint8* Data, const FUpdateTextureRegion2D* UpdateRegion)
 	{
 		delete FileData;
 		delete UpdateRegion;
 	};
-	LoadedTexture->UpdateTextureRegions(0, 1u, TextureRegion, 4 * Size.X, 4, Data->GetData(), DataCleanup);
+	LoadedTexture->UpdateTextureRegions(0, 1u, TextureRegion, 4 * InSize.X, 4, Data->GetData(), DataCleanup);
 	return LoadedTexture;
 }
 
+bool FRmlHelper::ProbeImageSize(const FString& InFilePath, FIntPoint& OutSize)
+{
+	// Headers (including JPEG EXIF/ICC segments before the frame header) normally
+	// fit well inside this; anything longer falls back to a full decode.
+	constexpr int64 MaxHeaderBytes = 64 * 1024;
+
+	TUniquePtr<IFileHandle> File(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*InFilePath));
+	if (!File) return false;
+
+	TArray<uint8> Header;
+	Header.SetNumUninitialized((int32)FMath::Min(File->Size(), MaxHeaderBytes));
+	if (Header.Num() < 26 || !File->Read(Header.GetData(), Header.Num())) return false;
+
+	const uint8* B = Header.GetData();
+	const int32 N = Header.Num();
+	auto BE16 = [B](int32 i) { return (int32(B[i]) << 8) | B[i + 1]; };
+	auto BE32 = [B](int32 i) { return (int32(B[i]) << 24) | (int32(B[i + 1]) << 16) | (int32(B[i + 2]) << 8) | B[i + 3]; };
+	auto LE32 = [B](int32 i) { return int32(B[i]) | (int32(B[i + 1]) << 8) | (int32(B[i + 2]) << 16) | (int32(B[i + 3]) << 24); };
+
+	// PNG: signature, then the IHDR chunk with big-endian width/height.
+	static const uint8 PngSignature[8] = { 0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A };
+	if (FMemory::Memcmp(B, PngSignature, 8) == 0 && FMemory::Memcmp(B + 12, "IHDR", 4) == 0)
+	{
+		OutSize = FIntPoint(BE32(16), BE32(20));
+		return OutSize.X > 0 && OutSize.Y > 0;
+	}
+
+	// BMP: BITMAPINFOHEADER width/height (height is negative for top-down bitmaps).
+	if (B[0] == 'B' && B[1] == 'M')
+	{
+		OutSize = FIntPoint(LE32(18), FMath::Abs(LE32(22)));
+		return OutSize.X > 0 && OutSize.Y > 0;
+	}
+
+	// JPEG: walk the marker segments up to the first start-of-frame.
+	if (B[0] == 0xFF && B[1] == 0xD8)
+	{
+		int32 i = 2;
+		while (i + 9 < N)
+		{
+			if (B[i] != 0xFF) return false;
+			const uint8 Marker = B[i + 1];
+			if (Marker == 0xFF) { ++i; continue; }	// fill byte
+
+			const bool bIsFrame = Marker >= 0xC0 && Marker <= 0xCF && Marker != 0xC4 && Marker != 0xC8 && Marker != 0xCC;
+			if (bIsFrame)
+			{
+				OutSize = FIntPoint(BE16(i + 7), BE16(i + 5));
+				return OutSize.X > 0 && OutSize.Y > 0;
+			}
+			i += 2 + BE16(i + 2);
+		}
+	}
+	return false;
+}
+
 UTexture2D* FRmlHelper::LoadTextureFromAsset(const FString& InAssetPath, UObject* InOuter)
 {
 	UObject* LoadedObj = StaticLoadObject(UObject::StaticClass(), InOuter, *InAssetPath);
@@ -235,6 +310,7 @@ void FRmlHelper::PrecacheFontEffects(const FString& RmlContent)
 	Rml::ElementDocument* Doc = Ctx->LoadDocumentFromMemory(TCHAR_TO_UTF8(*RmlContent));
 	if (Doc)
 	{
+		Ctx->GetRenderManager().SetCallbackTextureBudget(-1.0);
 		Doc->Show();
 		Ctx->Update();
 		Ctx->Render();
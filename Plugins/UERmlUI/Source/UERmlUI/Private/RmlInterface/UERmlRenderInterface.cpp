@@ -2,67 +2,59 @@
 #include "Rendering/DrawElements.h"
 #include "Render/RmlDrawer.h"
 #include "Render/RmlMesh.h"
-#include "RmlUiSettings.h"
 #include "RmlWarmer.h"
 #include "RmlUi/Core.h"
 #include "RmlUi/Core/Context.h"
 #include "RmlUi/Core/ElementDocument.h"
-#include "RmlHelper.h"
 #include "Logging.h"
-#include "Engine/Texture2D.h"
-#include "Misc/Paths.h"
 
 DECLARE_STATS_GROUP(TEXT("RmlUI_Interface"), STATGROUP_RmlUI_Interface, STATCAT_Advanced);
-DECLARE_CYCLE_STAT(TEXT("RmlUI CompileGeometry"), STAT_RmlUI_CompileGeometry, STATGROUP_RmlUI_Interface);
-DECLARE_CYCLE_STAT(TEXT("RmlUI ReleaseGeometry"), STAT_RmlUI_ReleaseGeometry, STATGROUP_RmlUI_Interface);
 DECLARE_CYCLE_STAT(TEXT("RmlUI RenderGeometry"),  STAT_RmlUI_RenderGeometry,  STATGROUP_RmlUI_Interface);
+DECLARE_CYCLE_STAT(TEXT("RmlUI Retained Replay"),   STAT_RmlUI_RetainedReplay,  STATGROUP_RmlUI_Interface);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RmlUI Retained Document Hits"),   STAT_RmlUI_RetainedHits,   STATGROUP_RmlUI_Interface);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RmlUI Retained Document Misses"), STAT_RmlUI_RetainedMisses, STATGROUP_RmlUI_Interface);
 
 FUERmlRenderInterface::FUERmlRenderInterface()
-	: AdditionRenderMatrix(FMatrix44f::Identity)
+	: SharedResources(FUERmlRenderResources::Get())
+	, AdditionRenderMatrix(FMatrix44f::Identity)
 	, bCustomMatrix(false)
 	, bUseClipRect(false)
 {
 }
 
-bool FUERmlRenderInterface::SetTexture(FString Path, UTexture* InTexture, bool bAddIfNotExist)
+void FUERmlRenderInterface::ResetRecorder()
 {
-	if (auto* FoundTexture = AllTextures.Find(Path))
-	{
-		(*FoundTexture)->BoundTexture = InTexture;
-		return true;
-	}
-
-	if (bAddIfNotExist)
-	{
-		AllTextures.Add(Path, MakeShared<FRmlTextureEntry, ESPMode::ThreadSafe>(InTexture));
-		return true;
-	}
-
-	return false;
+	check(!CurrentDrawer.IsValid());
+	RetainedDocuments.Reset();
+	RecordingDocument = nullptr;
+	FrameDocuments.Reset();
+	AdditionRenderMatrix = FMatrix44f::Identity;
+	bCustomMatrix = false;
+	bUseClipRect = false;
+	LayerCounter = 0;
+	WarmupTextureCount = 0;
 }
 
 void FUERmlRenderInterface::EndRender(FSlateWindowElementList& InCurrentElementList, uint32 InCurrentLayer)
 {
+	if (CurrentCachedLayer.IsValid())
+		UpdateCachedLayer();
 	FSlateDrawElement::MakeCustom(InCurrentElementList, InCurrentLayer, CurrentDrawer);
 	CurrentDrawer.Reset();
+	CurrentCachedLayer.Reset();
 	CurrentContext = nullptr;
+	PruneRetainedDocuments();
 }
 
 // ============================================================================
 // Helpers
 // ============================================================================
 
-FMatrix44f FUERmlRenderInterface::ComputeNDCMatrix(Rml::Vector2f translation) const
+FMatrix44f FUERmlRenderInterface::ComputeBaseMatrix() const
 {
-	FMatrix44f Matrix = FMatrix44f::Identity;
-	Matrix.M[3][0] = translation.x;
-	Matrix.M[3][1] = translation.y;
-
-	if (bCustomMatrix)
-		Matrix *= AdditionRenderMatrix;
-
-	Matrix *= RmlRenderMatrix;
-	return Matrix;
+	// The per-draw translation is applied by the drawer (T(translation) * Base),
+	// so this only changes on SetTransform / BeginRender.
+	return bCustomMatrix ? AdditionRenderMatrix * RmlRenderMatrix : RmlRenderMatrix;
 }
 
 FIntRect FUERmlRenderInterface::ComputeScissorRect() const
@@ -79,6 +71,20 @@ FIntRect FUERmlRenderInterface::ComputeScissorRect() const
 	return Result;
 }
 
+int32 FUERmlRenderInterface::GetTransformState()
+{
+	if (TransformState == INDEX_NONE)
+		TransformState = CurrentDrawer->InternTransform(ComputeBaseMatrix());
+	return TransformState;
+}
+
+int32 FUERmlRenderInterface::GetScissorState()
+{
+	if (ScissorState == INDEX_NONE)
+		ScissorState = CurrentDrawer->InternScissor(ComputeScissorRect());
+	return ScissorState;
+}
+
 // ============================================================================
 // Required: geometry
 // ============================================================================
@@ -87,12 +93,7 @@ Rml::CompiledGeometryHandle FUERmlRenderInterface::CompileGeometry(
 	Rml::Span<const Rml::Vertex> vertices,
 	Rml::Span<const int> indices)
 {
-	SCOPE_CYCLE_COUNTER(STAT_RmlUI_CompileGeometry);
-	TSharedPtr<FRmlMesh, ESPMode::ThreadSafe> Mesh = MakeShared<FRmlMesh, ESPMode::ThreadSafe>();
-	Mesh->Setup(vertices, indices);
-
-	Meshes.Add(Mesh.Get(), Mesh);
-	return reinterpret_cast<Rml::CompiledGeometryHandle>(Mesh.Get());
+	return SharedResources.CompileGeometry(vertices, indices);
 }
 
 void FUERmlRenderInterface::RenderGeometry(
@@ -101,18 +102,27 @@ void FUERmlRenderInterface::RenderGeometry(
 	Rml::TextureHandle texture)
 {
 	SCOPE_CYCLE_COUNTER(STAT_RmlUI_RenderGeometry);
+	if (FRetainedCall* Call = RecordCall(ERetainedCall::RenderGeometry))
+	{
+		Call->Geometry    = geometry;
+		Call->Texture     = texture;
+		Call->Translation = translation;
+		RetainResource(geometry);
+		RetainResource(texture);
+		RetainBounds(geometry, translation);
+	}
 	if (!CurrentDrawer.IsValid()) return;	// prewarm mode — no drawer
 
-	FRmlTextureEntryPtr TextureRef;
-	if (texture)
-		TextureRef = reinterpret_cast<FRmlTextureEntry*>(texture)->AsShared();
+	FRmlTextureEntry* Texture = SharedResources.ResolveTexture(texture);
+	if (texture && !Texture) return;	// stale handle — already warned in ResolveTexture
+	NoteTextureDrawn(Texture);
 
 	// Saved-layer textures (box-shadow, drop-shadow) are cached at physical pixel
 	// resolution. When rendered back as a quad, the logical translation × DPI scale
 	// often lands at a fractional physical pixel position, causing bilinear sampling
 	// to smear every texel.  Snap the translation to the nearest physical pixel so
 	// the texture maps 1:1 without interpolation artifacts.
-	if (TextureRef && TextureRef->bIsSavedLayer)
+	if (Texture && Texture->bIsSavedLayer)
 	{
 		FVector2f PhysPos = RmlWidgetRenderTransform.TransformPoint(
 			FVector2f(translation.x, translation.y));
@@ -123,23 +133,23 @@ void FUERmlRenderInterface::RenderGeometry(
 		translation.y = Snapped.Y;
 	}
 
-	FMatrix44f Matrix = ComputeNDCMatrix(translation);
-	FIntRect ScissorRect = ComputeScissorRect();
+	FRmlMesh* Mesh = reinterpret_cast<FRmlMesh*>(geometry);
+	if (Mesh->bNeedsMultisampling)
+		CurrentDrawer->MarkNeedsMultisampling();
 
 	CurrentDrawer->EmplaceMesh(
-		reinterpret_cast<FRmlMesh*>(geometry)->AsShared(),
-		MoveTemp(TextureRef),
-		Matrix,
-		ScissorRect);
+		Mesh,
+		Texture,
+		GetTransformState(),
+		FVector2f(translation.x, translation.y),
+		GetScissorState());
 }
 
 void FUERmlRenderInterface::ReleaseGeometry(Rml::CompiledGeometryHandle geometry)
 {
-	SCOPE_CYCLE_COUNTER(STAT_RmlUI_ReleaseGeometry);
 	if (!geometry) return;
-	// O(1) hash map lookup — was O(N) linear search causing O(N²) per frame
-	// when the benchmark destroys all ~1000 meshes each SetInnerRML call.
-	Meshes.Remove(reinterpret_cast<FRmlMesh*>(geometry));
+	InvalidateRetained(geometry);
+	SharedResources.ReleaseGeometry(geometry);
 }
 
 // ============================================================================
@@ -150,47 +160,22 @@ Rml::TextureHandle FUERmlRenderInterface::LoadTexture(
 	Rml::Vector2i& texture_dimensions,
 	const Rml::String& source)
 {
-	FString SourcePath(source.c_str());
-	FString ResolvedFilePath = SourcePath;
-	if (!SourcePath.StartsWith(TEXT("/")) && FPaths::IsRelative(SourcePath))
-	{
-		ResolvedFilePath = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / SourcePath);
-	}
-	// ResolvedFilePath == SourcePath for asset paths (/Game/...) — safe to use as cache key always.
-
-	auto FoundTexture = AllTextures.Find(ResolvedFilePath);
-	if (FoundTexture)
-	{
-		texture_dimensions.x = (*FoundTexture)->BoundTexture->GetSurfaceWidth();
-		texture_dimensions.y = (*FoundTexture)->BoundTexture->GetSurfaceHeight();
-		return reinterpret_cast<Rml::TextureHandle>((*FoundTexture).Get());
-	}
-
-	// Cache miss — determine load method (filesystem I/O only on first load).
-	const bool bIsFilePath = FPlatformFileManager::Get().GetPlatformFile().FileExists(*ResolvedFilePath);
-
-	UTexture2D* LoadedTexture = bIsFilePath
-		? FRmlHelper::LoadTextureFromFile(ResolvedFilePath)
-		: FRmlHelper::LoadTextureFromAsset(SourcePath);
-
-	if (!LoadedTexture) return 0;
-
-	auto& AddedTexture = AllTextures.Add(ResolvedFilePath, MakeShared<FRmlTextureEntry, ESPMode::ThreadSafe>(LoadedTexture, ResolvedFilePath));
-	AddedTexture->bPremultiplied = false;
-	AddedTexture->bWrapSampler = true;	// Both file and asset textures must support wrapped sampling in decorators.
-	texture_dimensions.x = LoadedTexture->GetSurfaceWidth();
-	texture_dimensions.y = LoadedTexture->GetSurfaceHeight();
-	return reinterpret_cast<Rml::TextureHandle>(AddedTexture.Get());
+	return SharedResources.LoadTexture(texture_dimensions, source);
 }
 
 Rml::TextureHandle FUERmlRenderInterface::GenerateTexture(
 	Rml::Span<const Rml::byte> source,
 	Rml::Vector2i source_dimensions)
 {
+	// CurrentDrawer set = live frame, not warmup.
+	const bool bLive = CurrentDrawer.IsValid();
+	if (!bLive)
+		++WarmupTextureCount;
+
 #if !UE_BUILD_SHIPPING
 	// Capture mode: record all loaded document URLs from the active context
-	// whenever a live texture is generated (CurrentDrawer set = live, not warmup).
-	if (CurrentDrawer.IsValid() && CurrentContext && FRmlWarmer::IsCaptureEnabled())
+	// whenever a live texture is generated.
+	if (bLive && CurrentContext && FRmlWarmer::IsCaptureEnabled())
 	{
 		const int32 NumDocs = CurrentContext->GetNumDocuments();
 		for (int32 i = 0; i < NumDocs; ++i)
@@ -201,163 +186,14 @@ Rml::TextureHandle FUERmlRenderInterface::GenerateTexture(
 	}
 #endif
 
-	// Dimension-based texture pool: when RmlUI's UpdateLayersOnDirty releases and
-	// re-creates font-effect textures, the new textures often have the same dimensions.
-	// Reusing a pooled UTexture2D avoids the expensive CreateTransient + UpdateResource
-	// path — only the pixel data upload (memcpy + RHI update) remains.
-	const uint64 DimKey = (static_cast<uint64>(source_dimensions.x) << 32)
-						| static_cast<uint64>(source_dimensions.y);
-
-	if (auto* Pool = TextureDimensionPool.Find(DimKey))
-	{
-		if (Pool->Num() > 0)
-		{
-			auto Reused = Pool->Pop();
-			UTexture2D* Tex = Cast<UTexture2D>(Reused->BoundTexture.Get());
-			if (Tex)
-			{
-				// Upload new pixel data into the existing GPU resource (cheap).
-				const int32 DataSize = source_dimensions.x * source_dimensions.y * 4;
-				uint8* DataCopy = new uint8[DataSize];
-				FMemory::Memcpy(DataCopy, source.data(), DataSize);
-				auto* Region = new FUpdateTextureRegion2D(0, 0, 0, 0, source_dimensions.x, source_dimensions.y);
-				Tex->UpdateTextureRegions(0, 1u, Region, 4 * source_dimensions.x, 4, DataCopy,
-					[](uint8* D, const FUpdateTextureRegion2D* R) { delete[] D; delete R; });
-			}
-
-			auto& Entry = AllCreatedTextures.Add_GetRef(Reused);
-
-			if (CurrentDrawer.IsValid())
-			{
-				UE_LOG(LogUERmlUI, Log, TEXT("GenerateTexture %dx%d [POOL HIT - instant] cached=%d pool=%d"),
-					source_dimensions.x, source_dimensions.y, AllCreatedTextures.Num(), Pool->Num());
-			}
-			else
-			{
-				++WarmupTextureCount;
-			}
-			return reinterpret_cast<Rml::TextureHandle>(Entry.Get());
-		}
-	}
-
-	// Pool empty for this dimension — create a new UTexture2D.
-	UTexture2D* Texture = FRmlHelper::LoadTextureFromRaw(
-		(const uint8*)source.data(),
-		FIntPoint(source_dimensions.x, source_dimensions.y));
-
-	auto& Entry = AllCreatedTextures.Add_GetRef(MakeShared<FRmlTextureEntry, ESPMode::ThreadSafe>(Texture));
-	Entry->bPremultiplied = true;
-
-	if (CurrentDrawer.IsValid())
-	{
-		UE_LOG(LogUERmlUI, Log, TEXT("GenerateTexture %dx%d [LIVE - no pool] cached=%d"),
-			source_dimensions.x, source_dimensions.y, AllCreatedTextures.Num());
-	}
-	else
-	{
-		++WarmupTextureCount;
-		UE_LOG(LogUERmlUI, Verbose, TEXT("GenerateTexture %dx%d [warmup] cached=%d"),
-			source_dimensions.x, source_dimensions.y, AllCreatedTextures.Num());
-	}
-
-	return reinterpret_cast<Rml::TextureHandle>(Entry.Get());
+	return SharedResources.GenerateTexture(source, source_dimensions, bLive);
 }
 
 void FUERmlRenderInterface::ReleaseTexture(Rml::TextureHandle texture)
 {
 	if (!texture) return;
-
-	FRmlTextureEntry* RawPtr = reinterpret_cast<FRmlTextureEntry*>(texture);
-
-	// Check generated textures — pool them instead of destroying.
-	for (int32 i = AllCreatedTextures.Num() - 1; i >= 0; --i)
-	{
-		if (AllCreatedTextures[i].Get() == RawPtr)
-		{
-			auto Entry = AllCreatedTextures[i];
-			AllCreatedTextures.RemoveAtSwap(i);
-
-			// Pool the entry for future reuse (FGCObject prevents UTexture2D from being GC'd).
-			UTexture2D* Tex = Cast<UTexture2D>(Entry->BoundTexture.Get());
-			if (Tex)
-			{
-				const uint64 Key = (static_cast<uint64>(Tex->GetSizeX()) << 32)
-								 | static_cast<uint64>(Tex->GetSizeY());
-				TextureDimensionPool.FindOrAdd(Key).Add(Entry);
-				UE_LOG(LogUERmlUI, Verbose, TEXT("ReleaseTexture %dx%d → pooled  cached=%d pool=%d"),
-					(int32)Tex->GetSizeX(), (int32)Tex->GetSizeY(),
-					AllCreatedTextures.Num(), TextureDimensionPool[Key].Num());
-			}
-			return;
-		}
-	}
-
-	// Validate against known loaded (file/asset) textures.
-	for (auto It = AllTextures.CreateIterator(); It; ++It)
-	{
-		if (It->Value.Get() == RawPtr)
-		{
-			It.RemoveCurrent();
-			return;
-		}
-	}
-
-	UE_LOG(LogUERmlUI, Warning, TEXT("ReleaseTexture: handle 0x%llX not found — already released or stale"), (uint64)texture);
-}
-
-// ============================================================================
-// Texture pre-allocation
-// ============================================================================
-
-void FUERmlRenderInterface::PreallocateTextureReserves()
-{
-	// Count textures per dimension from warmup results.
-	TMap<uint64, int32> ObservedDims;
-	for (const auto& Entry : AllCreatedTextures)
-	{
-		if (UTexture2D* Tex = Cast<UTexture2D>(Entry->BoundTexture.Get()))
-		{
-			const uint64 Key = (static_cast<uint64>(Tex->GetSizeX()) << 32)
-							 | static_cast<uint64>(Tex->GetSizeY());
-			ObservedDims.FindOrAdd(Key, 0)++;
-		}
-	}
-
-	int32 TotalCreated = 0;
-	for (auto& Pair : ObservedDims)
-	{
-		const int32 Width  = static_cast<int32>(Pair.Key >> 32);
-		const int32 Height = static_cast<int32>(Pair.Key & 0xFFFFFFFF);
-
-		auto& Pool = TextureDimensionPool.FindOrAdd(Pair.Key);
-		const int32 ToAdd = FMath::Max(0, Pair.Value - Pool.Num());
-
-		for (int32 i = 0; i < ToAdd; ++i)
-		{
-			// Match LoadTextureFromRaw settings exactly.
-			UTexture2D* Tex = UTexture2D::CreateTransient(Width, Height, PF_R8G8B8A8);
-			Tex->SRGB = false;
-			Tex->Filter = TF_Bilinear;
-			Tex->NeverStream = true;
-			Tex->UpdateResource();
-
-			auto NewEntry = MakeShared<FRmlTextureEntry, ESPMode::ThreadSafe>(Tex);
-			NewEntry->bPremultiplied = true;
-			Pool.Add(NewEntry);
-			++TotalCreated;
-		}
-
-		UE_LOG(LogUERmlUI, Log, TEXT("PreallocateTextureReserves: %dx%d → %d reserves (observed %d active)"),
-			Width, Height, Pool.Num(), Pair.Value);
-	}
-
-	if (TotalCreated > 0)
-	{
-		FlushRenderingCommands();
-	}
-
-	UE_LOG(LogUERmlUI, Log, TEXT("PreallocateTextureReserves: created %d reserve textures across %d dimensions"),
-		TotalCreated, ObservedDims.Num());
+	InvalidateRetained(texture);
+	SharedResources.ReleaseTexture(texture);
 }
 
 // ============================================================================
@@ -366,16 +202,22 @@ void FUERmlRenderInterface::PreallocateTextureReserves()
 
 void FUERmlRenderInterface::EnableScissorRegion(bool enable)
 {
+	if (FRetainedCall* Call = RecordCall(ERetainedCall::EnableScissor))
+		Call->Arg = enable;
 	bUseClipRect = enable;
+	ScissorState = INDEX_NONE;
 }
 
 void FUERmlRenderInterface::SetScissorRegion(Rml::Rectanglei region)
 {
+	if (FRetainedCall* Call = RecordCall(ERetainedCall::SetScissor))
+		Call->Region = region;
 	ClipRect = FSlateRect(
 		(float)FMath::Max(region.Left(), 0),
 		(float)FMath::Max(region.Top(), 0),
 		(float)region.Right(),
 		(float)region.Bottom());
+	ScissorState = INDEX_NONE;
 }
 
 // ============================================================================
@@ -384,6 +226,11 @@ void FUERmlRenderInterface::SetScissorRegion(Rml::Rectanglei region)
 
 void FUERmlRenderInterface::SetTransform(const Rml::Matrix4f* transform)
 {
+	if (FRetainedCall* Call = RecordCall(ERetainedCall::SetTransform))
+	{
+		if (transform)
+			Call->Slot = RecordingDocument->Transforms.Add(*transform);
+	}
 	if (transform)
 	{
 		FMemory::Memcpy(&AdditionRenderMatrix, transform->data(), sizeof(float) * 16);
@@ -394,6 +241,7 @@ void FUERmlRenderInterface::SetTransform(const Rml::Matrix4f* transform)
 		AdditionRenderMatrix = FMatrix44f::Identity;
 		bCustomMatrix = false;
 	}
+	TransformState = INDEX_NONE;
 }
 
 // ============================================================================
@@ -402,6 +250,8 @@ void FUERmlRenderInterface::SetTransform(const Rml::Matrix4f* transform)
 
 void FUERmlRenderInterface::EnableClipMask(bool enable)
 {
+	if (FRetainedCall* Call = RecordCall(ERetainedCall::EnableClipMask))
+		Call->Arg = enable;
 	if (!CurrentDrawer.IsValid()) return;
 	UE_LOG(LogUERmlUI, Verbose, TEXT("EnableClipMask(%s)"), enable ? TEXT("true") : TEXT("false"));
 	CurrentDrawer->EmplaceEnableClipMask(enable);
@@ -409,6 +259,13 @@ void FUERmlRenderInterface::EnableClipMask(bool enable)
 
 void FUERmlRenderInterface::RenderToClipMask(Rml::ClipMaskOperation operation, Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation)
 {
+	if (FRetainedCall* Call = RecordCall(ERetainedCall::RenderToClipMask))
+	{
+		Call->Arg         = (uint8)operation;
+		Call->Geometry    = geometry;
+		Call->Translation = translation;
+		RetainResource(geometry);
+	}
 	if (!CurrentDrawer.IsValid()) return;
 
 	const TCHAR* OpStr;
@@ -420,14 +277,12 @@ void FUERmlRenderInterface::RenderToClipMask(Rml::ClipMaskOperation operation, R
 	}
 	UE_LOG(LogUERmlUI, Verbose, TEXT("RenderToClipMask(%s, geo=0x%p, trans=%.1f,%.1f)"), OpStr, (void*)geometry, translation.x, translation.y);
 
-	FMatrix44f Matrix = ComputeNDCMatrix(translation);
-	FIntRect ScissorRect = ComputeScissorRect();
-
 	CurrentDrawer->EmplaceRenderToClipMask(
 		operation,
-		reinterpret_cast<FRmlMesh*>(geometry)->AsShared(),
-		Matrix,
-		ScissorRect);
+		reinterpret_cast<FRmlMesh*>(geometry),
+		GetTransformState(),
+		FVector2f(translation.x, translation.y),
+		GetScissorState());
 }
 
 // ============================================================================
@@ -436,6 +291,7 @@ void FUERmlRenderInterface::RenderToClipMask(Rml::ClipMaskOperation operation, R
 
 Rml::LayerHandle FUERmlRenderInterface::PushLayer()
 {
+	RecordCall(ERetainedCall::PushLayer);
 	int32 NewLayerIndex = ++LayerCounter;
 	if (!CurrentDrawer.IsValid()) return (Rml::LayerHandle)NewLayerIndex;	// prewarm
 	UE_LOG(LogUERmlUI, Verbose, TEXT("PushLayer() -> %d"), NewLayerIndex);
@@ -445,6 +301,22 @@ Rml::LayerHandle FUERmlRenderInterface::PushLayer()
 
 void FUERmlRenderInterface::CompositeLayers(Rml::LayerHandle source, Rml::LayerHandle destination, Rml::BlendMode blend_mode, Rml::Span<const Rml::CompiledFilterHandle> filters)
 {
+	if (FRetainedCall* Call = RecordCall(ERetainedCall::CompositeLayers))
+	{
+		Call->Arg        = (uint8)blend_mode;
+		Call->Geometry   = source;
+		Call->Texture    = destination;
+		Call->Slot       = RecordingDocument->Filters.Num();
+		Call->NumFilters = (int32)filters.size();
+		for (Rml::CompiledFilterHandle Filter : filters)
+		{
+			RecordingDocument->Filters.Add(Filter);
+			RetainResource(Filter);
+		}
+		// Filters (blur, drop-shadow) draw outside the layer's geometry.
+		if (filters.size() > 0)
+			RecordingDocument->bUnbounded = true;
+	}
 	if (!CurrentDrawer.IsValid()) return;
 
 	UE_LOG(LogUERmlUI, Verbose, TEXT("CompositeLayers(src=%d, dst=%d, blend=%d, filters=%d)"),
@@ -456,12 +328,7 @@ void FUERmlRenderInterface::CompositeLayers(Rml::LayerHandle source, Rml::LayerH
 	// (e.g. box-shadow blur) would be removed from the map before the
 	// render thread can look them up.
 	TArray<TSharedPtr<FCompiledRmlFilter>> ResolvedFilters;
-	ResolvedFilters.Reserve(filters.size());
-	for (auto f : filters)
-	{
-		if (auto* Found = CompiledFilters.Find(f))
-			ResolvedFilters.Add(*Found);
-	}
+	SharedResources.ResolveFilters(filters, ResolvedFilters);
 
 	// Capture current scissor rect — RmlUI calls ApplyClippingRegion just before
 	// CompositeLayers, so the active scissor represents the intended composite region.
@@ -479,6 +346,7 @@ void FUERmlRenderInterface::CompositeLayers(Rml::LayerHandle source, Rml::LayerH
 
 void FUERmlRenderInterface::PopLayer()
 {
+	RecordCall(ERetainedCall::PopLayer);
 	--LayerCounter;
 	if (!CurrentDrawer.IsValid()) return;
 	UE_LOG(LogUERmlUI, Verbose, TEXT("PopLayer() -> counter=%d"), LayerCounter);
@@ -491,6 +359,11 @@ void FUERmlRenderInterface::PopLayer()
 
 Rml::TextureHandle FUERmlRenderInterface::SaveLayerAsTexture()
 {
+	// Snapshots create new resources on every call; replaying would redo the
+	// capture each frame, so the document is recorded again next frame instead.
+	if (RecordingDocument)
+		RecordingDocument->Invalidate();
+
 	// In prewarm mode (no active drawer) layer rendering has no effect, so we
 	// cannot produce a valid GPU texture.  Return 0 so the CallbackTexture does
 	// not cache a stale handle and retries the callback on the first live frame.
@@ -499,9 +372,10 @@ Rml::TextureHandle FUERmlRenderInterface::SaveLayerAsTexture()
 
 	// Pre-allocate a texture entry on the game thread. The render thread will
 	// fill in OverrideRHI with the actual GPU texture via ExecuteSaveLayerAsTexture.
-	auto& Entry = AllCreatedTextures.Add_GetRef(MakeShared<FRmlTextureEntry, ESPMode::ThreadSafe>());
+	auto Entry = MakeShared<FRmlTextureEntry, ESPMode::ThreadSafe>();
 	Entry->bPremultiplied = true;	// layer content is already premultiplied
 	Entry->bIsSavedLayer  = true;	// cached callback texture — needs pixel-aligned rendering
+	const Rml::TextureHandle Handle = SharedResources.AddSavedLayer(Entry);
 
 	FIntRect ScissorRect = ComputeScissorRect();
 
@@ -519,24 +393,26 @@ Rml::TextureHandle FUERmlRenderInterface::SaveLayerAsTexture()
 		IdealSize.Y = FMath::Max(1, FMath::RoundToInt(TransRect.Bottom - TransRect.Top));
 	}
 
-	CurrentDrawer->EmplaceSaveLayerAsTexture(Entry, ScissorRect, IdealSize);
+	CurrentDrawer->EmplaceSaveLayerAsTexture(Entry.Get(), ScissorRect, IdealSize);
 
 	UE_LOG(LogUERmlUI, Verbose, TEXT("SaveLayerAsTexture -> 0x%p  scissor=[%d,%d]-[%d,%d] ideal=%dx%d"),
 		(void*)Entry.Get(), ScissorRect.Min.X, ScissorRect.Min.Y, ScissorRect.Max.X, ScissorRect.Max.Y,
 		IdealSize.X, IdealSize.Y);
 
-	return reinterpret_cast<Rml::TextureHandle>(Entry.Get());
+	return Handle;
 }
 
 Rml::CompiledFilterHandle FUERmlRenderInterface::SaveLayerAsMaskImage()
 {
+	if (RecordingDocument)
+		RecordingDocument->Invalidate();
+
 	// Create a MaskImage filter whose MaskTexture will be filled by the render
 	// thread via ExecuteSaveLayerAsMaskImage.
 	auto Filter = MakeShared<FCompiledRmlFilter>();
 	Filter->Type = ERmlFilterType::MaskImage;
 
-	Rml::CompiledFilterHandle Handle = NextFilterHandle++;
-	CompiledFilters.Add(Handle, Filter);
+	Rml::CompiledFilterHandle Handle = SharedResources.AddFilter(Filter);
 
 	FCompiledRmlFilter* FilterPtr = &Filter.Get();
 	FIntRect ScissorRect = ComputeScissorRect();
@@ -558,158 +434,14 @@ Rml::CompiledFilterHandle FUERmlRenderInterface::SaveLayerAsMaskImage()
 
 Rml::CompiledFilterHandle FUERmlRenderInterface::CompileFilter(const Rml::String& name, const Rml::Dictionary& parameters)
 {
-	auto Filter = MakeShared<FCompiledRmlFilter>();
-
-	if (name == "opacity")
-	{
-		// NOTE: Do NOT return 0 for opacity(1). It would suppress PushLayer, breaking:
-		// 1. Layer isolation (stacking context) for elements like .boxshadow_trail that
-		//    use filter:opacity(1) specifically for correct box-shadow ink overflow clipping.
-		// 2. CSS animations that interpolate through opacity(1) at keyframe boundaries:
-		//    mismatched handle counts between keyframes corrupt interpolation.
-		// The render-time skip (BlendFactor >= 1.0 → break in ApplyFilters) is sufficient.
-		auto it = parameters.find("value");
-		Filter->Type = ERmlFilterType::Passthrough;
-		Filter->BlendFactor = (it != parameters.end()) ? it->second.Get<float>(1.0f) : 1.0f;
-	}
-	else if (name == "blur")
-	{
-		// RmlUI passes the Gaussian sigma directly as "sigma" (not "radius").
-		auto it = parameters.find("sigma");
-		Filter->Type = ERmlFilterType::Blur;
-		Filter->Sigma = (it != parameters.end()) ? it->second.Get<float>(0.0f) : 0.0f;
-		// NOTE: Do NOT return 0 for blur(0). RmlUI logs "Could not compile filter" for
-		// every 0 return, causing per-frame warning spam for data-bound filter strings
-		// that include blur(0px) at default slider values. The render-time skip
-		// (Sigma < 0.01 → break in ApplyFilters) suppresses the no-op pass instead.
-	}
-	else if (name == "drop-shadow")
-	{
-		Filter->Type = ERmlFilterType::DropShadow;
-		auto itColor = parameters.find("color");
-		if (itColor != parameters.end())
-		{
-			Rml::Colourb c = itColor->second.Get<Rml::Colourb>(Rml::Colourb(0, 0, 0, 255));
-			Filter->Color = FLinearColor(c.red / 255.0f, c.green / 255.0f, c.blue / 255.0f, c.alpha / 255.0f);
-		}
-		// RmlUI passes offset as a single Vector2f, not separate x/y.
-		auto itOffset = parameters.find("offset");
-		if (itOffset != parameters.end())
-		{
-			Rml::Vector2f off = itOffset->second.Get<Rml::Vector2f>(Rml::Vector2f(0, 0));
-			Filter->Offset = FVector2f(off.x, off.y);
-		}
-		// Sigma is already the Gaussian standard deviation — no 0.5 multiplication.
-		auto itSigma = parameters.find("sigma");
-		if (itSigma != parameters.end())
-			Filter->Sigma = itSigma->second.Get<float>(0.0f);
-	}
-	else if (name == "brightness" || name == "contrast" || name == "invert" ||
-	         name == "grayscale" || name == "sepia" || name == "saturate" || name == "hue-rotate")
-	{
-		float value = 1.0f;
-		auto it = parameters.find("value");
-		if (it != parameters.end())
-			value = it->second.Get<float>(1.0f);
-
-		// NOTE: Do NOT return 0 for identity color matrix values (brightness(1), sepia(0),
-		// etc.). RmlUI logs "Could not compile filter" for every 0 return — the data-bound
-		// filter string on the outer div emits 8 identity color filters per frame at default
-		// slider values, causing 8 warnings/frame of log spam. The render-time checks in
-		// ApplyFilters (ColorMatrix == Identity → break) and ExecuteCompositeLayers
-		// (bAllIdentity fast path) suppress the no-op passes without warnings.
-		Filter->Type = ERmlFilterType::ColorMatrix;
-
-		// Build 4x4 color matrix based on filter type
-		FMatrix44f M = FMatrix44f::Identity;
-
-		if (name == "brightness")
-		{
-			// Scale RGB by value
-			M.M[0][0] = value; M.M[1][1] = value; M.M[2][2] = value;
-		}
-		else if (name == "contrast")
-		{
-			// Scale and offset: c = (c - 0.5) * value + 0.5
-			// As matrix: scale RGB, add offset via last row
-			float t = (1.0f - value) * 0.5f;
-			M.M[0][0] = value; M.M[1][1] = value; M.M[2][2] = value;
-			// Offset encoded in row 3 (treated as translation in color space)
-			M.M[3][0] = t; M.M[3][1] = t; M.M[3][2] = t;
-		}
-		else if (name == "invert")
-		{
-			// Invert: c = 1 - c (with value as interpolation factor)
-			float v = value;
-			M.M[0][0] = 1.0f - 2.0f * v; M.M[1][1] = 1.0f - 2.0f * v; M.M[2][2] = 1.0f - 2.0f * v;
-			M.M[3][0] = v; M.M[3][1] = v; M.M[3][2] = v;
-		}
-		else if (name == "grayscale")
-		{
-			// Luminance weights
-			float r = 0.2126f, g = 0.7152f, b = 0.0722f;
-			float inv = 1.0f - value;
-			M.M[0][0] = inv + value * r; M.M[0][1] = value * r;       M.M[0][2] = value * r;
-			M.M[1][0] = value * g;       M.M[1][1] = inv + value * g; M.M[1][2] = value * g;
-			M.M[2][0] = value * b;       M.M[2][1] = value * b;       M.M[2][2] = inv + value * b;
-		}
-		else if (name == "sepia")
-		{
-			// Sepia tone matrix (mixed with identity by value)
-			float inv = 1.0f - value;
-			M.M[0][0] = inv + value * 0.393f; M.M[0][1] = value * 0.349f;       M.M[0][2] = value * 0.272f;
-			M.M[1][0] = value * 0.769f;       M.M[1][1] = inv + value * 0.686f; M.M[1][2] = value * 0.534f;
-			M.M[2][0] = value * 0.189f;       M.M[2][1] = value * 0.168f;       M.M[2][2] = inv + value * 0.131f;
-		}
-		else if (name == "saturate")
-		{
-			float r = 0.2126f, g = 0.7152f, b = 0.0722f;
-			float s = value;
-			M.M[0][0] = (1.0f - s) * r + s; M.M[0][1] = (1.0f - s) * r;       M.M[0][2] = (1.0f - s) * r;
-			M.M[1][0] = (1.0f - s) * g;     M.M[1][1] = (1.0f - s) * g + s;   M.M[1][2] = (1.0f - s) * g;
-			M.M[2][0] = (1.0f - s) * b;     M.M[2][1] = (1.0f - s) * b;       M.M[2][2] = (1.0f - s) * b + s;
-		}
-		else if (name == "hue-rotate")
-		{
-			// RmlUI already converts degrees to radians before passing to CompileFilter.
-			float rad = value;
-			float c = FMath::Cos(rad), s = FMath::Sin(rad);
-			float r = 0.2126f, g = 0.7152f, b = 0.0722f;
-
-			M.M[0][0] = r + c * (1 - r) + s * (-r);
-			M.M[0][1] = r + c * (-r)    + s * (0.143f);
-			M.M[0][2] = r + c * (-r)    + s * (-(1 - r));
-
-			M.M[1][0] = g + c * (-g)    + s * (-g);
-			M.M[1][1] = g + c * (1 - g) + s * (0.140f);
-			M.M[1][2] = g + c * (-g)    + s * (g);
-
-			M.M[2][0] = b + c * (-b)    + s * (1 - b);
-			M.M[2][1] = b + c * (-b)    + s * (-0.283f);
-			M.M[2][2] = b + c * (1 - b) + s * (b);
-		}
-
-		Filter->ColorMatrix = M;
-	}
-	else
-	{
-		UE_LOG(LogUERmlUI, Warning, TEXT("CompileFilter: unknown filter '%hs'"), name.c_str());
-		return 0;
-	}
-
-	Rml::CompiledFilterHandle Handle = NextFilterHandle++;
-	CompiledFilters.Add(Handle, Filter);
-	return Handle;
+	return SharedResources.CompileFilter(name, parameters);
 }
 
 void FUERmlRenderInterface::ReleaseFilter(Rml::CompiledFilterHandle filter)
 {
-	if (filter == 0) return;	// Identity filters return 0 from CompileFilter — nothing to release
-
-	// Defer removal — the render thread may still reference this filter handle
-	// in a CompositeLayers command recorded earlier this frame (e.g. box-shadow
-	// compiles + uses + releases blur filters within a single callback).
-	PendingFilterReleases.Add(filter);
+	if (filter == 0) return;
+	InvalidateRetained(filter);
+	SharedResources.ReleaseFilter(filter);
 }
 
 // ============================================================================
@@ -718,182 +450,313 @@ void FUERmlRenderInterface::ReleaseFilter(Rml::CompiledFilterHandle filter)
 
 Rml::CompiledShaderHandle FUERmlRenderInterface::CompileShader(const Rml::String& name, const Rml::Dictionary& parameters)
 {
-	auto Shader = MakeShared<FCompiledRmlShader>();
+	return SharedResources.CompileShader(name, parameters);
+}
 
-	auto GetVector2 = [&parameters](const char* Key, const Rml::Vector2f& DefaultValue) -> Rml::Vector2f
-	{
-		if (const auto It = parameters.find(Key); It != parameters.end())
-			return It->second.Get<Rml::Vector2f>(DefaultValue);
-		return DefaultValue;
-	};
+void FUERmlRenderInterface::RenderShader(Rml::CompiledShaderHandle shader, Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation, Rml::TextureHandle texture)
+{
+	if (FRetainedCall* Call = RecordCall(ERetainedCall::RenderShader))
+	{
+		Call->Shader      = shader;
+		Call->Geometry    = geometry;
+		Call->Texture     = texture;
+		Call->Translation = translation;
+		RetainResource(shader);
+		RetainResource(geometry);
+		RetainResource(texture);
+		RetainBounds(geometry, translation);
+	}
+	if (!CurrentDrawer.IsValid()) return;
 
-	auto GetFloat = [&parameters](const char* Key, float DefaultValue) -> float
-	{
-		if (const auto It = parameters.find(Key); It != parameters.end())
-			return It->second.Get<float>(DefaultValue);
-		return DefaultValue;
-	};
+	TSharedPtr<FCompiledRmlShader> Shader = SharedResources.ResolveShader(shader);
+	if (!Shader) return;
 
-	auto GetBool = [&parameters](const char* Key, bool DefaultValue) -> bool
-	{
-		if (const auto It = parameters.find(Key); It != parameters.end())
-			return It->second.Get<bool>(DefaultValue);
-		return DefaultValue;
-	};
+	FRmlTextureEntry* Texture = SharedResources.ResolveTexture(texture);
+	if (texture && !Texture) return;
+	NoteTextureDrawn(Texture);
 
-	auto ApplyColorStopList = [&parameters](FCompiledRmlShader& OutShader) -> bool
-	{
-		const auto It = parameters.find("color_stop_list");
-		if (It == parameters.end() || It->second.GetType() != Rml::Variant::COLORSTOPLIST)
-			return false;
+	FRmlMesh* Mesh = reinterpret_cast<FRmlMesh*>(geometry);
+	if (Mesh->bNeedsMultisampling)
+		CurrentDrawer->MarkNeedsMultisampling();
 
-		const Rml::ColorStopList& ColorStopList = It->second.GetReference<Rml::ColorStopList>();
-		const int32 NumStops = FMath::Min(static_cast<int32>(ColorStopList.size()), 16);
+	CurrentDrawer->EmplaceDrawShader(
+		MoveTemp(Shader),
+		Mesh,
+		Texture,
+		GetTransformState(),
+		FVector2f(translation.x, translation.y),
+		GetScissorState());
+}
 
-		OutShader.StopPositions.Reset(NumStops);
-		OutShader.StopColors.Reset(NumStops);
+void FUERmlRenderInterface::ReleaseShader(Rml::CompiledShaderHandle shader)
+{
+	InvalidateRetained(shader);
+	SharedResources.ReleaseShader(shader);
+}
 
-		for (int32 i = 0; i < NumStops; ++i)
-		{
-			const Rml::ColorStop& Stop = ColorStopList[i];
-			const Rml::ColourbPremultiplied& Color = Stop.color;
-
-			OutShader.StopPositions.Add(Stop.position.number);
-			OutShader.StopColors.Add(FLinearColor(
-				Color.red / 255.0f,
-				Color.green / 255.0f,
-				Color.blue / 255.0f,
-				Color.alpha / 255.0f));
-		}
+// ============================================================================
+// Retained-mode rendering
+// ============================================================================
 
-		return OutShader.StopPositions.Num() > 0;
-	};
+void FUERmlRenderInterface::FRetainedDocument::Invalidate()
+{
+	Calls.Reset();
+	Transforms.Reset();
+	Filters.Reset();
+	Resources.Reset();
+	bValid = false;
+	bHasBounds = false;
+	bUnbounded = false;
+}
+
+bool FUERmlRenderInterface::OnRenderDocumentBegin(Rml::ElementDocument* document)
+{
+	FRetainedDocument& Retained = RetainedDocuments.FindOrAdd(document);
+	Retained.LastUsedFrame = GFrameCounter;
 
-	if (name == "shader")
+	if (Retained.bValid && !document->IsRenderDirty())
 	{
-		const auto ItValue = parameters.find("value");
-		const Rml::String Value = (ItValue != parameters.end())
-			? ItValue->second.Get<Rml::String>(Rml::String())
-			: Rml::String();
+		++Retained.Stats.Hits;
+		INC_DWORD_STAT(STAT_RmlUI_RetainedHits);
+		CurrentFrameDocument = FrameDocuments.Add({ document, false });
+		ReplayRetained(Retained);
+		CurrentFrameDocument = INDEX_NONE;
+		return false;
+	}
 
-		if (Value != "creation")
-		{
-			UE_LOG(LogUERmlUI, Warning, TEXT("CompileShader: unsupported shader value '%hs'"), Value.c_str());
-			return 0;
-		}
+	++Retained.Stats.Misses;
+	INC_DWORD_STAT(STAT_RmlUI_RetainedMisses);
+	if (Retained.Stats.SourceURL.IsEmpty())
+		Retained.Stats.SourceURL = UTF8_TO_TCHAR(document->GetSourceURL().c_str());
+
+	// Cleared before rendering: anything dirtied while the document renders keeps it dirty for the next frame.
+	document->ClearRenderDirty();
+	Retained.Invalidate();
+	Retained.bValid = true;
+	RecordingDocument = &Retained;
+	CurrentFrameDocument = FrameDocuments.Add({ document, true });
+	return true;
+}
 
-		Shader->Type = ERmlShaderType::Creation;
-	}
-	else
+void FUERmlRenderInterface::OnRenderDocumentEnd(Rml::ElementDocument* document)
+{
+	if (RecordingDocument)
+		RecordingDocument->Stats.NumCalls = RecordingDocument->Calls.Num();
+	RecordingDocument = nullptr;
+	CurrentFrameDocument = INDEX_NONE;
+}
+
+void FUERmlRenderInterface::NoteTextureDrawn(const FRmlTextureEntry* Texture)
+{
+	if (Texture && Texture->bDynamicContent && CurrentFrameDocument != INDEX_NONE)
+		FrameDocuments[CurrentFrameDocument].bDynamicTextures = true;
+}
+
+FUERmlRenderInterface::FRetainedCall* FUERmlRenderInterface::RecordCall(ERetainedCall Type)
+{
+	if (!RecordingDocument || !RecordingDocument->bValid)
+		return nullptr;
+
+	FRetainedCall& Call = RecordingDocument->Calls.AddDefaulted_GetRef();
+	Call.Type = Type;
+	return &Call;
+}
+
+void FUERmlRenderInterface::RetainBounds(Rml::CompiledGeometryHandle Geometry, Rml::Vector2f Translation)
+{
+	if (bCustomMatrix)
 	{
-		Shader->Type = ERmlShaderType::Gradient;
-		const bool bNamedRepeatingLinear = (name == "repeating-linear-gradient");
-		const bool bNamedRepeatingRadial = (name == "repeating-radial-gradient");
-		const bool bNamedRepeatingConic = (name == "repeating-conic-gradient");
+		// Bounding a transformed mesh isn't worth it; such documents redraw their whole area.
+		RecordingDocument->bUnbounded = true;
+		return;
+	}
 
-		const bool bIsLinearGradient = (name == "linear-gradient" || bNamedRepeatingLinear);
-		const bool bIsRadialGradient = (name == "radial-gradient" || bNamedRepeatingRadial);
-		const bool bIsConicGradient = (name == "conic-gradient" || bNamedRepeatingConic);
+	const FBox2f& MeshBounds = reinterpret_cast<const FRmlMesh*>(Geometry)->Bounds;
+	if (!MeshBounds.bIsValid)
+		return;
 
-		if (!bIsLinearGradient && !bIsRadialGradient && !bIsConicGradient)
-		{
-			UE_LOG(LogUERmlUI, Warning, TEXT("CompileShader: unknown shader '%hs'"), name.c_str());
-			return 0;
-		}
+	FSlateRect Rect(
+		MeshBounds.Min.X + Translation.x, MeshBounds.Min.Y + Translation.y,
+		MeshBounds.Max.X + Translation.x, MeshBounds.Max.Y + Translation.y);
+	if (bUseClipRect)
+	{
+		bool bOverlapping = false;
+		Rect = Rect.IntersectionWith(ClipRect, bOverlapping);
+		if (!bOverlapping)
+			return;
+	}
 
-		const bool bRepeating = GetBool("repeating", false) || bNamedRepeatingLinear || bNamedRepeatingRadial || bNamedRepeatingConic;
+	FRetainedDocument& Retained = *RecordingDocument;
+	Retained.Bounds = Retained.bHasBounds ? Retained.Bounds.Expand(Rect) : Rect;
+	Retained.bHasBounds = true;
+}
 
-		if (bIsLinearGradient)
+void FUERmlRenderInterface::UpdateCachedLayer()
+{
+	FRmlCachedLayer& Layer = *CurrentCachedLayer;
+	const FIntRect ViewportPixels(
+		FMath::FloorToInt(ViewportRect.Left), FMath::FloorToInt(ViewportRect.Top),
+		FMath::CeilToInt(ViewportRect.Right), FMath::CeilToInt(ViewportRect.Bottom));
+
+	// Physical bounds of every document rendered this frame.
+	TArray<FRmlCachedLayer::FDocumentBounds> Documents;
+	Documents.Reserve(FrameDocuments.Num());
+	for (const FFrameDocument& Frame : FrameDocuments)
+	{
+		const FRetainedDocument& Retained = RetainedDocuments.FindChecked(Frame.Document);
+		FIntRect Bounds;
+		if (Retained.bUnbounded)
 		{
-			Shader->GradientFunc = bRepeating ? ERmlGradientFunc::RepeatingLinear : ERmlGradientFunc::Linear;
-			const Rml::Vector2f P0 = GetVector2("p0", Rml::Vector2f(0.0f, 0.0f));
-			const Rml::Vector2f P1 = GetVector2("p1", Rml::Vector2f(0.0f, 0.0f));
-			Shader->P = FVector2f(P0.x, P0.y);
-			Shader->V = FVector2f(P1.x - P0.x, P1.y - P0.y);
+			Bounds = ViewportPixels;
 		}
-		else if (bIsRadialGradient)
+		else if (Retained.bHasBounds)
 		{
-			Shader->GradientFunc = bRepeating ? ERmlGradientFunc::RepeatingRadial : ERmlGradientFunc::Radial;
-			const Rml::Vector2f Center = GetVector2("center", Rml::Vector2f(0.0f, 0.0f));
-			const Rml::Vector2f Radius = GetVector2("radius", Rml::Vector2f(1.0f, 1.0f));
+			// One pixel of padding for anti-aliased edges and snapped saved layers.
+			const FSlateRect Physical = TransformRect(RmlWidgetRenderTransform, Retained.Bounds);
+			Bounds = FIntRect(
+				FMath::FloorToInt(Physical.Left) - 1, FMath::FloorToInt(Physical.Top) - 1,
+				FMath::CeilToInt(Physical.Right) + 1, FMath::CeilToInt(Physical.Bottom) + 1);
+			Bounds.Clip(ViewportPixels);
+		}
+		Documents.Add({ Frame.Document, Bounds });
+	}
 
-			const float SafeRadiusX = FMath::Abs(Radius.x) > KINDA_SMALL_NUMBER ? Radius.x : 1.0f;
-			const float SafeRadiusY = FMath::Abs(Radius.y) > KINDA_SMALL_NUMBER ? Radius.y : 1.0f;
+	// Anything that moves or re-colours every pixel invalidates the whole layer.
+	const uint32 ContentSerial = SharedResources.GetContentSerial();
+	bool bFullRedraw = Layer.bInvalidated
+		|| Layer.ContentSerial != ContentSerial
+		|| Layer.ViewportRect != ViewportRect
+		|| FMemory::Memcmp(&Layer.RenderMatrix, &RmlRenderMatrix, sizeof(FMatrix44f)) != 0;
 
-			Shader->P = FVector2f(Center.x, Center.y);
-			Shader->V = FVector2f(1.0f / SafeRadiusX, 1.0f / SafeRadiusY);
+	FIntRect DirtyRect;
+	auto AddDirty = [&DirtyRect](const FIntRect& Rect)
+	{
+		if (Rect.Area() > 0)
+			DirtyRect = DirtyRect.Area() > 0 ? DirtyRect.Union(Rect) : Rect;
+	};
+
+	// A re-rendered document dirties where it was and where it is now; a shown or
+	// hidden one only the area it covers. Stacking order changes redraw everything.
+	int32 LastOldIndex = INDEX_NONE;
+	for (int32 Index = 0; Index < Documents.Num() && !bFullRedraw; ++Index)
+	{
+		const FRmlCachedLayer::FDocumentBounds& New = Documents[Index];
+		const int32 OldIndex = Layer.Documents.IndexOfByPredicate(
+			[&New](const FRmlCachedLayer::FDocumentBounds& Old) { return Old.Document == New.Document; });
+		if (OldIndex == INDEX_NONE)
+		{
+			AddDirty(New.Bounds);
+			continue;
 		}
-		else
+		if (OldIndex < LastOldIndex)
 		{
-			Shader->GradientFunc = bRepeating ? ERmlGradientFunc::RepeatingConic : ERmlGradientFunc::Conic;
-			const Rml::Vector2f Center = GetVector2("center", Rml::Vector2f(0.0f, 0.0f));
-			const float Angle = GetFloat("angle", 0.0f);
-
-			Shader->P = FVector2f(Center.x, Center.y);
-			Shader->V = FVector2f(FMath::Cos(Angle), FMath::Sin(Angle));
+			bFullRedraw = true;
+			break;
 		}
+		LastOldIndex = OldIndex;
 
-		if (!ApplyColorStopList(*Shader))
+		// Render targets and media textures change under a replayed document too.
+		if (FrameDocuments[Index].bRecorded || FrameDocuments[Index].bDynamicTextures)
 		{
-			UE_LOG(LogUERmlUI, Warning, TEXT("CompileShader: missing or invalid color_stop_list for '%hs'"), name.c_str());
-			return 0;
+			AddDirty(Layer.Documents[OldIndex].Bounds);
+			AddDirty(New.Bounds);
 		}
 	}
+	for (const FRmlCachedLayer::FDocumentBounds& Old : Layer.Documents)
+	{
+		if (!Documents.ContainsByPredicate([&Old](const FRmlCachedLayer::FDocumentBounds& New) { return New.Document == Old.Document; }))
+			AddDirty(Old.Bounds);
+	}
 
-	Rml::CompiledShaderHandle Handle = NextShaderHandle++;
-	CompiledShaders.Add(Handle, Shader);
-	return Handle;
-}
+	FIntRect ContentRect;
+	for (const FRmlCachedLayer::FDocumentBounds& New : Documents)
+	{
+		if (New.Bounds.Area() > 0)
+			ContentRect = ContentRect.Area() > 0 ? ContentRect.Union(New.Bounds) : New.Bounds;
+	}
 
-void FUERmlRenderInterface::RenderShader(Rml::CompiledShaderHandle shader, Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation, Rml::TextureHandle texture)
-{
-	if (!CurrentDrawer.IsValid()) return;
+	if (bFullRedraw)
+		DirtyRect = FIntRect(0, 0, MAX_int32, MAX_int32);	// clipped to the target by the drawer
+	else if (DirtyRect.Area() == 0)
+		CurrentDrawer->ResetRecording();					// nothing changed, just composite
 
-	FMatrix44f Matrix = ComputeNDCMatrix(translation);
-	FIntRect ScissorRect = ComputeScissorRect();
+	Layer.Documents = MoveTemp(Documents);
+	Layer.RenderMatrix = RmlRenderMatrix;
+	Layer.ViewportRect = ViewportRect;
+	Layer.ContentSerial = ContentSerial;
+	Layer.bInvalidated = false;
 
-	FRmlTextureEntryPtr TextureRef;
-	if (texture)
-		TextureRef = reinterpret_cast<FRmlTextureEntry*>(texture)->AsShared();
-	CurrentDrawer->EmplaceDrawShader(
-		shader,
-		reinterpret_cast<FRmlMesh*>(geometry)->AsShared(),
-		MoveTemp(TextureRef),
-		Matrix,
-		ScissorRect);
+	CurrentDrawer->SetCachedLayer(CurrentCachedLayer, DirtyRect, ContentRect);
 }
 
-void FUERmlRenderInterface::ReleaseShader(Rml::CompiledShaderHandle shader)
+void FUERmlRenderInterface::InvalidateRetained(uintptr_t Handle)
 {
-	CompiledShaders.Remove(shader);
+	for (auto& Pair : RetainedDocuments)
+	{
+		if (Pair.Value.bValid && Pair.Value.Resources.Contains(Handle))
+			Pair.Value.Invalidate();
+	}
 }
 
-// ============================================================================
-// Drawer allocation
-// ============================================================================
-
-TSharedPtr<FRmlDrawer, ESPMode::ThreadSafe> FUERmlRenderInterface::_AllocDrawer()
+void FUERmlRenderInterface::ReplayRetained(const FRetainedDocument& Retained)
 {
-	const int32 SampleCount = URmlUiSettings::Get()->GetMSAASampleCount();
+	SCOPE_CYCLE_COUNTER(STAT_RmlUI_RetainedReplay);
 
-	// Find a free drawer or create one.
-	TSharedPtr<FRmlDrawer, ESPMode::ThreadSafe>* Found = nullptr;
-	for (auto& Drawer : AllDrawers)
+	// RecordingDocument is null here, so these calls are not recorded again.
+	for (const FRetainedCall& Call : Retained.Calls)
 	{
-		if (Drawer->IsFree())
+		switch (Call.Type)
 		{
-			Drawer->MarkUsing();
-			Found = &Drawer;
+		case ERetainedCall::RenderGeometry:
+			RenderGeometry(Call.Geometry, Call.Translation, Call.Texture);
+			break;
+		case ERetainedCall::RenderShader:
+			RenderShader(Call.Shader, Call.Geometry, Call.Translation, Call.Texture);
+			break;
+		case ERetainedCall::EnableScissor:
+			EnableScissorRegion(Call.Arg != 0);
+			break;
+		case ERetainedCall::SetScissor:
+			SetScissorRegion(Call.Region);
+			break;
+		case ERetainedCall::SetTransform:
+			SetTransform(Call.Slot != INDEX_NONE ? &Retained.Transforms[Call.Slot] : nullptr);
+			break;
+		case ERetainedCall::EnableClipMask:
+			EnableClipMask(Call.Arg != 0);
+			break;
+		case ERetainedCall::RenderToClipMask:
+			RenderToClipMask((Rml::ClipMaskOperation)Call.Arg, Call.Geometry, Call.Translation);
+			break;
+		case ERetainedCall::PushLayer:
+			PushLayer();
+			break;
+		case ERetainedCall::CompositeLayers:
+			CompositeLayers(Call.Geometry, Call.Texture, (Rml::BlendMode)Call.Arg,
+				Rml::Span<const Rml::CompiledFilterHandle>(Retained.Filters.GetData() + Call.Slot, Call.NumFilters));
+			break;
+		case ERetainedCall::PopLayer:
+			PopLayer();
 			break;
 		}
 	}
+}
 
-	if (!Found)
+void FUERmlRenderInterface::PruneRetainedDocuments()
+{
+	// Documents that were closed or hidden stop being rendered; drop their recordings
+	// after a few frames. A new document reusing an address starts render-dirty, so a
+	// stale entry is never replayed for it.
+	for (auto It = RetainedDocuments.CreateIterator(); It; ++It)
 	{
-		Found = &AllDrawers.Add_GetRef(MakeShared<FRmlDrawer, ESPMode::ThreadSafe>(true));
+		if (GFrameCounter - It->Value.LastUsedFrame > 2)
+			It.RemoveCurrent();
 	}
+}
 
-	(*Found)->SetMSAASamples(SampleCount);
-	(*Found)->CompiledShaders = &CompiledShaders;
-	return *Found;
+void FUERmlRenderInterface::GetRetainedDocumentStats(TArray<FRmlRetainedDocumentStats>& OutStats) const
+{
+	OutStats.Reset(RetainedDocuments.Num());
+	for (const auto& Pair : RetainedDocuments)
+		OutStats.Add(Pair.Value.Stats);
 }
@@ -0,0 +1,992 @@
+#include "RmlInterface/UERmlRenderResources.h"
+#include "RmlInterface/UERmlRenderInterface.h"
+#include "Render/RmlDrawer.h"
+#include "Render/RmlMesh.h"
+#include "Render/RmlTextureAtlas.h"
+#include "RmlUiSettings.h"
+#include "RmlHelper.h"
+#include "Logging.h"
+#include "Engine/Texture2D.h"
+#include "IImageWrapperModule.h"
+#include "UObject/GarbageCollection.h"
+#include "Misc/Paths.h"
+#include "RenderingThread.h"
+
+DECLARE_STATS_GROUP(TEXT("RmlUI_Interface"), STATGROUP_RmlUI_Interface, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("RmlUI CompileGeometry"), STAT_RmlUI_CompileGeometry, STATGROUP_RmlUI_Interface);
+DECLARE_CYCLE_STAT(TEXT("RmlUI ReleaseGeometry"), STAT_RmlUI_ReleaseGeometry, STATGROUP_RmlUI_Interface);
+DECLARE_CYCLE_STAT(TEXT("RmlUI Texture Decode"),  STAT_RmlUI_TextureDecode,  STATGROUP_RmlUI_Interface);
+DECLARE_CYCLE_STAT(TEXT("RmlUI Texture Load Wait"), STAT_RmlUI_TextureLoadWait, STATGROUP_RmlUI_Interface);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("RmlUI Pending Texture Loads"), STAT_RmlUI_PendingTextureLoads, STATGROUP_RmlUI_Interface);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("RmlUI Atlas Pages"),           STAT_RmlUI_AtlasPages,      STATGROUP_RmlUI_Interface);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("RmlUI Atlas Textures"),        STAT_RmlUI_AtlasTextures,   STATGROUP_RmlUI_Interface);
+
+FUERmlRenderResources& FUERmlRenderResources::Get()
+{
+	static FUERmlRenderResources Instance;
+	return Instance;
+}
+
+FUERmlRenderResources::FUERmlRenderResources() = default;
+FUERmlRenderResources::~FUERmlRenderResources() = default;
+
+void FUERmlRenderResources::Initialize()
+{
+	check(IsInGameThread());
+	ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+}
+
+bool FUERmlRenderResources::SetTexture(FString Path, UTexture* InTexture, bool bAddIfNotExist)
+{
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+	// Only UTexture2D content is static between rebinds; cached widget layers redraw the rest every frame.
+	const bool bDynamicContent = InTexture && !InTexture->IsA<UTexture2D>();
+	if (auto* FoundTexture = AllTextures.Find(Path))
+	{
+		(*FoundTexture)->BoundTexture = InTexture;
+		(*FoundTexture)->bDynamicContent = bDynamicContent;
+		++ContentSerial;
+		return true;
+	}
+
+	if (bAddIfNotExist)
+	{
+		AllTextures.Add(Path, MakeShared<FRmlTextureEntry, ESPMode::ThreadSafe>(InTexture))->bDynamicContent = bDynamicContent;
+		return true;
+	}
+
+	return false;
+}
+
+// ============================================================================
+// Frame housekeeping
+// ============================================================================
+
+void FUERmlRenderResources::BeginFrame()
+{
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+
+	// Flush deferred filter releases — the previous frame's render thread
+	// has finished with these handles by now.
+	for (Rml::CompiledFilterHandle H : PendingFilterReleases)
+		CompiledFilters.Remove(H);
+	PendingFilterReleases.Reset();
+	RetireAbandonedDrawers();
+	FlushDeferredReleases();
+	// Binding a finished load creates its UTexture2D.
+	if (IsInGameThread())
+		ProcessTextureLoads();
+}
+
+void FUERmlRenderResources::RetireAbandonedDrawers()
+{
+	// Slate draws of a frame are enqueued by the end of that frame, so a fence enqueued
+	// during the next one runs after all of them.
+	if (IsInGameThread() && FenceEnqueuedFrame != GFrameCounter)
+	{
+		FenceEnqueuedFrame = GFrameCounter;
+		ENQUEUE_RENDER_COMMAND(RmlUIFrameFence)([this, CompletedFrame = GFrameCounter - 1](FRHICommandListImmediate&)
+		{
+			RenderThreadCompletedFrame = CompletedFrame;
+		});
+	}
+
+	const uint64 CompletedFrame = RenderThreadCompletedFrame;
+	if (CompletedFrame < DrawerRetireFrames)
+		return;
+
+	for (const auto& Drawer : AllDrawers)
+	{
+		if (!Drawer->IsFree() && Drawer->GetHandoutFrame() <= CompletedFrame - DrawerRetireFrames)
+		{
+			Drawer->ResetRecording();
+			Drawer->MarkFree();
+		}
+	}
+}
+
+void FUERmlRenderResources::FlushDeferredReleases()
+{
+	// Oldest drawer still waiting for the render thread. Drawers are marked free at
+	// the end of DrawRenderThread (or retired above if Slate never ran them), so anything
+	// released before that drawer was handed out can no longer be referenced by an
+	// in-flight command.
+	uint64 OldestInFlight = MAX_uint64;
+	for (const auto& Drawer : AllDrawers)
+	{
+		if (!Drawer->IsFree())
+			OldestInFlight = FMath::Min(OldestInFlight, Drawer->GetFrameSerial());
+	}
+
+	// Entries are appended in serial order.
+	int32 NumSafe = 0;
+	while (NumSafe < DeferredReleases.Num() && DeferredReleases[NumSafe].Serial < OldestInFlight)
+	{
+		// Atlas regions can be handed out again only now that nothing samples them.
+		const FRmlTextureEntry* Texture = DeferredReleases[NumSafe].Texture.Get();
+		if (Texture && Texture->AtlasPage.IsValid())
+			TextureAtlas->Remove(*Texture);
+		++NumSafe;
+	}
+	if (NumSafe > 0)
+		DeferredReleases.RemoveAt(0, NumSafe, EAllowShrinking::No);
+
+	if (TextureAtlas.IsValid())
+	{
+		SET_DWORD_STAT(STAT_RmlUI_AtlasPages, TextureAtlas->GetNumPages());
+		SET_DWORD_STAT(STAT_RmlUI_AtlasTextures, TextureAtlas->GetNumPacked());
+	}
+}
+
+// ============================================================================
+// Drawer allocation
+// ============================================================================
+
+TSharedPtr<FRmlDrawer, ESPMode::ThreadSafe> FUERmlRenderResources::AllocDrawer()
+{
+	const URmlUiSettings* Settings = URmlUiSettings::Get();
+	const int32 SampleCount = Settings->GetMSAASampleCount();
+	const int32 RetainFrames = Settings->bRetainStaticGeometry ? Settings->GeometryRetainFrames : 0;
+	const int32 ArenaBytes = FMath::Clamp(Settings->GeometryArenaSizeMB, 1, 256) * 1024 * 1024;
+
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+
+	// Find a free drawer or create one.
+	TSharedPtr<FRmlDrawer, ESPMode::ThreadSafe>* Found = nullptr;
+	for (auto& Drawer : AllDrawers)
+	{
+		if (Drawer->IsFree())
+		{
+			Drawer->MarkUsing();
+			Found = &Drawer;
+			break;
+		}
+	}
+
+	if (!Found)
+	{
+		Found = &AllDrawers.Add_GetRef(MakeShared<FRmlDrawer, ESPMode::ThreadSafe>(true));
+	}
+
+	(*Found)->SetFrameSerial(++DrawerSerial, GFrameCounter);
+	(*Found)->SetMSAASamples(SampleCount);
+	(*Found)->SetGeometryRetention(RetainFrames, ArenaBytes);
+	(*Found)->SetMergeDraws(Settings->bMergeDrawCalls);
+	(*Found)->SetDirectRendering(Settings->bDirectRendering);
+	return *Found;
+}
+
+// ============================================================================
+// Per-context recorders
+// ============================================================================
+
+FUERmlRenderInterface* FUERmlRenderResources::AcquireRecorder()
+{
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+	if (FreeRecorders.Num() > 0)
+		return FreeRecorders.Pop(EAllowShrinking::No);
+	return Recorders.Add_GetRef(MakeUnique<FUERmlRenderInterface>()).Get();
+}
+
+void FUERmlRenderResources::ReleaseRecorder(FUERmlRenderInterface* Recorder)
+{
+	if (!Recorder || Recorder == DefaultRecorder)
+		return;
+	// The context is gone; its recordings reference documents that no longer exist.
+	Recorder->ResetRecorder();
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+	check(!FreeRecorders.Contains(Recorder));
+	FreeRecorders.Add(Recorder);
+}
+
+void FUERmlRenderResources::GetRecorders(TArray<FUERmlRenderInterface*>& OutRecorders) const
+{
+	FRWScopeLock ScopeLock(Lock, SLT_ReadOnly);
+	OutRecorders.Reset();
+	if (DefaultRecorder)
+		OutRecorders.Add(DefaultRecorder);
+	for (const TUniquePtr<FUERmlRenderInterface>& Recorder : Recorders)
+	{
+		if (!FreeRecorders.Contains(Recorder.Get()))
+			OutRecorders.Add(Recorder.Get());
+	}
+}
+
+// ============================================================================
+// Geometry
+// ============================================================================
+
+Rml::CompiledGeometryHandle FUERmlRenderResources::CompileGeometry(
+	Rml::Span<const Rml::Vertex> vertices,
+	Rml::Span<const int> indices)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RmlUI_CompileGeometry);
+	TSharedPtr<FRmlMesh, ESPMode::ThreadSafe> Mesh = MakeShared<FRmlMesh, ESPMode::ThreadSafe>();
+	Mesh->Setup(vertices, indices);
+
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+	Meshes.Add(Mesh.Get(), Mesh);
+	return reinterpret_cast<Rml::CompiledGeometryHandle>(Mesh.Get());
+}
+
+void FUERmlRenderResources::ReleaseGeometry(Rml::CompiledGeometryHandle geometry)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RmlUI_ReleaseGeometry);
+	if (!geometry) return;
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+	// O(1) hash map lookup — was O(N) linear search causing O(N²) per frame
+	// when the benchmark destroys all ~1000 meshes each SetInnerRML call.
+	// Recorded commands hold raw pointers, so the mesh is parked behind the
+	// frame fence instead of being destroyed here.
+	TSharedPtr<FRmlMesh, ESPMode::ThreadSafe> Removed;
+	if (Meshes.RemoveAndCopyValue(reinterpret_cast<FRmlMesh*>(geometry), Removed))
+		DeferredReleases.Add({ DrawerSerial, MoveTemp(Removed), nullptr });
+}
+
+// ============================================================================
+// Textures
+// ============================================================================
+
+Rml::TextureHandle FUERmlRenderResources::LoadTexture(
+	Rml::Vector2i& texture_dimensions,
+	const Rml::String& source)
+{
+	UE::Tasks::TTask<FRmlDecodedImage> LaunchedLoad;
+	const Rml::TextureHandle Handle = FindOrLoadTexture(texture_dimensions, source, LaunchedLoad);
+
+	// Optionally wait a little so the image is there for the frame that asked for it. Only the
+	// game thread binds decoded images, and it waits without the lock so other recorders carry on.
+	if (LaunchedLoad.IsValid() && IsInGameThread() && WaitForTextureLoad(LaunchedLoad))
+	{
+		FRWScopeLock ScopeLock(Lock, SLT_Write);
+		ProcessTextureLoads();
+	}
+	return Handle;
+}
+
+Rml::TextureHandle FUERmlRenderResources::FindOrLoadTexture(
+	Rml::Vector2i& texture_dimensions,
+	const Rml::String& source,
+	UE::Tasks::TTask<FRmlDecodedImage>& OutLaunchedLoad)
+{
+	FString SourcePath(source.c_str());
+	FString ResolvedFilePath = SourcePath;
+	if (!SourcePath.StartsWith(TEXT("/")) && FPaths::IsRelative(SourcePath))
+	{
+		ResolvedFilePath = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / SourcePath);
+	}
+	// ResolvedFilePath == SourcePath for asset paths (/Game/...) — safe to use as cache key always.
+
+	TOptional<FGCScopeGuard> GCGuard;
+	if (!IsInGameThread())
+		GCGuard.Emplace();
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+
+	auto FoundTexture = AllTextures.Find(ResolvedFilePath);
+	if (FoundTexture)
+	{
+		if (UTexture* Bound = (*FoundTexture)->BoundTexture)
+		{
+			texture_dimensions.x = Bound->GetSurfaceWidth();
+			texture_dimensions.y = Bound->GetSurfaceHeight();
+		}
+		else if (const FPendingTextureLoad* Pending = PendingTextureLoads.FindByPredicate(
+			[Entry = FoundTexture->Get()](const FPendingTextureLoad& Load) { return Load.Entry.Get() == Entry; }))
+		{
+			texture_dimensions.x = Pending->ProbedSize.X;
+			texture_dimensions.y = Pending->ProbedSize.Y;
+		}
+		return AllocTextureHandle(*FoundTexture, ETextureSlotKind::Loaded, ResolvedFilePath);
+	}
+
+	// Cache miss — determine load method (filesystem I/O only on first load).
+	const bool bIsFilePath = FPlatformFileManager::Get().GetPlatformFile().FileExists(*ResolvedFilePath);
+
+	// Async path: only the header is read here; the rest happens on a worker.
+	// Formats whose size can't be probed fall through to the synchronous load.
+	FIntPoint ProbedSize;
+	if (bIsFilePath && ImageWrapperModule && URmlUiSettings::Get()->bAsyncTextureLoading && FRmlHelper::ProbeImageSize(ResolvedFilePath, ProbedSize))
+	{
+		auto& AddedTexture = AllTextures.Add(ResolvedFilePath, MakeShared<FRmlTextureEntry, ESPMode::ThreadSafe>(nullptr, ResolvedFilePath));
+		AddedTexture->bPremultiplied = false;
+		AddedTexture->bWrapSampler = true;
+		OutLaunchedLoad = LaunchTextureLoad(AddedTexture, ProbedSize);
+		texture_dimensions.x = ProbedSize.X;
+		texture_dimensions.y = ProbedSize.Y;
+		return AllocTextureHandle(AddedTexture, ETextureSlotKind::Loaded, ResolvedFilePath);
+	}
+
+	if (!bIsFilePath && !IsInGameThread())
+	{
+		UE_LOG(LogUERmlUI, Warning, TEXT("LoadTexture: asset %s requested off the game thread — bind it with SetTexture first"), *SourcePath);
+		return 0;
+	}
+
+	UTexture2D* LoadedTexture = bIsFilePath
+		? FRmlHelper::LoadTextureFromFile(ResolvedFilePath)
+		: FRmlHelper::LoadTextureFromAsset(SourcePath);
+
+	if (!LoadedTexture) return 0;
+
+	auto& AddedTexture = AllTextures.Add(ResolvedFilePath, MakeShared<FRmlTextureEntry, ESPMode::ThreadSafe>(LoadedTexture, ResolvedFilePath));
+	AddedTexture->bPremultiplied = false;
+	AddedTexture->bWrapSampler = true;	// Both file and asset textures must support wrapped sampling in decorators.
+	texture_dimensions.x = LoadedTexture->GetSurfaceWidth();
+	texture_dimensions.y = LoadedTexture->GetSurfaceHeight();
+	return AllocTextureHandle(AddedTexture, ETextureSlotKind::Loaded, ResolvedFilePath);
+}
+
+UE::Tasks::TTask<FUERmlRenderResources::FRmlDecodedImage> FUERmlRenderResources::LaunchTextureLoad(
+	const TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>& Entry, FIntPoint ProbedSize)
+{
+	FPendingTextureLoad& Load = PendingTextureLoads.AddDefaulted_GetRef();
+	Load.Entry = Entry;
+	Load.ProbedSize = ProbedSize;
+	Load.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [ImageWrapper = ImageWrapperModule, Path = Entry->TexturePath]()
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RmlUI_TextureDecode);
+		FRmlDecodedImage Image;
+		Image.bValid = FRmlHelper::DecodeImageFile(*ImageWrapper, Path, Image.Pixels, Image.Size);
+		return Image;
+	});
+	SET_DWORD_STAT(STAT_RmlUI_PendingTextureLoads, PendingTextureLoads.Num());
+	return Load.Task;
+}
+
+bool FUERmlRenderResources::WaitForTextureLoad(const UE::Tasks::TTask<FRmlDecodedImage>& Task)
+{
+	check(IsInGameThread());
+
+	// The budget is shared by every load issued during the same frame.
+	const float BudgetMs = URmlUiSettings::Get()->AsyncTextureLoadBudgetMs;
+	if (BudgetMs <= 0.0f)
+		return false;
+
+	if (TextureLoadBudgetFrame != GFrameCounter)
+	{
+		TextureLoadBudgetFrame = GFrameCounter;
+		TextureLoadBudgetUsedMs = 0.0;
+	}
+	const double RemainingMs = BudgetMs - TextureLoadBudgetUsedMs;
+	if (RemainingMs <= 0.0)
+		return false;
+
+	SCOPE_CYCLE_COUNTER(STAT_RmlUI_TextureLoadWait);
+	const double WaitStart = FPlatformTime::Seconds();
+	const bool bDone = Task.Wait(FTimespan::FromMilliseconds(RemainingMs));
+	TextureLoadBudgetUsedMs += (FPlatformTime::Seconds() - WaitStart) * 1000.0;
+	return bDone;
+}
+
+void FUERmlRenderResources::ProcessTextureLoads()
+{
+	if (PendingTextureLoads.Num() == 0)
+		return;
+
+	for (int32 i = PendingTextureLoads.Num() - 1; i >= 0; --i)
+	{
+		if (PendingTextureLoads[i].Task.IsCompleted())
+		{
+			FinishTextureLoad(PendingTextureLoads[i]);
+			PendingTextureLoads.RemoveAtSwap(i, 1, EAllowShrinking::No);
+		}
+	}
+	SET_DWORD_STAT(STAT_RmlUI_PendingTextureLoads, PendingTextureLoads.Num());
+}
+
+void FUERmlRenderResources::FinishTextureLoad(FPendingTextureLoad& Load)
+{
+	// Released by RmlUi while decoding — nobody is left to draw it.
+	if (Load.Entry.IsUnique())
+		return;
+
+	FRmlDecodedImage& Image = Load.Task.GetResult();
+	if (!Image.bValid)
+	{
+		UE_LOG(LogUERmlUI, Warning, TEXT("LoadTexture: failed to decode %s"), *Load.Entry->TexturePath);
+		return;
+	}
+	if (Image.Size != Load.ProbedSize)
+	{
+		UE_LOG(LogUERmlUI, Warning, TEXT("LoadTexture: %s decoded as %dx%d but its header says %dx%d"),
+			*Load.Entry->TexturePath, Image.Size.X, Image.Size.Y, Load.ProbedSize.X, Load.ProbedSize.Y);
+	}
+
+	// The entry is already referenced by recorded and retained draws; binding the
+	// texture is all it takes for them to pick it up.
+	Load.Entry->BoundTexture = FRmlHelper::CreateTextureFromPixels(MoveTemp(Image.Pixels), Image.Size);
+	++ContentSerial;
+}
+
+Rml::TextureHandle FUERmlRenderResources::GenerateTexture(
+	Rml::Span<const Rml::byte> source,
+	Rml::Vector2i source_dimensions,
+	bool bLive)
+{
+	TOptional<FGCScopeGuard> GCGuard;
+	if (!IsInGameThread())
+		GCGuard.Emplace();
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+
+	// Small textures go into a shared atlas page — no UTexture2D of their own.
+	const URmlUiSettings* Settings = URmlUiSettings::Get();
+	if (Settings->bPackGeneratedTextures)
+	{
+		if (!TextureAtlas.IsValid())
+			TextureAtlas = MakeShared<FRmlTextureAtlas>(Settings->AtlasPageSize, Settings->AtlasMaxTextureSize);
+
+		if (TextureAtlas->CanPack(source_dimensions))
+		{
+			const Rml::TextureHandle Handle = AllocTextureHandle(TextureAtlas->Add(source, source_dimensions), ETextureSlotKind::Generated);
+			if (bLive)
+			{
+				UE_LOG(LogUERmlUI, Verbose, TEXT("GenerateTexture %dx%d [ATLAS] packed=%d pages=%d"),
+					source_dimensions.x, source_dimensions.y, TextureAtlas->GetNumPacked(), TextureAtlas->GetNumPages());
+			}
+			return Handle;
+		}
+	}
+
+	// Dimension-based texture pool: when RmlUI's UpdateLayersOnDirty releases and
+	// re-creates font-effect textures, the new textures often have the same dimensions.
+	// Reusing a pooled UTexture2D avoids the expensive CreateTransient + UpdateResource
+	// path — only the pixel data upload (memcpy + RHI update) remains.
+	const uint64 DimKey = (static_cast<uint64>(source_dimensions.x) << 32)
+						| static_cast<uint64>(source_dimensions.y);
+
+	if (auto* Pool = TextureDimensionPool.Find(DimKey))
+	{
+		if (Pool->Num() > 0)
+		{
+			auto Reused = Pool->Pop();
+			UTexture2D* Tex = Cast<UTexture2D>(Reused->BoundTexture.Get());
+			if (Tex)
+			{
+				// Upload new pixel data into the existing GPU resource (cheap).
+				const int32 DataSize = source_dimensions.x * source_dimensions.y * 4;
+				uint8* DataCopy = new uint8[DataSize];
+				FMemory::Memcpy(DataCopy, source.data(), DataSize);
+				auto* Region = new FUpdateTextureRegion2D(0, 0, 0, 0, source_dimensions.x, source_dimensions.y);
+				Tex->UpdateTextureRegions(0, 1u, Region, 4 * source_dimensions.x, 4, DataCopy,
+					[](uint8* D, const FUpdateTextureRegion2D* R) { delete[] D; delete R; });
+			}
+
+			const Rml::TextureHandle Handle = AllocTextureHandle(Reused, ETextureSlotKind::Generated);
+
+			if (bLive)
+			{
+				UE_LOG(LogUERmlUI, Log, TEXT("GenerateTexture %dx%d [POOL HIT - instant] cached=%d pool=%d"),
+					source_dimensions.x, source_dimensions.y, AllCreatedTextures.Num(), Pool->Num());
+			}
+			return Handle;
+		}
+	}
+
+	// Pool empty for this dimension — create a new UTexture2D.
+	UTexture2D* Texture = FRmlHelper::LoadTextureFromRaw(
+		(const uint8*)source.data(),
+		FIntPoint(source_dimensions.x, source_dimensions.y));
+
+	auto Entry = MakeShared<FRmlTextureEntry, ESPMode::ThreadSafe>(Texture);
+	Entry->bPremultiplied = true;
+	const Rml::TextureHandle Handle = AllocTextureHandle(Entry, ETextureSlotKind::Generated);
+
+	if (bLive)
+	{
+		UE_LOG(LogUERmlUI, Log, TEXT("GenerateTexture %dx%d [LIVE - no pool] cached=%d"),
+			source_dimensions.x, source_dimensions.y, AllCreatedTextures.Num());
+	}
+	else
+	{
+		UE_LOG(LogUERmlUI, Verbose, TEXT("GenerateTexture %dx%d [warmup] cached=%d"),
+			source_dimensions.x, source_dimensions.y, AllCreatedTextures.Num());
+	}
+
+	return Handle;
+}
+
+void FUERmlRenderResources::ReleaseTexture(Rml::TextureHandle texture)
+{
+	if (!texture) return;
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+
+	FTextureSlot* Slot = FindTextureSlot(texture);
+	if (!Slot)
+	{
+		UE_LOG(LogUERmlUI, Warning, TEXT("ReleaseTexture: stale handle 0x%llX — already released"), (uint64)texture);
+		return;
+	}
+
+	TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe> Entry = MoveTemp(Slot->Entry);
+	if (Slot->Kind == ETextureSlotKind::Loaded)
+	{
+		// Drop the path cache entry unless it has been replaced since (SetTexture).
+		if (auto* Cached = AllTextures.Find(Slot->LoadedKey); Cached && *Cached == Entry)
+			AllTextures.Remove(Slot->LoadedKey);
+		DeferredReleases.Add({ DrawerSerial, nullptr, MoveTemp(Entry) });
+	}
+	else
+	{
+		// Swap-remove from AllCreatedTextures, fixing up the slot of the moved entry.
+		const int32 Index = Slot->CreatedIndex;
+		AllCreatedTextures.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		CreatedTextureSlots.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		if (Index < CreatedTextureSlots.Num())
+			TextureSlots[CreatedTextureSlots[Index]].CreatedIndex = Index;
+
+		// Pool the entry for future reuse (FGCObject prevents UTexture2D from being GC'd).
+		if (UTexture2D* Tex = Cast<UTexture2D>(Entry->BoundTexture.Get()))
+		{
+			const uint64 Key = (static_cast<uint64>(Tex->GetSizeX()) << 32)
+							 | static_cast<uint64>(Tex->GetSizeY());
+			TArray<TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>>& Pool = TextureDimensionPool.FindOrAdd(Key);
+			Pool.Add(MoveTemp(Entry));
+			UE_LOG(LogUERmlUI, Verbose, TEXT("ReleaseTexture %dx%d → pooled  cached=%d pool=%d"),
+				(int32)Tex->GetSizeX(), (int32)Tex->GetSizeY(), AllCreatedTextures.Num(), Pool.Num());
+		}
+		else
+		{
+			// Saved layers (render-thread RHI texture) and atlas entries (page region)
+			// must stay valid until the drawers that reference them have executed.
+			DeferredReleases.Add({ DrawerSerial, nullptr, MoveTemp(Entry) });
+		}
+	}
+
+	const int32 SlotIndex = static_cast<int32>(Slot - TextureSlots.GetData());
+	Slot->LoadedKey.Reset();
+	Slot->CreatedIndex = INDEX_NONE;
+	Slot->Kind = ETextureSlotKind::Free;
+	++Slot->Generation;
+	FreeTextureSlots.Add(SlotIndex);
+}
+
+Rml::TextureHandle FUERmlRenderResources::AllocTextureHandle(
+	const TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>& Entry,
+	ETextureSlotKind Kind,
+	const FString& LoadedKey)
+{
+	const int32 SlotIndex = FreeTextureSlots.Num() > 0 ? FreeTextureSlots.Pop(EAllowShrinking::No) : TextureSlots.AddDefaulted();
+	FTextureSlot& Slot = TextureSlots[SlotIndex];
+	Slot.Entry = Entry;
+	Slot.Kind  = Kind;
+	if (Kind == ETextureSlotKind::Loaded)
+	{
+		Slot.LoadedKey = LoadedKey;
+	}
+	else
+	{
+		Slot.CreatedIndex = AllCreatedTextures.Add(Entry);
+		CreatedTextureSlots.Add(SlotIndex);
+	}
+	return (static_cast<Rml::TextureHandle>(Slot.Generation) << 32) | static_cast<Rml::TextureHandle>(SlotIndex + 1);
+}
+
+Rml::TextureHandle FUERmlRenderResources::AddSavedLayer(const TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>& Entry)
+{
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+	return AllocTextureHandle(Entry, ETextureSlotKind::SavedLayer);
+}
+
+FUERmlRenderResources::FTextureSlot* FUERmlRenderResources::FindTextureSlot(Rml::TextureHandle Handle)
+{
+	const int32 SlotIndex = static_cast<int32>(Handle & 0xFFFFFFFF) - 1;
+	if (!TextureSlots.IsValidIndex(SlotIndex))
+		return nullptr;
+	FTextureSlot& Slot = TextureSlots[SlotIndex];
+	if (Slot.Kind == ETextureSlotKind::Free || Slot.Generation != static_cast<uint32>(Handle >> 32))
+		return nullptr;
+	return &Slot;
+}
+
+FRmlTextureEntry* FUERmlRenderResources::ResolveTexture(Rml::TextureHandle Handle)
+{
+	if (!Handle) return nullptr;
+	FRWScopeLock ScopeLock(Lock, SLT_ReadOnly);
+	if (FTextureSlot* Slot = FindTextureSlot(Handle))
+		return Slot->Entry.Get();
+	UE_LOG(LogUERmlUI, Warning, TEXT("Draw with stale texture handle 0x%llX — skipped"), (uint64)Handle);
+	return nullptr;
+}
+
+// ============================================================================
+// Texture pre-allocation
+// ============================================================================
+
+void FUERmlRenderResources::PreallocateTextureReserves()
+{
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+
+	// Count textures per dimension from warmup results.
+	TMap<uint64, int32> ObservedDims;
+	for (const auto& Entry : AllCreatedTextures)
+	{
+		if (UTexture2D* Tex = Cast<UTexture2D>(Entry->BoundTexture.Get()))
+		{
+			const uint64 Key = (static_cast<uint64>(Tex->GetSizeX()) << 32)
+							 | static_cast<uint64>(Tex->GetSizeY());
+			ObservedDims.FindOrAdd(Key, 0)++;
+		}
+	}
+
+	int32 TotalCreated = 0;
+	for (auto& Pair : ObservedDims)
+	{
+		const int32 Width  = static_cast<int32>(Pair.Key >> 32);
+		const int32 Height = static_cast<int32>(Pair.Key & 0xFFFFFFFF);
+
+		auto& Pool = TextureDimensionPool.FindOrAdd(Pair.Key);
+		const int32 ToAdd = FMath::Max(0, Pair.Value - Pool.Num());
+
+		for (int32 i = 0; i < ToAdd; ++i)
+		{
+			// Match LoadTextureFromRaw settings exactly.
+			UTexture2D* Tex = UTexture2D::CreateTransient(Width, Height, PF_R8G8B8A8);
+			Tex->SRGB = false;
+			Tex->Filter = TF_Bilinear;
+			Tex->NeverStream = true;
+			Tex->UpdateResource();
+
+			auto NewEntry = MakeShared<FRmlTextureEntry, ESPMode::ThreadSafe>(Tex);
+			NewEntry->bPremultiplied = true;
+			Pool.Add(NewEntry);
+			++TotalCreated;
+		}
+
+		UE_LOG(LogUERmlUI, Log, TEXT("PreallocateTextureReserves: %dx%d → %d reserves (observed %d active)"),
+			Width, Height, Pool.Num(), Pair.Value);
+	}
+
+	if (TotalCreated > 0)
+	{
+		FlushRenderingCommands();
+	}
+
+	UE_LOG(LogUERmlUI, Log, TEXT("PreallocateTextureReserves: created %d reserve textures across %d dimensions"),
+		TotalCreated, ObservedDims.Num());
+}
+
+// ============================================================================
+// Filters
+// ============================================================================
+
+Rml::CompiledFilterHandle FUERmlRenderResources::CompileFilter(const Rml::String& name, const Rml::Dictionary& parameters)
+{
+	auto Filter = MakeShared<FCompiledRmlFilter>();
+
+	if (name == "opacity")
+	{
+		// NOTE: Do NOT return 0 for opacity(1). It would suppress PushLayer, breaking:
+		// 1. Layer isolation (stacking context) for elements like .boxshadow_trail that
+		//    use filter:opacity(1) specifically for correct box-shadow ink overflow clipping.
+		// 2. CSS animations that interpolate through opacity(1) at keyframe boundaries:
+		//    mismatched handle counts between keyframes corrupt interpolation.
+		// The render-time skip (BlendFactor >= 1.0 → break in ApplyFilters) is sufficient.
+		auto it = parameters.find("value");
+		Filter->Type = ERmlFilterType::Passthrough;
+		Filter->BlendFactor = (it != parameters.end()) ? it->second.Get<float>(1.0f) : 1.0f;
+	}
+	else if (name == "blur")
+	{
+		// RmlUI passes the Gaussian sigma directly as "sigma" (not "radius").
+		auto it = parameters.find("sigma");
+		Filter->Type = ERmlFilterType::Blur;
+		Filter->Sigma = (it != parameters.end()) ? it->second.Get<float>(0.0f) : 0.0f;
+		// NOTE: Do NOT return 0 for blur(0). RmlUI logs "Could not compile filter" for
+		// every 0 return, causing per-frame warning spam for data-bound filter strings
+		// that include blur(0px) at default slider values. The render-time skip
+		// (Sigma < 0.01 → break in ApplyFilters) suppresses the no-op pass instead.
+	}
+	else if (name == "drop-shadow")
+	{
+		Filter->Type = ERmlFilterType::DropShadow;
+		auto itColor = parameters.find("color");
+		if (itColor != parameters.end())
+		{
+			Rml::Colourb c = itColor->second.Get<Rml::Colourb>(Rml::Colourb(0, 0, 0, 255));
+			Filter->Color = FLinearColor(c.red / 255.0f, c.green / 255.0f, c.blue / 255.0f, c.alpha / 255.0f);
+		}
+		// RmlUI passes offset as a single Vector2f, not separate x/y.
+		auto itOffset = parameters.find("offset");
+		if (itOffset != parameters.end())
+		{
+			Rml::Vector2f off = itOffset->second.Get<Rml::Vector2f>(Rml::Vector2f(0, 0));
+			Filter->Offset = FVector2f(off.x, off.y);
+		}
+		// Sigma is already the Gaussian standard deviation — no 0.5 multiplication.
+		auto itSigma = parameters.find("sigma");
+		if (itSigma != parameters.end())
+			Filter->Sigma = itSigma->second.Get<float>(0.0f);
+	}
+	else if (name == "brightness" || name == "contrast" || name == "invert" ||
+	         name == "grayscale" || name == "sepia" || name == "saturate" || name == "hue-rotate")
+	{
+		float value = 1.0f;
+		auto it = parameters.find("value");
+		if (it != parameters.end())
+			value = it->second.Get<float>(1.0f);
+
+		// NOTE: Do NOT return 0 for identity color matrix values (brightness(1), sepia(0),
+		// etc.). RmlUI logs "Could not compile filter" for every 0 return — the data-bound
+		// filter string on the outer div emits 8 identity color filters per frame at default
+		// slider values, causing 8 warnings/frame of log spam. FRmlDrawer::CompileFilterSteps
+		// folds identity matrices away at render time, and ExecuteCompositeLayers takes its
+		// bAllIdentity fast path, so the no-op passes are suppressed without warnings.
+		Filter->Type = ERmlFilterType::ColorMatrix;
+
+		// Build 4x4 color matrix based on filter type
+		FMatrix44f M = FMatrix44f::Identity;
+
+		if (name == "brightness")
+		{
+			// Scale RGB by value
+			M.M[0][0] = value; M.M[1][1] = value; M.M[2][2] = value;
+		}
+		else if (name == "contrast")
+		{
+			// Scale and offset: c = (c - 0.5) * value + 0.5
+			// As matrix: scale RGB, add offset via last row
+			float t = (1.0f - value) * 0.5f;
+			M.M[0][0] = value; M.M[1][1] = value; M.M[2][2] = value;
+			// Offset encoded in row 3 (treated as translation in color space)
+			M.M[3][0] = t; M.M[3][1] = t; M.M[3][2] = t;
+		}
+		else if (name == "invert")
+		{
+			// Invert: c = 1 - c (with value as interpolation factor)
+			float v = value;
+			M.M[0][0] = 1.0f - 2.0f * v; M.M[1][1] = 1.0f - 2.0f * v; M.M[2][2] = 1.0f - 2.0f * v;
+			M.M[3][0] = v; M.M[3][1] = v; M.M[3][2] = v;
+		}
+		else if (name == "grayscale")
+		{
+			// Luminance weights
+			float r = 0.2126f, g = 0.7152f, b = 0.0722f;
+			float inv = 1.0f - value;
+			M.M[0][0] = inv + value * r; M.M[0][1] = value * r;       M.M[0][2] = value * r;
+			M.M[1][0] = value * g;       M.M[1][1] = inv + value * g; M.M[1][2] = value * g;
+			M.M[2][0] = value * b;       M.M[2][1] = value * b;       M.M[2][2] = inv + value * b;
+		}
+		else if (name == "sepia")
+		{
+			// Sepia tone matrix (mixed with identity by value)
+			float inv = 1.0f - value;
+			M.M[0][0] = inv + value * 0.393f; M.M[0][1] = value * 0.349f;       M.M[0][2] = value * 0.272f;
+			M.M[1][0] = value * 0.769f;       M.M[1][1] = inv + value * 0.686f; M.M[1][2] = value * 0.534f;
+			M.M[2][0] = value * 0.189f;       M.M[2][1] = value * 0.168f;       M.M[2][2] = inv + value * 0.131f;
+		}
+		else if (name == "saturate")
+		{
+			float r = 0.2126f, g = 0.7152f, b = 0.0722f;
+			float s = value;
+			M.M[0][0] = (1.0f - s) * r + s; M.M[0][1] = (1.0f - s) * r;       M.M[0][2] = (1.0f - s) * r;
+			M.M[1][0] = (1.0f - s) * g;     M.M[1][1] = (1.0f - s) * g + s;   M.M[1][2] = (1.0f - s) * g;
+			M.M[2][0] = (1.0f - s) * b;     M.M[2][1] = (1.0f - s) * b;       M.M[2][2] = (1.0f - s) * b + s;
+		}
+		else if (name == "hue-rotate")
+		{
+			// RmlUI already converts degrees to radians before passing to CompileFilter.
+			float rad = value;
+			float c = FMath::Cos(rad), s = FMath::Sin(rad);
+			float r = 0.2126f, g = 0.7152f, b = 0.0722f;
+
+			M.M[0][0] = r + c * (1 - r) + s * (-r);
+			M.M[0][1] = r + c * (-r)    + s * (0.143f);
+			M.M[0][2] = r + c * (-r)    + s * (-(1 - r));
+
+			M.M[1][0] = g + c * (-g)    + s * (-g);
+			M.M[1][1] = g + c * (1 - g) + s * (0.140f);
+			M.M[1][2] = g + c * (-g)    + s * (g);
+
+			M.M[2][0] = b + c * (-b)    + s * (1 - b);
+			M.M[2][1] = b + c * (-b)    + s * (-0.283f);
+			M.M[2][2] = b + c * (1 - b) + s * (b);
+		}
+
+		Filter->ColorMatrix = M;
+	}
+	else
+	{
+		UE_LOG(LogUERmlUI, Warning, TEXT("CompileFilter: unknown filter '%hs'"), name.c_str());
+		return 0;
+	}
+
+	return AddFilter(Filter);
+}
+
+Rml::CompiledFilterHandle FUERmlRenderResources::AddFilter(const TSharedPtr<FCompiledRmlFilter>& Filter)
+{
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+	Rml::CompiledFilterHandle Handle = NextFilterHandle++;
+	CompiledFilters.Add(Handle, Filter);
+	return Handle;
+}
+
+void FUERmlRenderResources::ReleaseFilter(Rml::CompiledFilterHandle filter)
+{
+	if (filter == 0) return;	// Identity filters return 0 from CompileFilter — nothing to release
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+
+	// Defer removal — the render thread may still reference this filter handle
+	// in a CompositeLayers command recorded earlier this frame (e.g. box-shadow
+	// compiles + uses + releases blur filters within a single callback).
+	PendingFilterReleases.Add(filter);
+}
+
+void FUERmlRenderResources::ResolveFilters(Rml::Span<const Rml::CompiledFilterHandle> Handles, TArray<TSharedPtr<FCompiledRmlFilter>>& OutFilters)
+{
+	FRWScopeLock ScopeLock(Lock, SLT_ReadOnly);
+	OutFilters.Reserve(Handles.size());
+	for (Rml::CompiledFilterHandle Handle : Handles)
+	{
+		if (const TSharedPtr<FCompiledRmlFilter>* Found = CompiledFilters.Find(Handle))
+			OutFilters.Add(*Found);
+	}
+}
+
+// ============================================================================
+// Shaders
+// ============================================================================
+
+Rml::CompiledShaderHandle FUERmlRenderResources::CompileShader(const Rml::String& name, const Rml::Dictionary& parameters)
+{
+	auto Shader = MakeShared<FCompiledRmlShader>();
+
+	auto GetVector2 = [&parameters](const char* Key, const Rml::Vector2f& DefaultValue) -> Rml::Vector2f
+	{
+		if (const auto It = parameters.find(Key); It != parameters.end())
+			return It->second.Get<Rml::Vector2f>(DefaultValue);
+		return DefaultValue;
+	};
+
+	auto GetFloat = [&parameters](const char* Key, float DefaultValue) -> float
+	{
+		if (const auto It = parameters.find(Key); It != parameters.end())
+			return It->second.Get<float>(DefaultValue);
+		return DefaultValue;
+	};
+
+	auto GetBool = [&parameters](const char* Key, bool DefaultValue) -> bool
+	{
+		if (const auto It = parameters.find(Key); It != parameters.end())
+			return It->second.Get<bool>(DefaultValue);
+		return DefaultValue;
+	};
+
+	auto ApplyColorStopList = [&parameters](FCompiledRmlShader& OutShader) -> bool
+	{
+		const auto It = parameters.find("color_stop_list");
+		if (It == parameters.end() || It->second.GetType() != Rml::Variant::COLORSTOPLIST)
+			return false;
+
+		const Rml::ColorStopList& ColorStopList = It->second.GetReference<Rml::ColorStopList>();
+		const int32 NumStops = FMath::Min(static_cast<int32>(ColorStopList.size()), 16);
+
+		OutShader.StopPositions.Reset(NumStops);
+		OutShader.StopColors.Reset(NumStops);
+
+		for (int32 i = 0; i < NumStops; ++i)
+		{
+			const Rml::ColorStop& Stop = ColorStopList[i];
+			const Rml::ColourbPremultiplied& Color = Stop.color;
+
+			OutShader.StopPositions.Add(Stop.position.number);
+			OutShader.StopColors.Add(FLinearColor(
+				Color.red / 255.0f,
+				Color.green / 255.0f,
+				Color.blue / 255.0f,
+				Color.alpha / 255.0f));
+		}
+
+		return OutShader.StopPositions.Num() > 0;
+	};
+
+	if (name == "shader")
+	{
+		const auto ItValue = parameters.find("value");
+		const Rml::String Value = (ItValue != parameters.end())
+			? ItValue->second.Get<Rml::String>(Rml::String())
+			: Rml::String();
+
+		if (Value != "creation")
+		{
+			UE_LOG(LogUERmlUI, Warning, TEXT("CompileShader: unsupported shader value '%hs'"), Value.c_str());
+			return 0;
+		}
+
+		Shader->Type = ERmlShaderType::Creation;
+	}
+	else
+	{
+		Shader->Type = ERmlShaderType::Gradient;
+		const bool bNamedRepeatingLinear = (name == "repeating-linear-gradient");
+		const bool bNamedRepeatingRadial = (name == "repeating-radial-gradient");
+		const bool bNamedRepeatingConic = (name == "repeating-conic-gradient");
+
+		const bool bIsLinearGradient = (name == "linear-gradient" || bNamedRepeatingLinear);
+		const bool bIsRadialGradient = (name == "radial-gradient" || bNamedRepeatingRadial);
+		const bool bIsConicGradient = (name == "conic-gradient" || bNamedRepeatingConic);
+
+		if (!bIsLinearGradient && !bIsRadialGradient && !bIsConicGradient)
+		{
+			UE_LOG(LogUERmlUI, Warning, TEXT("CompileShader: unknown shader '%hs'"), name.c_str());
+			return 0;
+		}
+
+		const bool bRepeating = GetBool("repeating", false) || bNamedRepeatingLinear || bNamedRepeatingRadial || bNamedRepeatingConic;
+
+		if (bIsLinearGradient)
+		{
+			Shader->GradientFunc = bRepeating ? ERmlGradientFunc::RepeatingLinear : ERmlGradientFunc::Linear;
+			const Rml::Vector2f P0 = GetVector2("p0", Rml::Vector2f(0.0f, 0.0f));
+			const Rml::Vector2f P1 = GetVector2("p1", Rml::Vector2f(0.0f, 0.0f));
+			Shader->P = FVector2f(P0.x, P0.y);
+			Shader->V = FVector2f(P1.x - P0.x, P1.y - P0.y);
+		}
+		else if (bIsRadialGradient)
+		{
+			Shader->GradientFunc = bRepeating ? ERmlGradientFunc::RepeatingRadial : ERmlGradientFunc::Radial;
+			const Rml::Vector2f Center = GetVector2("center", Rml::Vector2f(0.0f, 0.0f));
+			const Rml::Vector2f Radius = GetVector2("radius", Rml::Vector2f(1.0f, 1.0f));
+
+			const float SafeRadiusX = FMath::Abs(Radius.x) > KINDA_SMALL_NUMBER ? Radius.x : 1.0f;
+			const float SafeRadiusY = FMath::Abs(Radius.y) > KINDA_SMALL_NUMBER ? Radius.y : 1.0f;
+
+			Shader->P = FVector2f(Center.x, Center.y);
+			Shader->V = FVector2f(1.0f / SafeRadiusX, 1.0f / SafeRadiusY);
+		}
+		else
+		{
+			Shader->GradientFunc = bRepeating ? ERmlGradientFunc::RepeatingConic : ERmlGradientFunc::Conic;
+			const Rml::Vector2f Center = GetVector2("center", Rml::Vector2f(0.0f, 0.0f));
+			const float Angle = GetFloat("angle", 0.0f);
+
+			Shader->P = FVector2f(Center.x, Center.y);
+			Shader->V = FVector2f(FMath::Cos(Angle), FMath::Sin(Angle));
+		}
+
+		if (!ApplyColorStopList(*Shader))
+		{
+			UE_LOG(LogUERmlUI, Warning, TEXT("CompileShader: missing or invalid color_stop_list for '%hs'"), name.c_str());
+			return 0;
+		}
+	}
+
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+	Rml::CompiledShaderHandle Handle = NextShaderHandle++;
+	CompiledShaders.Add(Handle, Shader);
+	return Handle;
+}
+
+void FUERmlRenderResources::ReleaseShader(Rml::CompiledShaderHandle shader)
+{
+	// Recorded draws hold their own reference (ResolveShader), so this can go right away.
+	FRWScopeLock ScopeLock(Lock, SLT_Write);
+	CompiledShaders.Remove(shader);
+}
+
+TSharedPtr<FCompiledRmlShader> FUERmlRenderResources::ResolveShader(Rml::CompiledShaderHandle shader)
+{
+	FRWScopeLock ScopeLock(Lock, SLT_ReadOnly);
+	const TSharedPtr<FCompiledRmlShader>* Found = CompiledShaders.Find(shader);
+	return Found ? *Found : nullptr;
+}
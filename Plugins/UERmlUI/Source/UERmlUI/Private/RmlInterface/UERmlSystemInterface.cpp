@@ -1,7 +1,9 @@
 ﻿#include "RmlInterface/UERmlSystemInterface.h"
 #include "Logging.h"
+#include "RmlTextureCache.h"
 #include "HAL/PlatformApplicationMisc.h"
 #include "RmlUi/Core/URL.h"
+#include "Misc/ScopeLock.h"
 
 FUERmlSystemInterface::FUERmlSystemInterface()
 	: CachedCursor(EMouseCursor::Default)
@@ -146,3 +148,42 @@ void FUERmlSystemInterface::DeactivateKeyboard()
 {
 	// 关闭输入法
 }
+
+bool FUERmlSystemInterface::RunAsync(Rml::Function<void()> task)
+{
+	// RmlUi polls the job from its texture callback; the handle is only kept so
+	// WaitForAsyncTasks can join everything in flight.
+	UE::Tasks::FTask Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(task), UE::Tasks::ETaskPriority::BackgroundNormal);
+
+	FScopeLock ScopeLock(&AsyncTasksLock);
+	AsyncTasks.RemoveAllSwap([](const UE::Tasks::FTask& Pending) { return Pending.IsCompleted(); });
+	AsyncTasks.Add(MoveTemp(Task));
+	return true;
+}
+
+void FUERmlSystemInterface::WaitForAsyncTasks()
+{
+	TArray<UE::Tasks::FTask> Pending;
+	{
+		FScopeLock ScopeLock(&AsyncTasksLock);
+		Pending = MoveTemp(AsyncTasks);
+	}
+	UE::Tasks::Wait(Pending);
+}
+
+bool FUERmlSystemInterface::LoadGeneratedTexture(uint64_t key, Rml::Vector<Rml::byte>& data, Rml::Vector2i& dimensions)
+{
+	TArray<uint8> Pixels;
+	FIntPoint Size;
+	if (!FRmlTextureCache::Get().Find(key, Pixels, Size))
+		return false;
+
+	data.assign(Pixels.GetData(), Pixels.GetData() + Pixels.Num());
+	dimensions = Rml::Vector2i(Size.X, Size.Y);
+	return true;
+}
+
+void FUERmlSystemInterface::StoreGeneratedTexture(uint64_t key, const Rml::Vector<Rml::byte>& data, Rml::Vector2i dimensions)
+{
+	FRmlTextureCache::Get().Add(key, data.data(), (int64)data.size(), FIntPoint(dimensions.x, dimensions.y));
+}
@@ -0,0 +1,257 @@
+#include "RmlTextureCache.h"
+#include "RmlUiSettings.h"
+#include "Logging.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/FileManager.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "HAL/IConsoleManager.h"
+#include "Algo/Sort.h"
+
+// Bump when the file layout, or the way RmlUi generates or keys textures, changes.
+static constexpr uint32 TextureCacheMagic = 0x52544331; // 'RTC1'
+static constexpr int32 TextureCacheVersion = 1;
+
+static FString GetSavedCachePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("RmlUi/TextureCache.bin");
+}
+
+static FString GetSeedCachePath()
+{
+	return FPaths::ProjectContentDir() / TEXT("RmlUi/TextureCache.bin");
+}
+
+FRmlTextureCache& FRmlTextureCache::Get()
+{
+	static FRmlTextureCache Instance;
+	return Instance;
+}
+
+bool FRmlTextureCache::Find(uint64 Key, TArray<uint8>& OutPixels, FIntPoint& OutSize)
+{
+	TArray<uint8> Compressed;
+	int32 RawSize = 0;
+	{
+		FScopeLock ScopeLock(&Lock);
+		LoadIfNeeded();
+
+		FEntry* Entry = Entries.Find(Key);
+		if (!Entry)
+		{
+			++NumMisses;
+			return false;
+		}
+		Entry->LastUse = ++UseCounter;
+		++NumHits;
+		OutSize = Entry->Size;
+		RawSize = Entry->RawSize;
+		Compressed = Entry->Compressed;
+	}
+
+	// Decompress outside the lock, other jobs may be looking up at the same time.
+	OutPixels.SetNumUninitialized(RawSize);
+	if (!FCompression::UncompressMemory(NAME_Oodle, OutPixels.GetData(), RawSize, Compressed.GetData(), Compressed.Num()))
+	{
+		UE_LOG(LogUERmlUI, Warning, TEXT("RmlTextureCache: failed to decompress entry %llx"), Key);
+		OutPixels.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FRmlTextureCache::Add(uint64 Key, const uint8* Pixels, int64 NumBytes, FIntPoint Size)
+{
+	if (NumBytes <= 0 || NumBytes > MAX_int32)
+		return;
+
+	{
+		FScopeLock ScopeLock(&Lock);
+		LoadIfNeeded();
+		if (!bEnabled || Entries.Contains(Key))
+			return;
+	}
+
+	FEntry Entry;
+	Entry.Size = Size;
+	Entry.RawSize = (int32)NumBytes;
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, Entry.RawSize);
+	Entry.Compressed.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(NAME_Oodle, Entry.Compressed.GetData(), CompressedSize, Pixels, Entry.RawSize))
+		return;
+	Entry.Compressed.SetNum(CompressedSize);
+
+	FScopeLock ScopeLock(&Lock);
+	if (CompressedSize > MaxBytes || Entries.Contains(Key))
+		return;
+
+	EvictToFit(CompressedSize);
+	Entry.LastUse = ++UseCounter;
+	CompressedBytes += CompressedSize;
+	Entries.Add(Key, MoveTemp(Entry));
+	bDirty = true;
+}
+
+void FRmlTextureCache::EvictToFit(int64 IncomingBytes)
+{
+	if (CompressedBytes + IncomingBytes <= MaxBytes)
+		return;
+
+	// Trim to 90% of the budget so a full cache sorts once per batch of adds,
+	// not on every one.
+	const int64 TargetBytes = MaxBytes - MaxBytes / 10 - IncomingBytes;
+
+	TArray<TPair<uint64, uint64>> ByAge; // LastUse, Key
+	ByAge.Reserve(Entries.Num());
+	for (const auto& Pair : Entries)
+		ByAge.Emplace(Pair.Value.LastUse, Pair.Key);
+	Algo::Sort(ByAge, [](const TPair<uint64, uint64>& A, const TPair<uint64, uint64>& B) { return A.Key < B.Key; });
+
+	int32 NumEvicted = 0;
+	for (const TPair<uint64, uint64>& Oldest : ByAge)
+	{
+		if (CompressedBytes <= TargetBytes)
+			break;
+		FEntry Removed;
+		if (Entries.RemoveAndCopyValue(Oldest.Value, Removed))
+		{
+			CompressedBytes -= Removed.Compressed.Num();
+			++NumEvicted;
+		}
+	}
+
+	if (NumEvicted > 0)
+	{
+		bDirty = true;
+		UE_LOG(LogUERmlUI, Verbose, TEXT("RmlTextureCache: evicted %d least recently used textures (%.1f MB kept)"),
+			NumEvicted, CompressedBytes / (1024.0 * 1024.0));
+	}
+}
+
+int32 FRmlTextureCache::GetNumEntries() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Entries.Num();
+}
+
+void FRmlTextureCache::LoadIfNeeded()
+{
+	if (bLoaded)
+		return;
+	bLoaded = true;
+
+	// Read once: Flush may run during module shutdown, after settings are gone.
+	const URmlUiSettings* Settings = URmlUiSettings::Get();
+	bEnabled = Settings->bPersistentTextureCache;
+	MaxBytes = (int64)Settings->TextureCacheMaxSizeMB * 1024 * 1024;
+	if (!bEnabled)
+		return;
+
+	if (!LoadFromFile(GetSavedCachePath()))
+		LoadFromFile(GetSeedCachePath());
+
+	// The budget may have been lowered since the file was written.
+	EvictToFit(0);
+}
+
+bool FRmlTextureCache::LoadFromFile(const FString& Path)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+		return false;
+
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 Num = 0;
+	Reader << Magic << Version << Num;
+	if (Magic != TextureCacheMagic || Version != TextureCacheVersion || Num < 0)
+	{
+		UE_LOG(LogUERmlUI, Log, TEXT("RmlTextureCache: ignoring '%s' (old or unknown format)"), *Path);
+		return false;
+	}
+
+	Entries.Reserve(Num);
+	for (int32 i = 0; i < Num && !Reader.IsError(); ++i)
+	{
+		uint64 Key = 0;
+		FEntry Entry;
+		Reader << Key << Entry.Size << Entry.RawSize << Entry.Compressed;
+		// The file is written oldest first, so load order is recency order.
+		Entry.LastUse = ++UseCounter;
+		CompressedBytes += Entry.Compressed.Num();
+		Entries.Add(Key, MoveTemp(Entry));
+	}
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogUERmlUI, Warning, TEXT("RmlTextureCache: '%s' is truncated, discarding it"), *Path);
+		Entries.Reset();
+		CompressedBytes = 0;
+		return false;
+	}
+
+	UE_LOG(LogUERmlUI, Log, TEXT("RmlTextureCache: loaded %d textures (%.1f MB) from '%s'"),
+		Entries.Num(), CompressedBytes / (1024.0 * 1024.0), *Path);
+	return true;
+}
+
+void FRmlTextureCache::Flush()
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!bDirty)
+		return;
+	bDirty = false;
+
+	// Oldest first, so the next session's load order carries the recency over.
+	Entries.ValueSort([](const FEntry& A, const FEntry& B) { return A.LastUse < B.LastUse; });
+
+	TArray<uint8> Bytes;
+	Bytes.Reserve(CompressedBytes + Entries.Num() * 32 + 16);
+	FMemoryWriter Writer(Bytes);
+	uint32 Magic = TextureCacheMagic;
+	int32 Version = TextureCacheVersion;
+	int32 Num = Entries.Num();
+	Writer << Magic << Version << Num;
+	for (auto& Pair : Entries)
+	{
+		uint64 Key = Pair.Key;
+		Writer << Key << Pair.Value.Size << Pair.Value.RawSize << Pair.Value.Compressed;
+	}
+
+	const FString Path = GetSavedCachePath();
+	if (FFileHelper::SaveArrayToFile(Bytes, *Path))
+	{
+		UE_LOG(LogUERmlUI, Log, TEXT("RmlTextureCache: saved %d textures (%.1f MB), %d hits / %d misses this session"),
+			Entries.Num(), CompressedBytes / (1024.0 * 1024.0), NumHits, NumMisses);
+	}
+	else
+	{
+		UE_LOG(LogUERmlUI, Warning, TEXT("RmlTextureCache: failed to write '%s'"), *Path);
+	}
+}
+
+void FRmlTextureCache::Clear()
+{
+	FScopeLock ScopeLock(&Lock);
+	LoadIfNeeded();
+	Entries.Reset();
+	CompressedBytes = 0;
+	bDirty = false;
+	IFileManager::Get().Delete(*GetSavedCachePath(), false, false, true);
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommand GRmlClearTextureCache(
+	TEXT("rmlui.ClearTextureCache"),
+	TEXT("Delete the persistent cache of generated font-effect textures (Saved/RmlUi/TextureCache.bin)."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FRmlTextureCache::Get().Clear();
+		UE_LOG(LogUERmlUI, Log, TEXT("rmlui.ClearTextureCache: cleared"));
+	}));
+#endif
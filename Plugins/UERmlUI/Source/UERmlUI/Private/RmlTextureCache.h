@@ -0,0 +1,56 @@
+#pragma once
+#include "CoreMinimal.h"
+
+// Persistent cache of textures RmlUi generates on the CPU (font-effect layers:
+// blur, glow, shadow, outline). RmlUi keys each texture by a hash of the effect,
+// glyph layout and glyph bitmaps, so font face, size and dp-ratio are all part of
+// the key and a stale entry simply never hits.
+//
+// Entries are kept compressed in memory and written to Saved/RmlUi/TextureCache.bin.
+// The compressed size is capped at TextureCacheMaxSizeMB; least recently used
+// entries are evicted to make room, and the file is written in recency order so
+// the next session keeps evicting the same ones first.
+// A read-only seed can ship at Content/RmlUi/TextureCache.bin (stage it as a
+// non-asset directory); it is used when there is no saved cache yet.
+//
+// Find/Add are thread-safe: texture generation jobs call them from workers.
+class FRmlTextureCache
+{
+public:
+	static FRmlTextureCache& Get();
+
+	bool Find(uint64 Key, TArray<uint8>& OutPixels, FIntPoint& OutSize);
+	void Add(uint64 Key, const uint8* Pixels, int64 NumBytes, FIntPoint Size);
+
+	// Write the cache to disk if anything was added since the last flush.
+	void Flush();
+	// Drop all entries, in memory and on disk.
+	void Clear();
+
+	int32 GetNumEntries() const;
+
+private:
+	struct FEntry
+	{
+		FIntPoint		Size;
+		int32			RawSize = 0;
+		TArray<uint8>	Compressed;
+		uint64			LastUse = 0;	// UseCounter at the last lookup or add
+	};
+
+	void LoadIfNeeded();
+	bool LoadFromFile(const FString& Path);
+	// Evict least recently used entries until CompressedBytes + IncomingBytes fits MaxBytes.
+	void EvictToFit(int64 IncomingBytes);
+
+	mutable FCriticalSection	Lock;
+	TMap<uint64, FEntry>		Entries;
+	int64						CompressedBytes = 0;
+	int64						MaxBytes = 0;
+	uint64						UseCounter = 0;
+	bool						bEnabled = false;
+	bool						bLoaded = false;
+	bool						bDirty = false;
+	int32						NumHits = 0;
+	int32						NumMisses = 0;
+};
@@ -1,6 +1,7 @@
 #include "RmlUiWidget.h"
 #include "SRmlWidget.h"
 #include "RmlWarmer.h"
+#include "RmlContextScheduler.h"
 #include "RmlUiSettings.h"
 #include "RmlInterface/UERmlRenderInterface.h"
 #include "RmlUi/Core.h"
@@ -17,8 +18,7 @@ TSharedRef<SWidget> URmlUiWidget::RebuildWidget()
 		// without this, it would access the freed context (use-after-free on root_element).
 		if (RmlSlateWidget.IsValid())
 			RmlSlateWidget->Context(nullptr);
-		Rml::RemoveContext(TCHAR_TO_UTF8(*ContextName));
-		ContextName.Empty();
+		RemoveContext();
 	}
 
 	// Use pre-warmed context if available, otherwise create fresh at 1×1.
@@ -26,9 +26,7 @@ TSharedRef<SWidget> URmlUiWidget::RebuildWidget()
 	if (!PrewarmedContext)
 	{
 		ContextName = FString::Printf(TEXT("UERmlWidget_%d"), GRmlContextCounter++);
-		PrewarmedContext = Rml::CreateContext(
-			TCHAR_TO_UTF8(*ContextName),
-			Rml::Vector2i(1, 1));
+		PrewarmedContext = CreateContext(Rml::Vector2i(1, 1));
 	}
 	// else: ContextName + PrewarmedContext already set by PrewarmFromSettings()
 
@@ -70,10 +68,7 @@ void URmlUiWidget::ReleaseSlateResources(bool bReleaseChildren)
 	if (RmlSlateWidget.IsValid())
 		RmlSlateWidget->Context(nullptr);
 	if (!ContextName.IsEmpty())
-	{
-		Rml::RemoveContext(TCHAR_TO_UTF8(*ContextName));
-		ContextName.Empty();
-	}
+		RemoveContext();
 	PrewarmedContext = nullptr;
 	RmlSlateWidget.Reset();
 }
@@ -81,12 +76,12 @@ void URmlUiWidget::ReleaseSlateResources(bool bReleaseChildren)
 void URmlUiWidget::PrewarmFromSettings()
 {
 	const TArray<FRmlWarmupDocumentEntry>& Entries = URmlUiSettings::Get()->WarmupDocuments;
-	if (Entries.IsEmpty()) return;
+	if (Entries.IsEmpty() && !FRmlWarmer::HasFontManifest()) return;
 
 	// Abandon any stale pre-warmed context from a previous call.
 	if (PrewarmedContext)
 	{
-		Rml::RemoveContext(TCHAR_TO_UTF8(*ContextName));
+		RemoveContext();
 		PrewarmedContext = nullptr;
 	}
 
@@ -101,12 +96,34 @@ void URmlUiWidget::PrewarmFromSettings()
 	}
 
 	ContextName = FString::Printf(TEXT("UERmlWidget_%d"), GRmlContextCounter++);
-	PrewarmedContext = Rml::CreateContext(TCHAR_TO_UTF8(*ContextName), Dims);
+	PrewarmedContext = CreateContext(Dims);
 
-	FUERmlRenderInterface* RI = static_cast<FUERmlRenderInterface*>(Rml::GetRenderInterface());
+	FUERmlRenderInterface* RI = ContextRecorder ? ContextRecorder : static_cast<FUERmlRenderInterface*>(Rml::GetRenderInterface());
 	FRmlWarmer::WarmContext(PrewarmedContext, Entries, RI);
 }
 
+Rml::Context* URmlUiWidget::CreateContext(Rml::Vector2i Dimensions)
+{
+	if (URmlUiSettings::Get()->bIsolateContextRendering)
+		ContextRecorder = FUERmlRenderResources::Get().AcquireRecorder();
+	Rml::Context* Context = Rml::CreateContext(TCHAR_TO_UTF8(*ContextName), Dimensions, ContextRecorder);
+	// Only a context with a render manager of its own can be updated alongside others.
+	if (Context && ContextRecorder)
+		FRmlContextScheduler::Get().Register(Context);
+	return Context;
+}
+
+void URmlUiWidget::RemoveContext()
+{
+	// The context releases its geometry and textures through the recorder, so the
+	// recorder goes back to the pool only after it is gone.
+	FRmlContextScheduler::Get().Unregister(Rml::GetContext(TCHAR_TO_UTF8(*ContextName)));
+	Rml::RemoveContext(TCHAR_TO_UTF8(*ContextName));
+	ContextName.Empty();
+	FUERmlRenderResources::Get().ReleaseRecorder(ContextRecorder);
+	ContextRecorder = nullptr;
+}
+
 int32 URmlUiWidget::ReloadDocuments()
 {
 	Rml::Context* Ctx = GetContext();
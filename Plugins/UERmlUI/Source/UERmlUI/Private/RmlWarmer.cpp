@@ -1,10 +1,23 @@
 #include "RmlWarmer.h"
 #include "RmlInterface/UERmlRenderInterface.h"
+#include "RmlInterface/UERmlSystemInterface.h"
 #include "RmlUiSettings.h"
 #include "Logging.h"
+#include "RmlTextureCache.h"
 #include "RmlUi/Core/Context.h"
+#include "RmlUi/Core/Core.h"
 #include "RmlUi/Core/ElementDocument.h"
 #include "RmlUi/Core/Elements/ElementTabSet.h"
+#include "RmlUi/Core/FontEngineInterface.h"
+#include "RmlUi/Core/Mesh.h"
+#include "RmlUi/Core/PropertyDictionary.h"
+#include "RmlUi/Core/RenderManager.h"
+#include "RmlUi/Core/StringUtilities.h"
+#include "RmlUi/Core/StyleSheetSpecification.h"
+#include "RmlUi/Core/TextShapingContext.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
 
 /**
  * Run convergence passes until no new textures are generated.
@@ -55,8 +68,240 @@ static int32 WarmTabset(Rml::Context* Context, FUERmlRenderInterface* RI,
 	return TotalNew;
 }
 
+// ============================================================================
+// Font manifest
+// ============================================================================
+
+// Manifest key (a line without its characters column) -> code points drawn with it.
+using FRmlFontManifest = TMap<FString, TSet<uint32>>;
+
+static FString GetFontManifestPath()
+{
+	return FPaths::ProjectContentDir() / TEXT("RmlUi/WarmupManifest.txt");
+}
+
+static FString MakeFontManifestKey(const FRmlWarmupFontConfig& Config)
+{
+	return FString::Printf(TEXT("%s\t%s\t%d\t%d\t%s"),
+		*Config.Family,
+		Config.bItalic ? TEXT("italic") : TEXT("normal"),
+		Config.Weight,
+		Config.Size,
+		Config.FontEffects.IsEmpty() ? TEXT("none") : *Config.FontEffects);
+}
+
+static bool ParseFontManifestKey(const FString& Key, FRmlWarmupFontConfig& OutConfig)
+{
+	TArray<FString> Fields;
+	Key.ParseIntoArray(Fields, TEXT("\t"), false);
+	if (Fields.Num() != 5)
+		return false;
+
+	OutConfig.Family = Fields[0];
+	OutConfig.bItalic = (Fields[1] == TEXT("italic"));
+	OutConfig.Weight = FCString::Atoi(*Fields[2]);
+	OutConfig.Size = FCString::Atoi(*Fields[3]);
+	OutConfig.FontEffects = (Fields[4] == TEXT("none") ? FString() : Fields[4]);
+	return !OutConfig.Family.IsEmpty() && OutConfig.Size > 0;
+}
+
+static void LoadFontManifest(FRmlFontManifest& OutManifest)
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *GetFontManifestPath()))
+		return;
+
+	for (const FString& Line : Lines)
+	{
+		int32 Tab = INDEX_NONE;
+		if (Line.IsEmpty() || Line.StartsWith(TEXT("#")) || !Line.FindLastChar(TEXT('\t'), Tab))
+			continue;
+
+		TSet<uint32>& Characters = OutManifest.FindOrAdd(Line.Left(Tab));
+		const Rml::String Utf8 = TCHAR_TO_UTF8(*Line.Mid(Tab + 1));
+		for (Rml::StringIteratorU8 It(Utf8); It; ++It)
+			Characters.Add((uint32)*It);
+	}
+}
+
+static bool SaveFontManifest(const FRmlFontManifest& Manifest)
+{
+	TArray<FString> Keys;
+	Manifest.GetKeys(Keys);
+	Keys.Sort();
+
+	FString Text = TEXT("# RmlUi font warmup manifest, written by rmlui.CaptureWarmup. One line per font configuration,\n")
+		TEXT("# sorted; captures merge into it. Columns: family, style, weight, size (px), font-effect, characters.\n");
+
+	for (const FString& Key : Keys)
+	{
+		TArray<uint32> Characters = Manifest[Key].Array();
+		Characters.Sort();
+
+		Rml::String Utf8;
+		for (uint32 Character : Characters)
+			Utf8 += Rml::StringUtilities::ToUTF8((Rml::Character)Character);
+
+		Text += Key;
+		Text += TEXT("\t");
+		Text += UTF8_TO_TCHAR(Utf8.c_str());
+		Text += TEXT("\n");
+	}
+
+	return FFileHelper::SaveStringToFile(Text, *GetFontManifestPath(), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+bool FRmlWarmer::HasFontManifest()
+{
+	return FPaths::FileExists(GetFontManifestPath());
+}
+
+int32 FRmlWarmer::WarmFontManifest(Rml::Context* Context)
+{
+	if (!Context) return 0;
+
+	FRmlFontManifest Manifest;
+	LoadFontManifest(Manifest);
+	if (Manifest.IsEmpty()) return 0;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	Rml::FontEngineInterface* FontEngine = Rml::GetFontEngineInterface();
+	Rml::RenderManager& RenderManager = Context->GetRenderManager();
+	RenderManager.SetCallbackTextureBudget(-1.0);
+
+	const Rml::String Language;
+	const Rml::TextShapingContext ShapingContext{ Language };
+
+	struct FResolvedEntry
+	{
+		Rml::FontFaceHandle		Face;
+		FString					FontEffects;
+		Rml::String				Text;
+	};
+	TArray<FResolvedEntry> Resolved;
+	TMap<Rml::FontFaceHandle, Rml::String> TextPerFace;
+
+	for (const auto& Pair : Manifest)
+	{
+		FRmlWarmupFontConfig Config;
+		if (!ParseFontManifestKey(Pair.Key, Config))
+			continue;
+
+		const Rml::FontFaceHandle Face = FontEngine->GetFontFaceHandle(TCHAR_TO_UTF8(*Config.Family),
+			Config.bItalic ? Rml::Style::FontStyle::Italic : Rml::Style::FontStyle::Normal,
+			(Rml::Style::FontWeight)Config.Weight, Config.Size);
+		if (!Face)
+			continue;
+
+		FResolvedEntry& Entry = Resolved.AddDefaulted_GetRef();
+		Entry.Face = Face;
+		Entry.FontEffects = Config.FontEffects;
+		for (uint32 Character : Pair.Value)
+			Entry.Text += Rml::StringUtilities::ToUTF8((Rml::Character)Character);
+		TextPerFace.FindOrAdd(Face) += Entry.Text;
+	}
+
+	// Load every glyph of a face before generating any of its layers. A glyph added
+	// later dirties the face and regenerates all of its layer textures.
+	for (const auto& Pair : TextPerFace)
+		FontEngine->GetStringWidth(Pair.Key, Pair.Value, ShapingContext);
+
+	int32 NumTextures = 0;
+	for (const FResolvedEntry& Entry : Resolved)
+	{
+		Rml::FontEffectsHandle Effects = 0;
+		if (!Entry.FontEffects.IsEmpty())
+		{
+			Rml::PropertyDictionary Properties;
+			const Rml::Property* Property = nullptr;
+			if (Rml::StyleSheetSpecification::ParsePropertyDeclaration(Properties, "font-effect", TCHAR_TO_UTF8(*Entry.FontEffects)))
+				Property = Properties.GetProperty(Rml::PropertyId::FontEffect);
+
+			const Rml::FontEffectsPtr EffectList = Property ? Property->Get<Rml::FontEffectsPtr>() : nullptr;
+			if (!EffectList)
+			{
+				UE_LOG(LogUERmlUI, Warning, TEXT("RmlWarmer: invalid font-effect '%s' in manifest"), *Entry.FontEffects);
+				continue;
+			}
+			Effects = FontEngine->PrepareFontEffects(Entry.Face, EffectList->list);
+		}
+
+		Rml::TexturedMeshList Meshes;
+		FontEngine->GenerateString(RenderManager, Entry.Face, Effects, Entry.Text, Rml::Vector2f(0.f),
+			Rml::ColourbPremultiplied(255), 1.f, ShapingContext, Meshes);
+
+		// GenerateString only sets up the callback textures; asking for their size generates them.
+		for (const Rml::TexturedMesh& Mesh : Meshes)
+		{
+			if (Mesh.texture)
+			{
+				Mesh.texture.GetDimensions();
+				++NumTextures;
+			}
+		}
+	}
+
+	UE_LOG(LogUERmlUI, Log, TEXT("RmlWarmer: warmed %d font configurations (%d textures) from manifest in %.1f ms"),
+		Resolved.Num(), NumTextures, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	return Resolved.Num();
+}
+
 #if !UE_BUILD_SHIPPING
 
+static FRmlFontManifest GCapturedFonts;
+static FCriticalSection GCapturedFontsLock;
+
+void FRmlWarmer::CaptureFontString(const FRmlWarmupFontConfig& Config, const char* Text, int32 Length)
+{
+	const FString Key = MakeFontManifestKey(Config);
+
+	FScopeLock Lock(&GCapturedFontsLock);
+	TSet<uint32>& Characters = GCapturedFonts.FindOrAdd(Key);
+	for (Rml::StringIteratorU8 It(Text, Text, Text + Length); It; ++It)
+	{
+		// Whitespace and control characters have no bitmap, and would break the line format.
+		if ((uint32)*It > 32)
+			Characters.Add((uint32)*It);
+	}
+}
+
+static void SaveCapturedFontManifest()
+{
+	FRmlFontManifest Manifest;
+	{
+		FScopeLock Lock(&GCapturedFontsLock);
+		if (GCapturedFonts.IsEmpty())
+			return;
+		Manifest = GCapturedFonts;
+	}
+
+	// Merge into the existing manifest rather than replacing it, so captures from
+	// sessions that visited different pages add up.
+	FRmlFontManifest Existing;
+	LoadFontManifest(Existing);
+	for (auto& Pair : Existing)
+		Manifest.FindOrAdd(Pair.Key).Append(Pair.Value);
+
+	if (SaveFontManifest(Manifest))
+	{
+		UE_LOG(LogUERmlUI, Log, TEXT("RmlWarmer: saved %d font configurations to '%s'"), Manifest.Num(), *GetFontManifestPath());
+	}
+	else
+	{
+		UE_LOG(LogUERmlUI, Warning, TEXT("RmlWarmer: failed to write '%s'"), *GetFontManifestPath());
+	}
+}
+
+static FAutoConsoleCommand GRmlSaveWarmupCapture(
+	TEXT("rmlui.SaveWarmupCapture"),
+	TEXT("Save what rmlui.CaptureWarmup recorded so far: document URLs to DefaultGame.ini and\n")
+	TEXT("font configurations to the font manifest (Content/RmlUi/WarmupManifest.txt)."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FRmlWarmer::SaveCapturedEntries(static_cast<FUERmlRenderInterface*>(Rml::GetRenderInterface()));
+	}));
+
 static TAutoConsoleVariable<int32> CVarRmlCaptureWarmup(
 	TEXT("rmlui.CaptureWarmup"),
 	0,
@@ -72,6 +317,8 @@ bool FRmlWarmer::IsCaptureEnabled()
 
 void FRmlWarmer::SaveCapturedEntries(FUERmlRenderInterface* RI)
 {
+	SaveCapturedFontManifest();
+
 	if (!RI) return;
 
 	const TSet<FString>& Urls = RI->GetCapturedDocumentUrls();
@@ -104,7 +351,7 @@ void FRmlWarmer::WarmContext(
 	const TArray<FRmlWarmupDocumentEntry>& Entries,
 	FUERmlRenderInterface* RI)
 {
-	if (!Context || !RI || Entries.IsEmpty()) return;
+	if (!Context || !RI) return;
 
 #if !UE_BUILD_SHIPPING
 	// In capture mode, skip warmup so live rendering triggers GenerateTexture
@@ -112,59 +359,132 @@ void FRmlWarmer::WarmContext(
 	if (IsCaptureEnabled()) return;
 #endif
 
+	// The manifest names exactly the font configurations the UI draws with, so
+	// there is no need to load, lay out and tab-cycle whole documents.
+	if (WarmFontManifest(Context) > 0)
+	{
+		RI->PreallocateTextureReserves();
+		FRmlTextureCache::Get().Flush();
+		return;
+	}
+
+	if (Entries.IsEmpty()) return;
+
+	const double StartTime = FPlatformTime::Seconds();
+	Rml::RenderManager& RenderManager = Context->GetRenderManager();
+	FUERmlSystemInterface* SystemInterface = static_cast<FUERmlSystemInterface*>(Rml::GetSystemInterface());
+	const bool bParallel = URmlUiSettings::Get()->bParallelWarmup && SystemInterface;
+
+	struct FWarmDocument
+	{
+		Rml::ElementDocument*	Doc = nullptr;
+		const FString*			Path = nullptr;
+		bool					bLoadedForWarmup = false;
+		bool					bWasVisible = false;
+		double					PrepareMs = 0.0;
+		double					UploadMs = 0.0;
+	};
+	TArray<FWarmDocument> Documents;
+
+	// Settle and tab-cycle one document. Documents that started hidden are shown
+	// for the duration and hidden again; visible ones are left as they are so
+	// their modality, focus and z-order are not disturbed.
+	auto WarmDocument = [Context, RI](FWarmDocument& Warm)
+	{
+		if (!Warm.bWasVisible)
+			Warm.Doc->Show();
+		WarmSettle(Context, RI);
+
+		// Auto-detect tabset and cycle all tabs
+		Rml::ElementList Tabsets;
+		Warm.Doc->GetElementsByTagName(Tabsets, "tabset");
+		if (!Tabsets.empty())
+		{
+			auto* Tabset = static_cast<Rml::ElementTabSet*>(Tabsets[0]);
+			WarmTabset(Context, RI, Tabset, Warm.bWasVisible ? Tabset->GetActiveTab() : 0);
+		}
+
+		if (!Warm.bWasVisible)
+			Warm.Doc->Hide();
+	};
+
+	// Pass 1 (game thread): load, lay out and render every document. In parallel
+	// mode font-effect layers are not generated here: each one starts a worker job
+	// (see FontFaceLayer), so the convolution work of all documents overlaps.
+	RenderManager.SetCallbackTextureBudget(bParallel ? TNumericLimits<double>::Max() : -1.0);
+
 	for (const FRmlWarmupDocumentEntry& Entry : Entries)
 	{
+		const double DocStartTime = FPlatformTime::Seconds();
 		const std::string UrlUtf8 = TCHAR_TO_UTF8(*Entry.DocumentPath);
 
 		// Prefer an already-loaded document with this URL so we warm the actual
 		// instance (and its CallbackTexture handles) rather than a parallel copy.
 		// Warming a copy (Document B) leaves Document A's CallbackTextureSources
 		// with no handles, causing the CPU ConvolutionFilter to run on first live render.
-		Rml::ElementDocument* Doc = nullptr;
-		bool bLoadedForWarmup = false;
+		FWarmDocument Warm;
+		Warm.Path = &Entry.DocumentPath;
 
 		for (int32 i = 0, N = Context->GetNumDocuments(); i < N; ++i)
 		{
 			Rml::ElementDocument* Existing = Context->GetDocument(i);
 			if (Existing && Existing->GetSourceURL() == UrlUtf8)
 			{
-				Doc = Existing;
+				Warm.Doc = Existing;
 				break;
 			}
 		}
 
-		if (!Doc)
+		if (!Warm.Doc)
 		{
-			Doc = Context->LoadDocument(UrlUtf8);
-			bLoadedForWarmup = true;
+			Warm.Doc = Context->LoadDocument(UrlUtf8);
+			Warm.bLoadedForWarmup = true;
 		}
 
-		if (!Doc)
+		if (!Warm.Doc)
 		{
 			UE_LOG(LogUERmlUI, Warning, TEXT("RmlWarmer: failed to load '%s'"), *Entry.DocumentPath);
 			continue;
 		}
 
-		const bool bWasVisible = Doc->IsVisible();
-		if (!bWasVisible)
-			Doc->Show();
+		Warm.bWasVisible = Warm.Doc->IsVisible();
+		WarmDocument(Warm);
+		Warm.PrepareMs = (FPlatformTime::Seconds() - DocStartTime) * 1000.0;
+		Documents.Add(Warm);
+	}
 
-		WarmSettle(Context, RI);
+	// Pass 2: wait for the generation jobs, then render every document once more so
+	// the finished layers are uploaded here on the game thread. Anything the first
+	// pass did not reach is generated synchronously now.
+	double WaitMs = 0.0;
+	if (bParallel)
+	{
+		const double WaitStartTime = FPlatformTime::Seconds();
+		SystemInterface->WaitForAsyncTasks();
+		WaitMs = (FPlatformTime::Seconds() - WaitStartTime) * 1000.0;
 
-		// Auto-detect tabset and cycle all tabs
-		Rml::ElementList Tabsets;
-		Doc->GetElementsByTagName(Tabsets, "tabset");
-		if (!Tabsets.empty())
-			WarmTabset(Context, RI, static_cast<Rml::ElementTabSet*>(Tabsets[0]), 0);
+		RenderManager.SetCallbackTextureBudget(-1.0);
+		for (FWarmDocument& Warm : Documents)
+		{
+			const double DocStartTime = FPlatformTime::Seconds();
+			WarmDocument(Warm);
+			Warm.UploadMs = (FPlatformTime::Seconds() - DocStartTime) * 1000.0;
+		}
+	}
 
-		if (bLoadedForWarmup)
-			Doc->Close(); // loaded only for warmup — remove from context
-		else if (!bWasVisible)
-			Doc->Hide(); // restore original hidden state
+	for (const FWarmDocument& Warm : Documents)
+	{
+		UE_LOG(LogUERmlUI, Log, TEXT("RmlWarmer: '%s' prepare %.1f ms, upload %.1f ms"),
+			**Warm.Path, Warm.PrepareMs, Warm.UploadMs);
+
+		if (Warm.bLoadedForWarmup)
+			Warm.Doc->Close(); // loaded only for warmup — remove from context
 	}
 
 	RI->PreallocateTextureReserves();
-	UE_LOG(LogUERmlUI, Log, TEXT("RmlWarmer: warmup complete (%d documents)"), Entries.Num());
+	FRmlTextureCache::Get().Flush();
+	UE_LOG(LogUERmlUI, Log, TEXT("RmlWarmer: warmup complete (%d documents) in %.1f ms, %.1f ms waiting for %s generation"),
+		Documents.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0, WaitMs, bParallel ? TEXT("parallel") : TEXT("no"));
 }
 
 // ============================================================================
@@ -177,6 +497,8 @@ void FRmlWarmer::WarmAllDocuments(Rml::Context* Context, FUERmlRenderInterface*
 	if (IsCaptureEnabled()) return;
 #endif
 
+	Context->GetRenderManager().SetCallbackTextureBudget(-1.0);
+
 	const int32 NumDocs = Context->GetNumDocuments();
 	if (NumDocs == 0) return;
 
@@ -212,6 +534,7 @@ void FRmlWarmer::WarmAllDocuments(Rml::Context* Context, FUERmlRenderInterface*
 	if (TotalNewTextures > 0)
 	{
 		RI->PreallocateTextureReserves();
+		FRmlTextureCache::Get().Flush();
 		UE_LOG(LogUERmlUI, Log, TEXT("RmlWarmer: post-dim settle caught %d new textures across %d documents"),
 			TotalNewTextures, NumDocs);
 	}
@@ -1,10 +1,12 @@
 ﻿#include "SRmlWidget.h"
 #include "RmlHelper.h"
 #include "RmlWarmer.h"
+#include "RmlContextScheduler.h"
 #include "RmlUiSettings.h"
 #include "Logging.h"
 #include "RmlInterface/UERmlSystemInterface.h"
 #include "RmlInterface/UERmlRenderInterface.h"
+#include "Render/RmlDrawer.h"
 #include "RmlUi/Core.h"
 
 DECLARE_STATS_GROUP(TEXT("RmlUI_Game"), STATGROUP_RmlUI_Game, STATCAT_Advanced);
@@ -13,16 +15,24 @@ DECLARE_CYCLE_STAT(TEXT("RmlUI Context Render"),  STAT_RmlUI_ContextRender, STAT
 
 void SRmlWidget::Construct(const FArguments& InArgs)
 {
-	BoundContext = InArgs._InitContext;
+	Context(InArgs._InitContext);
 	CachedSystemInterface = InArgs._InitSystemInterface;
 	if (!CachedSystemInterface)
 		CachedSystemInterface = static_cast<FUERmlSystemInterface*>(Rml::GetSystemInterface());
 	bEnableRml = InArgs._InitEnableRml;
 	bHandleCursor = InArgs._InitHandleCursor;
-	CachedRenderInterface = static_cast<FUERmlRenderInterface*>(Rml::GetRenderInterface());
 	OnEmptyClick = InArgs._OnEmptyClick;
 }
 
+void SRmlWidget::Context(Rml::Context* InContext)
+{
+	BoundContext = InContext;
+	// Every render interface handed to RmlUi by this plugin is an FUERmlRenderInterface.
+	CachedRenderInterface = InContext
+		? static_cast<FUERmlRenderInterface*>(InContext->GetRenderManager().GetRenderInterface())
+		: static_cast<FUERmlRenderInterface*>(Rml::GetRenderInterface());
+}
+
 bool SRmlWidget::AddToViewport(UWorld* InWorld, int32 ZOrder)
 {
 	UGameViewportClient* ViewportClient = InWorld->GetGameViewport();
@@ -137,8 +147,11 @@ void SRmlWidget::Tick(const FGeometry& AllottedGeometry, const double InCurrentT
 		ActiveUiScale = 1.0f;
 	}
 
+	// Resizing dirties the layout the scheduler's batch computed at the start of the frame.
+	bool bContextResized = false;
 	if (DesiredContextSize != BoundContext->GetDimensions())
 	{
+		bContextResized = true;
 		BoundContext->SetDimensions(DesiredContextSize);
 		// NOTE: Do NOT call Rml::ReleaseTextures here. Callback textures (font effects,
 		// box-shadow) depend on CSS properties (dp values), not viewport dimensions.
@@ -154,11 +167,18 @@ void SRmlWidget::Tick(const FGeometry& AllottedGeometry, const double InCurrentT
 	// density. CachedDPIScale = 0 forces the call on the very first Tick.
 	if (!FMath::IsNearlyEqual(DesiredDpRatio, CachedDPIScale, 1e-4f))
 	{
+		bContextResized = true;
 		CachedDPIScale = DesiredDpRatio;
 		BoundContext->SetDensityIndependentPixelRatio(DesiredDpRatio);
 	}
 
-	{ SCOPE_CYCLE_COUNTER(STAT_RmlUI_ContextUpdate); BoundContext->Update(); }
+	// Contexts batched by FRmlContextScheduler were already updated on workers this frame.
+	const bool bBatchedUpdate = FRmlContextScheduler::Get().ConsumeBatchedUpdate(BoundContext);
+	if (!bBatchedUpdate || bContextResized)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RmlUI_ContextUpdate);
+		BoundContext->Update();
+	}
 
 	// One-shot settle after the first real Tick — only if warmup was configured.
 	// If WarmContext() ran pre-widget at estimated dimensions, the actual allotted
@@ -232,20 +252,49 @@ int32 SRmlWidget::OnPaint(
 	}
 #endif
 
+	// Cached mode renders into a persistent texture and only redraws what changed.
+	// It relies on retained rendering to know which documents changed.
+	const URmlUiSettings* Settings = URmlUiSettings::Get();
+	if (Settings->bCacheWidgetLayer && Settings->bRetainDocumentRendering)
+	{
+		if (!CachedLayer.IsValid())
+			CachedLayer = MakeShared<FRmlCachedLayer, ESPMode::ThreadSafe>();
+	}
+	else
+	{
+		CachedLayer.Reset();
+	}
+
 	// Scale + translate: context space -> physical screen space (for scissor/clip rects).
 	FSlateRenderTransform PhysicalTransform(ActiveUiScale, FVector2f(TX, TY));
 	RenderInterface->BeginRender(
 		BoundContext,
 		PhysicalTransform,
 		RenderMatrix,
-		MyCullingRect);
+		MyCullingRect,
+		CachedLayer);
 
-	{ SCOPE_CYCLE_COUNTER(STAT_RmlUI_ContextRender); BoundContext->Render(); }
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RmlUI_ContextRender);
+		// Retained mode: the render interface replays unchanged documents instead of
+		// letting RmlUi walk their element trees.
+		Rml::RenderDocumentHandler* DocumentHandler = Settings->bRetainDocumentRendering ? RenderInterface : nullptr;
+		// The render manager is shared with the warmer, which wants synchronous generation, so set it every frame.
+		BoundContext->GetRenderManager().SetCallbackTextureBudget(
+			Settings->bBudgetGeneratedTextures ? Settings->GeneratedTextureBudgetMs / 1000.0 : -1.0);
+		BoundContext->Render(DocumentHandler);
+	}
 
 	RenderInterface->EndRender(OutDrawElements, LayerId);
 	return LayerId + 1;
 }
 
+void SRmlWidget::InvalidateCachedLayer()
+{
+	if (CachedLayer.IsValid())
+		CachedLayer->bInvalidated = true;
+}
+
 FReply SRmlWidget::OnKeyDown(const FGeometry& MyGeometry, const FKeyEvent& InKeyEvent)
 {
 	if (!bEnableRml || !BoundContext) return FReply::Unhandled();
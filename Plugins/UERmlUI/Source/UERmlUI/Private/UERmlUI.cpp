@@ -4,11 +4,15 @@
 #include "Misc/Paths.h"
 #include "Misc/CoreDelegates.h"
 #include "HAL/PlatformFileManager.h"
+#include "Misc/ScopeLock.h"
 #include "Engine/Engine.h"
 #include "RmlInterface/UERmlFileInterface.h"
 #include "RmlInterface/UERmlSystemInterface.h"
 #include "RmlInterface/UERmlRenderInterface.h"
 #include "Logging.h"
+#include "RmlTextureCache.h"
+#include "RmlWarmer.h"
+#include "RmlContextScheduler.h"
 #include "RmlDocument.h"
 #include "RmlUiWidget.h"
 #include "RmlUi/Core.h"
@@ -21,6 +25,10 @@
 
 // Family-level font fallback: if the requested font-family is not loaded,
 // fall back to FallbackFamily instead of returning null (which renders nothing).
+//
+// Every entry point takes FontLock: RmlUi's default font engine caches glyphs, kerning
+// and effect layers lazily, and contexts updated on task-graph workers
+// (URmlUiSettings::bParallelContextUpdate) measure text at the same time.
 class FUERmlFontEngineInterface : public Rml::FontEngineInterfaceDefault
 {
 public:
@@ -28,15 +36,30 @@ public:
 	void SetFallbackFamily(Rml::String InFamily)
 	{
 		std::transform(InFamily.begin(), InFamily.end(), InFamily.begin(), [](unsigned char c){ return std::tolower(c); });
+		FScopeLock ScopeLock(&FontLock);
 		FallbackFamily = std::move(InFamily);
 	}
 
+	bool LoadFontFace(const Rml::String& file_name, int face_index, bool fallback_face, Rml::Style::FontWeight weight) override
+	{
+		FScopeLock ScopeLock(&FontLock);
+		return FontEngineInterfaceDefault::LoadFontFace(file_name, face_index, fallback_face, weight);
+	}
+
+	bool LoadFontFace(Rml::Span<const Rml::byte> data, int face_index, const Rml::String& font_family, Rml::Style::FontStyle style,
+		Rml::Style::FontWeight weight, bool fallback_face) override
+	{
+		FScopeLock ScopeLock(&FontLock);
+		return FontEngineInterfaceDefault::LoadFontFace(data, face_index, font_family, style, weight, fallback_face);
+	}
+
 	Rml::FontFaceHandle GetFontFaceHandle(
 		const Rml::String& family,
 		Rml::Style::FontStyle style,
 		Rml::Style::FontWeight weight,
 		int size) override
 	{
+		FScopeLock ScopeLock(&FontLock);
 		Rml::FontFaceHandle Handle = FontEngineInterfaceDefault::GetFontFaceHandle(family, style, weight, size);
 		if (Handle == 0 && !FallbackFamily.empty() && family != FallbackFamily)
 		{
@@ -47,12 +70,104 @@ public:
 			}
 			Handle = FontEngineInterfaceDefault::GetFontFaceHandle(FallbackFamily, style, weight, size);
 		}
+#if !UE_BUILD_SHIPPING
+		// Remember the requested configuration, not the fallback: warmup goes through
+		// this same function and falls back the same way.
+		if (Handle && FRmlWarmer::IsCaptureEnabled() && !CapturedFaces.Contains(Handle))
+		{
+			FRmlWarmupFontConfig& Config = CapturedFaces.Add(Handle);
+			Config.Family = UTF8_TO_TCHAR(family.c_str());
+			Config.bItalic = (style == Rml::Style::FontStyle::Italic);
+			Config.Weight = (int32)weight;
+			Config.Size = size;
+		}
+#endif
 		return Handle;
 	}
 
+	Rml::FontEffectsHandle PrepareFontEffects(Rml::FontFaceHandle handle, const Rml::FontEffectList& font_effects) override
+	{
+		FScopeLock ScopeLock(&FontLock);
+		const Rml::FontEffectsHandle EffectsHandle = FontEngineInterfaceDefault::PrepareFontEffects(handle, font_effects);
+#if !UE_BUILD_SHIPPING
+		if (FRmlWarmer::IsCaptureEnabled() && !font_effects.empty())
+		{
+			// Effects handles are only unique per face.
+			FString& Declaration = CapturedEffects.FindOrAdd({ handle, EffectsHandle });
+			if (Declaration.IsEmpty())
+			{
+				for (const Rml::SharedPtr<const Rml::FontEffect>& Effect : font_effects)
+				{
+					if (!Declaration.IsEmpty())
+						Declaration += TEXT(", ");
+					Declaration += UTF8_TO_TCHAR(Effect->GetDeclaration().c_str());
+				}
+			}
+		}
+#endif
+		return EffectsHandle;
+	}
+
+	const Rml::FontMetrics& GetFontMetrics(Rml::FontFaceHandle handle) override
+	{
+		FScopeLock ScopeLock(&FontLock);
+		return FontEngineInterfaceDefault::GetFontMetrics(handle);
+	}
+
+	int GetStringWidth(Rml::FontFaceHandle handle, Rml::StringView string, const Rml::TextShapingContext& text_shaping_context,
+		Rml::Character prior_character) override
+	{
+		FScopeLock ScopeLock(&FontLock);
+		return FontEngineInterfaceDefault::GetStringWidth(handle, string, text_shaping_context, prior_character);
+	}
+
+	int GenerateString(Rml::RenderManager& render_manager, Rml::FontFaceHandle face_handle, Rml::FontEffectsHandle effects_handle,
+		Rml::StringView string, Rml::Vector2f position, Rml::ColourbPremultiplied colour, float opacity,
+		const Rml::TextShapingContext& text_shaping_context, Rml::TexturedMeshList& mesh_list) override
+	{
+		FScopeLock ScopeLock(&FontLock);
+#if !UE_BUILD_SHIPPING
+		if (FRmlWarmer::IsCaptureEnabled())
+		{
+			if (const FRmlWarmupFontConfig* FaceConfig = CapturedFaces.Find(face_handle))
+			{
+				FRmlWarmupFontConfig Config = *FaceConfig;
+				if (const FString* Declaration = CapturedEffects.Find({ face_handle, effects_handle }))
+					Config.FontEffects = *Declaration;
+				FRmlWarmer::CaptureFontString(Config, string.begin(), (int32)string.size());
+			}
+		}
+#endif
+		return FontEngineInterfaceDefault::GenerateString(render_manager, face_handle, effects_handle, string, position, colour, opacity,
+			text_shaping_context, mesh_list);
+	}
+
+	int GetVersion(Rml::FontFaceHandle handle) override
+	{
+		FScopeLock ScopeLock(&FontLock);
+		return FontEngineInterfaceDefault::GetVersion(handle);
+	}
+
+	void ReleaseFontResources() override
+	{
+		FScopeLock ScopeLock(&FontLock);
+#if !UE_BUILD_SHIPPING
+		// Handles may be reused after this.
+		CapturedFaces.Reset();
+		CapturedEffects.Reset();
+#endif
+		FontEngineInterfaceDefault::ReleaseFontResources();
+	}
+
 private:
+	FCriticalSection FontLock;
 	Rml::String FallbackFamily;
 	std::set<Rml::String> WarnedFamilies;
+#if !UE_BUILD_SHIPPING
+	// Capture mode (rmlui.CaptureWarmup): what each handle was created from.
+	TMap<Rml::FontFaceHandle, FRmlWarmupFontConfig> CapturedFaces;
+	TMap<TPair<Rml::FontFaceHandle, Rml::FontEffectsHandle>, FString> CapturedEffects;
+#endif
 };
 
 static FUERmlFontEngineInterface GFontEngineInterface;
@@ -75,6 +190,8 @@ public:
 		Rml::SetFileInterface(&GFileInterface);
 		Rml::SetSystemInterface(&GSystemInterface);
 		Rml::SetRenderInterface(&GRenderInterface);
+		FUERmlRenderResources::Get().Initialize();
+		FUERmlRenderResources::Get().RegisterDefaultRecorder(&GRenderInterface);
 
 		// Initialize RmlUi core
 		if (!Rml::Initialise())
@@ -120,6 +237,8 @@ public:
 			GEngine->RemoveEngineStat(TEXT("STAT_RmlUI"));
 		}
 #endif
+		FRmlContextScheduler::Get().Shutdown();
+		FRmlTextureCache::Get().Flush();
 		GRmlInitialized = false;
 	}
 
@@ -189,6 +308,107 @@ static FAutoConsoleCommand GRmlReloadStyleSheets(
 			TotalDocs, NumContexts);
 	}));
 
+static FAutoConsoleCommand GRmlRetainedStats(
+	TEXT("rmlui.RetainedStats"),
+	TEXT("Log retained-mode render hits/misses for every document currently being rendered."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		TArray<FUERmlRenderInterface*> Recorders;
+		FUERmlRenderResources::Get().GetRecorders(Recorders);
+		int32 NumDocs = 0;
+		for (FUERmlRenderInterface* Recorder : Recorders)
+		{
+			TArray<FRmlRetainedDocumentStats> Stats;
+			Recorder->GetRetainedDocumentStats(Stats);
+			for (const FRmlRetainedDocumentStats& Doc : Stats)
+			{
+				const int32 Total = Doc.Hits + Doc.Misses;
+				UE_LOG(LogUERmlUI, Log, TEXT("rmlui.RetainedStats: %s  hits=%d misses=%d (%.1f%% hit)  calls=%d"),
+					*Doc.SourceURL, Doc.Hits, Doc.Misses, Total > 0 ? 100.0 * Doc.Hits / Total : 0.0, Doc.NumCalls);
+			}
+			NumDocs += Stats.Num();
+		}
+		UE_LOG(LogUERmlUI, Log, TEXT("rmlui.RetainedStats: %d document(s) in %d recorder(s)"), NumDocs, Recorders.Num());
+	}));
+
+static FAutoConsoleCommand GRmlBenchConvolution(
+	TEXT("rmlui.BenchConvolution"),
+	TEXT("Time the CPU convolution filter behind font blur/glow/outline effects against its\n")
+	TEXT("per-pixel reference implementation at common radii, and check both agree."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		// Synthetic A8 glyph: a filled disc with an anti-aliased edge.
+		const Rml::Vector2i GlyphSize(64, 64);
+		TArray<Rml::byte> Glyph;
+		Glyph.SetNumUninitialized(GlyphSize.x * GlyphSize.y);
+		for (int32 Y = 0; Y < GlyphSize.y; ++Y)
+		{
+			for (int32 X = 0; X < GlyphSize.x; ++X)
+			{
+				const float Distance = FVector2f(X - 31.5f, Y - 31.5f).Size();
+				Glyph[Y * GlyphSize.x + X] = (Rml::byte)FMath::Clamp((28.f - Distance) * 255.f, 0.f, 255.f);
+			}
+		}
+
+		constexpr int32 Iterations = 50;
+		auto Bench = [&](const TCHAR* Name, int32 Radius, const Rml::ConvolutionFilter& Filter, Rml::Vector2i Radii)
+		{
+			const Rml::Vector2i OutSize = GlyphSize + Radii * 2;
+			TArray<Rml::byte> RefOut, NewOut;
+			RefOut.SetNumZeroed(OutSize.x * OutSize.y * 4);
+			NewOut.SetNumZeroed(OutSize.x * OutSize.y * 4);
+
+			double Start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Iterations; ++i)
+				Filter.RunReference(RefOut.GetData(), OutSize, OutSize.x * 4, Rml::ColorFormat::RGBA8, Glyph.GetData(), GlyphSize, Radii, Rml::ColorFormat::A8);
+			const double RefMs = (FPlatformTime::Seconds() - Start) * 1000.0 / Iterations;
+
+			Start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Iterations; ++i)
+				Filter.Run(NewOut.GetData(), OutSize, OutSize.x * 4, Rml::ColorFormat::RGBA8, Glyph.GetData(), GlyphSize, Radii, Rml::ColorFormat::A8);
+			const double NewMs = (FPlatformTime::Seconds() - Start) * 1000.0 / Iterations;
+
+			int32 MaxDiff = 0;
+			for (int32 i = 0; i < RefOut.Num(); ++i)
+				MaxDiff = FMath::Max(MaxDiff, FMath::Abs((int32)RefOut[i] - (int32)NewOut[i]));
+
+			UE_LOG(LogUERmlUI, Log, TEXT("rmlui.BenchConvolution: %-8s r=%-2d  reference %.3f ms  new %.3f ms  (%.1fx)  max diff %d"),
+				Name, Radius, RefMs, NewMs, NewMs > 0.0 ? RefMs / NewMs : 0.0, MaxDiff);
+		};
+
+		for (int32 Radius : {2, 4, 8, 16})
+		{
+			// Full 2D gaussian, which Run() factors into two 1D passes.
+			Rml::ConvolutionFilter Blur;
+			Blur.Initialise(Radius, Rml::FilterOperation::Sum);
+			const float TwoVariance = 2.f * FMath::Square(0.4f * Radius);
+			float Sum = 0.f;
+			for (int32 Y = -Radius; Y <= Radius; ++Y)
+				for (int32 X = -Radius; X <= Radius; ++X)
+					Sum += FMath::Exp(-(X * X + Y * Y) / TwoVariance);
+			for (int32 Y = -Radius; Y <= Radius; ++Y)
+				for (int32 X = -Radius; X <= Radius; ++X)
+					Blur[Y + Radius][X + Radius] = FMath::Exp(-(X * X + Y * Y) / TwoVariance) / Sum;
+			Bench(TEXT("blur"), Radius, Blur, Rml::Vector2i(Radius));
+		}
+
+		for (int32 Radius : {1, 2, 4, 8})
+		{
+			// Same disc kernel as FontEffectOutline.
+			Rml::ConvolutionFilter Outline;
+			Outline.Initialise(Radius, Rml::FilterOperation::Dilation);
+			for (int32 Y = -Radius; Y <= Radius; ++Y)
+			{
+				for (int32 X = -Radius; X <= Radius; ++X)
+				{
+					const float Distance = FMath::Sqrt(float(X * X + Y * Y));
+					Outline[Y + Radius][X + Radius] = Distance > Radius ? FMath::Max((Radius + 1) - Distance, 0.f) : 1.f;
+				}
+			}
+			Bench(TEXT("outline"), Radius, Outline, Rml::Vector2i(Radius));
+		}
+	}));
+
 static FAutoConsoleCommand GRmlReloadDocuments(
 	TEXT("rmlui.ReloadDocuments"),
 	TEXT("Fully reload all RmlUI documents from disk (hot-reload RML structure + RCSS).\n")
@@ -218,4 +438,127 @@ static FAutoConsoleCommand GRmlReloadDocuments(
 
 		UE_LOG(LogUERmlUI, Log, TEXT("rmlui.ReloadDocuments: reloaded %d document(s)"), Count);
 	}));
+
+static FAutoConsoleCommand GRmlBenchParallelUpdate(
+	TEXT("rmlui.BenchParallelUpdate"),
+	TEXT("Stress test for FRmlContextScheduler: update 1..N independent contexts serially and on\n")
+	TEXT("task-graph workers, with a full restyle and relayout every frame, and log wall time and scaling.\n")
+	TEXT("Args: [NumContexts=6] [Frames=60] [DocumentPath] (default: a synthetic grid of text cards)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (!GRmlInitialized)
+		{
+			UE_LOG(LogUERmlUI, Warning, TEXT("rmlui.BenchParallelUpdate: RmlUI not initialized"));
+			return;
+		}
+		const int32 MaxContexts = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 64) : 6;
+		const int32 Frames      = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 60;
+		const FString DocumentPath = Args.Num() > 2 ? Args[2] : FString();
+
+		// Enough wrapped text that style resolution, layout and text measuring dominate.
+		Rml::String Source =
+			"<rml><head><style>"
+			"body { width: 100%; height: 100%; font-family: Roboto; font-size: 14px; display: flex; flex-wrap: wrap; }"
+			"body.bench-alt { font-size: 15px; }"
+			"div.card { width: 180px; margin: 4px; padding: 6px; border: 1px #888; }"
+			"div.card span { font-weight: bold; }"
+			"</style></head><body>";
+		for (int32 i = 0; i < 400; ++i)
+		{
+			Source += "<div class=\"card\"><span>Item " + Rml::ToString(i) + "</span> "
+				"a longer description that wraps over a few lines of the card</div>";
+		}
+		Source += "</body></rml>";
+
+		// Each context gets its own recorder, as URmlUiWidget does with bIsolateContextRendering.
+		struct FBenchContext
+		{
+			FString					Name;
+			Rml::Context*			Context = nullptr;
+			Rml::ElementDocument*	Document = nullptr;
+			FUERmlRenderInterface*	Recorder = nullptr;
+		};
+		TArray<FBenchContext> Contexts;
+		for (int32 i = 0; i < MaxContexts; ++i)
+		{
+			FBenchContext& Bench = Contexts.AddDefaulted_GetRef();
+			Bench.Name = FString::Printf(TEXT("__bench_parallel_%d"), i);
+			Bench.Recorder = FUERmlRenderResources::Get().AcquireRecorder();
+			Bench.Context = Rml::CreateContext(TCHAR_TO_UTF8(*Bench.Name), Rml::Vector2i(1920, 1080), Bench.Recorder);
+			if (!Bench.Context)
+			{
+				UE_LOG(LogUERmlUI, Warning, TEXT("rmlui.BenchParallelUpdate: failed to create context %s"), *Bench.Name);
+				break;
+			}
+			Bench.Document = DocumentPath.IsEmpty()
+				? Bench.Context->LoadDocumentFromMemory(Source)
+				: Bench.Context->LoadDocument(TCHAR_TO_UTF8(*DocumentPath));
+			if (Bench.Document)
+				Bench.Document->Show();
+			Bench.Context->Update();
+		}
+
+		TArray<Rml::Context*> ContextPtrs;
+		for (const FBenchContext& Bench : Contexts)
+		{
+			if (Bench.Context)
+				ContextPtrs.Add(Bench.Context);
+		}
+
+		// Flip the width and a class on the body every frame: every context restyles and relays out.
+		auto Dirty = [&Contexts](int32 Frame, int32 Count)
+		{
+			for (int32 i = 0; i < Count; ++i)
+			{
+				Contexts[i].Context->SetDimensions(Rml::Vector2i((Frame & 1) ? 1919 : 1920, 1080));
+				if (Contexts[i].Document)
+					Contexts[i].Document->SetClass("bench-alt", (Frame & 1) != 0);
+			}
+		};
+
+		UE_LOG(LogUERmlUI, Log, TEXT("rmlui.BenchParallelUpdate: %d frames, %d task-graph workers"),
+			Frames, FTaskGraphInterface::Get().GetNumWorkerThreads());
+
+		// 1, 2, 4, ... and the full count.
+		TArray<int32> Counts;
+		for (int32 Count = 1; Count < ContextPtrs.Num(); Count *= 2)
+			Counts.Add(Count);
+		if (ContextPtrs.Num() > 0)
+			Counts.Add(ContextPtrs.Num());
+
+		double SingleMs = 0.0;
+		for (int32 Count : Counts)
+		{
+			double Start = FPlatformTime::Seconds();
+			for (int32 Frame = 0; Frame < Frames; ++Frame)
+			{
+				Dirty(Frame, Count);
+				for (int32 i = 0; i < Count; ++i)
+					ContextPtrs[i]->Update();
+			}
+			const double SerialMs = (FPlatformTime::Seconds() - Start) * 1000.0 / Frames;
+
+			Start = FPlatformTime::Seconds();
+			for (int32 Frame = 0; Frame < Frames; ++Frame)
+			{
+				Dirty(Frame, Count);
+				FRmlContextScheduler::UpdateContexts(MakeArrayView(ContextPtrs.GetData(), Count));
+			}
+			const double ParallelMs = (FPlatformTime::Seconds() - Start) * 1000.0 / Frames;
+
+			if (Count == 1)
+				SingleMs = SerialMs;
+			// Ideal parallel time is one context's update, whatever the count.
+			UE_LOG(LogUERmlUI, Log, TEXT("rmlui.BenchParallelUpdate: %2d contexts  serial %7.2f ms  parallel %7.2f ms  speedup %.2fx  efficiency %3.0f%%"),
+				Count, SerialMs, ParallelMs, ParallelMs > 0.0 ? SerialMs / ParallelMs : 0.0,
+				ParallelMs > 0.0 ? 100.0 * SingleMs / ParallelMs : 0.0);
+		}
+
+		for (FBenchContext& Bench : Contexts)
+		{
+			if (Bench.Context)
+				Rml::RemoveContext(TCHAR_TO_UTF8(*Bench.Name));
+			FUERmlRenderResources::Get().ReleaseRecorder(Bench.Recorder);
+		}
+	}));
 #endif
\ No newline at end of file
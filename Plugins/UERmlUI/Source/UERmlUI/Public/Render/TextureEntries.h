@@ -27,6 +27,15 @@ public:
 	bool					bIsSavedLayer  = false;	// true for callback/cached textures (box-shadow, drop-shadow)
 	bool					bWrapSampler   = false;	// true for file-loaded textures (repeat decorators need AM_Wrap)
 	bool					bBoundTextureIsSRGB = false;
+	bool					bDynamicContent = false;	// bound through SetTexture to a texture the engine redraws itself (render target, media)
+
+	// Set for generated textures packed into an atlas page (FRmlTextureAtlas). The page
+	// entry is the one bound for drawing; UVs are remapped as UV * xy + zw.
+	TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>	AtlasPage;
+	FVector4f				AtlasUVRect = FVector4f(1.0f, 1.0f, 0.0f, 0.0f);
+	FIntRect				AtlasRect;		// padded region inside the page
+
+	FRmlTextureEntry* GetPageEntry() { return AtlasPage.IsValid() ? AtlasPage.Get() : this; }
 
 	// Direct RHI texture — set by render thread for SaveLayerAsTexture.
 	// When valid, bypasses the BoundTexture→GetResource() path.
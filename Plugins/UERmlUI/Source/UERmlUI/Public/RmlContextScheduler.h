@@ -0,0 +1,47 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace Rml { class Context; }
+
+// Updates independent RmlUi contexts on task-graph workers (URmlUiSettings::bParallelContextUpdate).
+//
+// Widget contexts with their own recorder (URmlUiSettings::bIsolateContextRendering) are
+// registered here. At the start of every Slate tick, the contexts whose widget ticked on
+// the previous frame run Context::Update (data models, styles, layout) in one ParallelFor,
+// and SRmlWidget::Tick then skips its own update. Rendering stays in SRmlWidget::OnPaint:
+// Slate paints widgets one at a time into a draw element list that is not thread-safe.
+//
+// Contexts on the module's default recorder share one RmlUi render manager and are never
+// batched. Event listeners and data-model callbacks of a batched context run on a worker,
+// so contexts with game-thread-only listeners (URmlDocument) opt out with Unregister.
+class UERMLUI_API FRmlContextScheduler
+{
+public:
+	static FRmlContextScheduler& Get();
+
+	void Register(Rml::Context* Context);
+	void Unregister(Rml::Context* Context);
+
+	// Called by SRmlWidget::Tick in place of Context::Update. Returns true if the context
+	// was already updated by this frame's batch; false if the caller must update it.
+	bool ConsumeBatchedUpdate(Rml::Context* Context);
+
+	// Run Context::Update on every context at once and wait for all of them. Game thread.
+	static void UpdateContexts(TArrayView<Rml::Context* const> Contexts);
+
+	// Unhook from Slate, on module shutdown.
+	void Shutdown();
+
+private:
+	struct FEntry
+	{
+		uint64	LastTickFrame = 0;		// last frame the widget asked for an update
+		uint64	LastBatchFrame = 0;		// last frame the batch updated the context
+	};
+
+	void OnSlatePreTick(float DeltaTime);
+
+	TMap<Rml::Context*, FEntry>	Entries;
+	FDelegateHandle				PreTickHandle;
+};
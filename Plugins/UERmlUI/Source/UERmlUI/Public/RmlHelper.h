@@ -3,6 +3,7 @@
 #include "RmlUi/Core/Input.h"
 
 class UTexture2D;
+class IImageWrapperModule;
 
 class UERMLUI_API FRmlHelper
 {
@@ -14,6 +15,21 @@ public:
 	static UTexture2D* LoadTextureFromFile(const FString& InFilePath);
 	static UTexture2D* LoadTextureFromAsset(const FString& InAssetPath, UObject* InOuter = GetTransientPackage());
 
+	/**
+	 * Read and decode an image file to RGBA8. Safe to call off the game thread as long
+	 * as the ImageWrapper module was loaded beforehand (pass it in).
+	 */
+	static bool DecodeImageFile(IImageWrapperModule& InImageWrapperModule, const FString& InFilePath, TArray64<uint8>& OutPixels, FIntPoint& OutSize);
+
+	/** Create a transient UTexture2D and upload RGBA8 pixels to it, taking ownership of the buffer. */
+	static UTexture2D* CreateTextureFromPixels(TArray64<uint8>&& InPixels, FIntPoint InSize);
+
+	/**
+	 * Read the image dimensions from the file header without decoding it.
+	 * Supports PNG, JPEG and BMP; returns false for anything else.
+	 */
+	static bool ProbeImageSize(const FString& InFilePath, FIntPoint& OutSize);
+
 	/**
 	 * Pre-warm font effect caches by rendering a hidden RML document once.
 	 * Font face layers (glow, shadow, outline) are generated lazily on first use,
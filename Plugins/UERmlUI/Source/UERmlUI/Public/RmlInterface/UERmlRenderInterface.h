@@ -1,51 +1,76 @@
 #pragma once
 #include "RmlUi/Core/RenderInterface.h"
-#include "Render/TextureEntries.h"
+#include "RmlUi/Core/Context.h"
+#include "RmlInterface/UERmlRenderResources.h"
 
 namespace Rml { class Context; class ElementDocument; }
-class FRmlMesh;
 class FRmlDrawer;
-struct FCompiledRmlFilter;
-struct FCompiledRmlShader;
+struct FRmlCachedLayer;
 
-class UERMLUI_API FUERmlRenderInterface : public Rml::RenderInterface
+// Per-document counters for retained-mode rendering, see FUERmlRenderInterface::GetRetainedDocumentStats.
+struct FRmlRetainedDocumentStats
+{
+	FString		SourceURL;
+	int32		Hits = 0;		// frames the recorded calls were replayed
+	int32		Misses = 0;		// frames the document was walked and re-recorded
+	int32		NumCalls = 0;	// size of the current recording
+};
+
+// Records the render calls of the contexts it is bound to into a drawer of its own.
+// Meshes, textures, filters and shaders live in the shared FUERmlRenderResources and
+// every resource call is forwarded there; this class only holds per-recording state
+// (drawer, transform, scissor, layers) and the retained-mode recordings.
+//
+// The module's default instance serves every context created without a render
+// interface. With URmlUiSettings::bIsolateContextRendering each widget context gets
+// its own from FUERmlRenderResources::AcquireRecorder, so contexts can record on
+// different threads without sharing any mutable state but the resource tables.
+class UERMLUI_API FUERmlRenderInterface : public Rml::RenderInterface, public Rml::RenderDocumentHandler
 {
 public:
 	FUERmlRenderInterface();
 
-	bool SetTexture(FString Path, UTexture* InTexture, bool bAddIfNotExist = true);
-	TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe> GetTexture() { return AllTextures.begin().Value(); }
-	const TArray<TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>>& GetCreatedTextures() const { return AllCreatedTextures; }
+	bool SetTexture(FString Path, UTexture* InTexture, bool bAddIfNotExist = true) { return SharedResources.SetTexture(MoveTemp(Path), InTexture, bAddIfNotExist); }
+	TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe> GetTexture() { return SharedResources.GetTexture(); }
+	const TArray<TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>>& GetCreatedTextures() const { return SharedResources.GetCreatedTextures(); }
 
 	void BeginRender(
 		    Rml::Context*				InContext,
 		    const FSlateRenderTransform&	InRmlWidgetRenderTransform,
 		    const FMatrix44f&			InRmlRenderMatrix,
-		    const FSlateRect&			InViewportRect)
+		    const FSlateRect&			InViewportRect,
+		    const TSharedPtr<FRmlCachedLayer, ESPMode::ThreadSafe>& InCachedLayer = nullptr)
 	{
-		// Flush deferred filter releases — the previous frame's render thread
-		// has finished with these handles by now.
-		for (Rml::CompiledFilterHandle H : PendingFilterReleases)
-			CompiledFilters.Remove(H);
-		PendingFilterReleases.Reset();
+		SharedResources.BeginFrame();
 
 		CurrentContext           = InContext;
 		RmlWidgetRenderTransform = InRmlWidgetRenderTransform;
 		RmlRenderMatrix          = InRmlRenderMatrix;
 		ViewportRect             = InViewportRect;
-		CurrentDrawer            = _AllocDrawer();
+		CurrentDrawer            = SharedResources.AllocDrawer();
+		CurrentCachedLayer       = InCachedLayer;
+		FrameDocuments.Reset();
 		LayerCounter             = 0;
+		TransformState           = INDEX_NONE;
+		ScissorState             = INDEX_NONE;
 	}
 	void EndRender(FSlateWindowElementList& InCurrentElementList, uint32 InCurrentLayer);
 
+	uint32 GetContentSerial() const { return SharedResources.GetContentSerial(); }
+
 	// Warmup cycle tracking — call ResetWarmupCounter() before each Render(),
 	// then GetWarmupTextureCount() after to check if new textures were generated.
 	void ResetWarmupCounter() { WarmupTextureCount = 0; }
 	int32 GetWarmupTextureCount() const { return WarmupTextureCount; }
 
-	// Pre-allocate spare UTexture2D objects matching the count per dimension
-	// observed in AllCreatedTextures. Call after warmup completes.
-	void PreallocateTextureReserves();
+	// See FUERmlRenderResources::PreallocateTextureReserves.
+	void PreallocateTextureReserves() { SharedResources.PreallocateTextureReserves(); }
+
+	// Hit/miss counters of every document currently tracked by retained-mode rendering.
+	void GetRetainedDocumentStats(TArray<FRmlRetainedDocumentStats>& OutStats) const;
+
+	// Forget everything recorded for the previous context, before the recorder is reused.
+	void ResetRecorder();
 
 protected:
 	// ~Begin Rml::RenderInterface API (6.2)
@@ -91,11 +116,16 @@ protected:
 
 	// ~End Rml::RenderInterface API
 
-	TSharedPtr<FRmlDrawer, ESPMode::ThreadSafe> _AllocDrawer();
+	// ~Begin Rml::RenderDocumentHandler API
+	virtual bool OnRenderDocumentBegin(Rml::ElementDocument* document) override;
+	virtual void OnRenderDocumentEnd(Rml::ElementDocument* document) override;
+	// ~End Rml::RenderDocumentHandler API
 
 	// Helpers
-	FMatrix44f ComputeNDCMatrix(Rml::Vector2f translation) const;
+	FMatrix44f ComputeBaseMatrix() const;
 	FIntRect ComputeScissorRect() const;
+	int32 GetTransformState();
+	int32 GetScissorState();
 
 	// render state
 	Rml::Context*								CurrentContext = nullptr;
@@ -103,6 +133,8 @@ protected:
 	FMatrix44f									RmlRenderMatrix;
 	FSlateRect									ViewportRect;
 	TSharedPtr<FRmlDrawer, ESPMode::ThreadSafe>	CurrentDrawer;
+	TSharedPtr<FRmlCachedLayer, ESPMode::ThreadSafe>	CurrentCachedLayer;
+	FUERmlRenderResources&						SharedResources;
 
 #if !UE_BUILD_SHIPPING
 	// Capture mode: document URLs recorded when live textures are generated.
@@ -118,40 +150,86 @@ protected:
 	bool										bUseClipRect;
 	FSlateRect									ClipRect;
 
-	// layer counter (game-thread side)
+	// Current transform / scissor interned into CurrentDrawer's per-frame tables.
+	// INDEX_NONE = changed since the last draw; re-interned lazily on the next one.
+	int32										TransformState = INDEX_NONE;
+	int32										ScissorState = INDEX_NONE;
+
+	// layer counter (recording side)
 	int32										LayerCounter = 0;
 
 	// warmup texture counter (encapsulated — use ResetWarmupCounter / GetWarmupTextureCount)
 	int32										WarmupTextureCount = 0;
 
-	// textures
-	TMap<FString, TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>>	AllTextures;
-	TArray<TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>>			AllCreatedTextures;
-
-	// meshes — keyed by raw pointer for O(1) ReleaseGeometry lookup
-	// (linear TArray search was O(N²) when benchmark destroys 1000+ meshes/frame)
-	TMap<FRmlMesh*, TSharedPtr<FRmlMesh, ESPMode::ThreadSafe>>			Meshes;
-
-	// drawers
-	TArray<TSharedPtr<FRmlDrawer, ESPMode::ThreadSafe>>					AllDrawers;
-
-	// compiled filters (owned by this interface, shared with drawers)
-	TMap<Rml::CompiledFilterHandle, TSharedPtr<FCompiledRmlFilter>>		CompiledFilters;
-	Rml::CompiledFilterHandle											NextFilterHandle = 1;
-
-	// Deferred filter releases — flushed in BeginRender after the render thread
-	// has processed all commands referencing these handles.
-	TArray<Rml::CompiledFilterHandle>									PendingFilterReleases;
-
-	// compiled shaders
-	TMap<Rml::CompiledShaderHandle, TSharedPtr<FCompiledRmlShader>>		CompiledShaders;
-	Rml::CompiledShaderHandle											NextShaderHandle = 1;
-
-	// Dimension-based texture pool. When RmlUI releases a generated texture, the
-	// FRmlTextureEntry (and its UTexture2D) is pooled here instead of destroyed.
-	// On the next GenerateTexture with matching dimensions, the pooled UTexture2D is
-	// reused with just UpdateTextureRegions (memcpy), skipping the expensive
-	// UTexture2D::CreateTransient + UpdateResource path.
-	// Key: (Width << 32) | Height
-	TMap<uint64, TArray<TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>>>	TextureDimensionPool;
+	// Retained-mode rendering. When SRmlWidget passes this interface to Context::Render,
+	// the render calls of each document are recorded in context space. On later frames a
+	// document that RmlUi did not mark render-dirty replays its calls through the entry
+	// points above instead of walking its element tree. Transform and scissor are resolved
+	// on replay, so the recording stays valid when only the widget transform changes.
+	enum class ERetainedCall : uint8
+	{
+		RenderGeometry,
+		RenderShader,
+		EnableScissor,
+		SetScissor,
+		SetTransform,
+		EnableClipMask,
+		RenderToClipMask,
+		PushLayer,
+		CompositeLayers,
+		PopLayer,
+	};
+	struct FRetainedCall
+	{
+		ERetainedCall		Type;
+		uint8				Arg = 0;			// enable flag, clip mask operation or blend mode
+		int32				Slot = INDEX_NONE;	// SetTransform: Transforms index (INDEX_NONE = none), CompositeLayers: first Filters index
+		int32				NumFilters = 0;
+		uintptr_t			Geometry = 0;		// CompositeLayers: source layer
+		uintptr_t			Texture = 0;		// CompositeLayers: destination layer
+		uintptr_t			Shader = 0;
+		Rml::Vector2f		Translation;
+		Rml::Rectanglei		Region;
+	};
+	struct FRetainedDocument
+	{
+		TArray<FRetainedCall>				Calls;
+		TArray<Rml::Matrix4f>				Transforms;
+		TArray<Rml::CompiledFilterHandle>	Filters;
+		// Every handle the calls reference. Releasing any of them drops the recording.
+		// Handle kinds share one set; a collision can only cause a spurious re-record.
+		TSet<uintptr_t>						Resources;
+		FRmlRetainedDocumentStats			Stats;
+		uint64								LastUsedFrame = 0;
+		bool								bValid = false;
+		// Context-space bounds of what the calls draw, for cached widget layers.
+		// Unbounded when a draw can't be bounded cheaply (custom transform, filters).
+		FSlateRect							Bounds;
+		bool								bHasBounds = false;
+		bool								bUnbounded = false;
+
+		void Invalidate();
+	};
+	TMap<Rml::ElementDocument*, FRetainedDocument>						RetainedDocuments;
+	FRetainedDocument*													RecordingDocument = nullptr;
+	// Documents rendered this frame, in order; bRecorded = walked rather than replayed.
+	// bDynamicTextures = drew a texture whose pixels change without a re-render.
+	struct FFrameDocument
+	{
+		Rml::ElementDocument*	Document;
+		bool					bRecorded;
+		bool					bDynamicTextures = false;
+	};
+	TArray<FFrameDocument>												FrameDocuments;
+	int32																CurrentFrameDocument = INDEX_NONE;
+	void NoteTextureDrawn(const FRmlTextureEntry* Texture);
+
+	FRetainedCall* RecordCall(ERetainedCall Type);
+	void RetainResource(uintptr_t Handle) { RecordingDocument->Resources.Add(Handle); }
+	void RetainBounds(Rml::CompiledGeometryHandle Geometry, Rml::Vector2f Translation);
+	// Diff this frame's documents against the cached layer and hand the dirty rect to the drawer.
+	void UpdateCachedLayer();
+	void InvalidateRetained(uintptr_t Handle);
+	void ReplayRetained(const FRetainedDocument& Retained);
+	void PruneRetainedDocuments();
 };
@@ -0,0 +1,218 @@
+#pragma once
+#include "RmlUi/Core/RenderInterface.h"
+#include "Render/TextureEntries.h"
+#include "Tasks/Task.h"
+#include "Misc/ScopeRWLock.h"
+#include <atomic>
+
+class FRmlMesh;
+class FRmlDrawer;
+class FRmlTextureAtlas;
+class FUERmlRenderInterface;
+class IImageWrapperModule;
+struct FCompiledRmlFilter;
+struct FCompiledRmlShader;
+
+// GPU-side resources shared by every RmlUi context: meshes, textures, compiled filters
+// and shaders, and the drawer pool. The per-context half lives in FUERmlRenderInterface,
+// which records draw calls into its own drawer and forwards every resource call here.
+//
+// Handles are unique across recorders, so a handle compiled through one context's
+// recorder resolves in any other. All entry points take the internal lock; recorders
+// on different threads only contend on resource creation and release, draws resolve
+// their handles under a shared read lock.
+//
+// File/asset loads and texture generation create UObjects. They take a GC guard when
+// called off the game thread; asset textures (LoadObject) must be loaded on the game
+// thread, or bound up front with SetTexture.
+class UERMLUI_API FUERmlRenderResources
+{
+public:
+	static FUERmlRenderResources& Get();
+
+	// Game thread, from module startup: resolves the engine modules worker tasks use.
+	void Initialize();
+
+	// Once-per-recording housekeeping, called from FUERmlRenderInterface::BeginRender:
+	// drops releases the render thread is done with and binds finished async loads.
+	void BeginFrame();
+	TSharedPtr<FRmlDrawer, ESPMode::ThreadSafe> AllocDrawer();
+
+	// Per-context recorders (URmlUiSettings::bIsolateContextRendering). RmlUi keeps a
+	// render manager per render interface until shutdown, so recorders are never freed:
+	// a released one is reset and handed to the next context that asks.
+	FUERmlRenderInterface* AcquireRecorder();
+	void ReleaseRecorder(FUERmlRenderInterface* Recorder);
+	// Default recorder plus every acquired one, for stats.
+	void GetRecorders(TArray<FUERmlRenderInterface*>& OutRecorders) const;
+	void RegisterDefaultRecorder(FUERmlRenderInterface* Recorder) { DefaultRecorder = Recorder; }
+
+	// geometry
+	Rml::CompiledGeometryHandle CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices);
+	void ReleaseGeometry(Rml::CompiledGeometryHandle geometry);
+
+	// textures — bLive: requested while recording a frame rather than by warmup
+	Rml::TextureHandle LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source);
+	Rml::TextureHandle GenerateTexture(Rml::Span<const Rml::byte> source, Rml::Vector2i source_dimensions, bool bLive);
+	Rml::TextureHandle AddSavedLayer(const TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>& Entry);
+	void ReleaseTexture(Rml::TextureHandle texture);
+	// Null for 0 and for stale handles (logged). The entry outlives every drawer that uses it.
+	FRmlTextureEntry* ResolveTexture(Rml::TextureHandle Handle);
+
+	// filters
+	Rml::CompiledFilterHandle CompileFilter(const Rml::String& name, const Rml::Dictionary& parameters);
+	Rml::CompiledFilterHandle AddFilter(const TSharedPtr<FCompiledRmlFilter>& Filter);
+	void ReleaseFilter(Rml::CompiledFilterHandle filter);
+	void ResolveFilters(Rml::Span<const Rml::CompiledFilterHandle> Handles, TArray<TSharedPtr<FCompiledRmlFilter>>& OutFilters);
+
+	// shaders
+	Rml::CompiledShaderHandle CompileShader(const Rml::String& name, const Rml::Dictionary& parameters);
+	void ReleaseShader(Rml::CompiledShaderHandle shader);
+	TSharedPtr<FCompiledRmlShader> ResolveShader(Rml::CompiledShaderHandle shader);
+
+	bool SetTexture(FString Path, UTexture* InTexture, bool bAddIfNotExist = true);
+	TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe> GetTexture() { return AllTextures.begin().Value(); }
+	// Game thread only — the array is not copied out under the lock.
+	const TArray<TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>>& GetCreatedTextures() const { return AllCreatedTextures; }
+
+	// Bumped whenever a texture's content changes without any document being re-rendered
+	// (async load finished, SetTexture rebinding), so cached widget layers redraw.
+	uint32 GetContentSerial() const { return ContentSerial; }
+
+	// Pre-allocate spare UTexture2D objects matching the count per dimension
+	// observed in AllCreatedTextures. Call after warmup completes.
+	void PreallocateTextureReserves();
+
+private:
+	FUERmlRenderResources();
+	~FUERmlRenderResources();
+
+	void FlushDeferredReleases();
+
+	// Guards every table below. Writers are resource creation/release and per-frame
+	// housekeeping; draws only take it shared to resolve texture handles.
+	mutable FRWLock														Lock;
+
+	// recorders
+	FUERmlRenderInterface*												DefaultRecorder = nullptr;
+	TArray<TUniquePtr<FUERmlRenderInterface>>							Recorders;
+	TArray<FUERmlRenderInterface*>										FreeRecorders;
+
+	std::atomic<uint32>													ContentSerial = 0;
+
+	// textures
+	TMap<FString, TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>>	AllTextures;
+	TArray<TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>>			AllCreatedTextures;
+	TArray<int32>														CreatedTextureSlots;	// parallel to AllCreatedTextures
+
+	// Texture handles handed to RmlUi are generational slot indices:
+	// (Generation << 32) | (Index + 1), so 0 stays the null handle. Resolving and
+	// releasing a handle is O(1), and a handle whose slot was released (and maybe
+	// reused since) fails the generation check instead of aliasing another texture.
+	enum class ETextureSlotKind : uint8
+	{
+		Free,
+		Loaded,			// file/asset texture, also cached in AllTextures under LoadedKey
+		Generated,		// GenerateTexture — pooled by dimension on release
+		SavedLayer,		// SaveLayerAsTexture — filled in on the render thread
+	};
+	struct FTextureSlot
+	{
+		TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>	Entry;
+		FString												LoadedKey;
+		int32												CreatedIndex = INDEX_NONE;	// index in AllCreatedTextures
+		uint32												Generation = 1;
+		ETextureSlotKind									Kind = ETextureSlotKind::Free;
+	};
+	TArray<FTextureSlot>												TextureSlots;
+	TArray<int32>														FreeTextureSlots;
+
+	Rml::TextureHandle AllocTextureHandle(const TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>& Entry, ETextureSlotKind Kind, const FString& LoadedKey = FString());
+	FTextureSlot* FindTextureSlot(Rml::TextureHandle Handle);
+
+	// meshes — keyed by raw pointer for O(1) ReleaseGeometry lookup
+	// (linear TArray search was O(N²) when benchmark destroys 1000+ meshes/frame)
+	TMap<FRmlMesh*, TSharedPtr<FRmlMesh, ESPMode::ThreadSafe>>			Meshes;
+
+	// drawers
+	TArray<TSharedPtr<FRmlDrawer, ESPMode::ThreadSafe>>					AllDrawers;
+
+	// Frame fence for meshes/textures referenced by recorded commands. Commands hold
+	// raw pointers, so resources released by RmlUi are parked here, tagged with the
+	// serial of the most recently handed-out drawer, and dropped in BeginFrame once
+	// no drawer with a serial <= that tag is still waiting for the render thread.
+	struct FDeferredRelease
+	{
+		uint64											Serial;
+		TSharedPtr<FRmlMesh, ESPMode::ThreadSafe>		Mesh;
+		TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>	Texture;
+	};
+	TArray<FDeferredRelease>											DeferredReleases;
+	uint64																DrawerSerial = 0;
+
+	// Slate doesn't execute every drawer it is handed (culled or removed widgets), and
+	// one that never runs would hold the fence forever. The game thread enqueues a render
+	// command once per frame that publishes the last game frame whose Slate draws the
+	// render thread has finished; a drawer handed out DrawerRetireFrames before that and
+	// still not free was dropped, and is reset and returned to the pool.
+	static constexpr uint64												DrawerRetireFrames = 3;
+	std::atomic<uint64>													RenderThreadCompletedFrame = 0;
+	uint64																FenceEnqueuedFrame = 0;
+
+	void RetireAbandonedDrawers();
+
+	// compiled filters (shared with drawers)
+	TMap<Rml::CompiledFilterHandle, TSharedPtr<FCompiledRmlFilter>>		CompiledFilters;
+	Rml::CompiledFilterHandle											NextFilterHandle = 1;
+
+	// Deferred filter releases — flushed in BeginFrame after the render thread
+	// has processed all commands referencing these handles.
+	TArray<Rml::CompiledFilterHandle>									PendingFilterReleases;
+
+	// compiled shaders
+	TMap<Rml::CompiledShaderHandle, TSharedPtr<FCompiledRmlShader>>		CompiledShaders;
+	Rml::CompiledShaderHandle											NextShaderHandle = 1;
+
+	// Async file texture loads (URmlUiSettings::bAsyncTextureLoading). The entry is
+	// handed to RmlUi with no texture bound — it draws transparent — and receives its
+	// UTexture2D in ProcessTextureLoads, on the game thread, once a worker has read and
+	// decoded the file. Loads issued on the game thread may first wait for the decode
+	// within AsyncTextureLoadBudgetMs; the budget fields are game-thread only.
+	struct FRmlDecodedImage
+	{
+		TArray64<uint8>		Pixels;
+		FIntPoint			Size = FIntPoint::ZeroValue;
+		bool				bValid = false;
+	};
+	struct FPendingTextureLoad
+	{
+		TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>	Entry;
+		FIntPoint											ProbedSize;
+		UE::Tasks::TTask<FRmlDecodedImage>					Task;
+	};
+	TArray<FPendingTextureLoad>											PendingTextureLoads;
+	uint64																TextureLoadBudgetFrame = 0;
+	double																TextureLoadBudgetUsedMs = 0.0;
+
+	IImageWrapperModule*												ImageWrapperModule = nullptr;
+
+	Rml::TextureHandle FindOrLoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source, UE::Tasks::TTask<FRmlDecodedImage>& OutLaunchedLoad);
+	UE::Tasks::TTask<FRmlDecodedImage> LaunchTextureLoad(const TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>& Entry, FIntPoint ProbedSize);
+	// Waits for the task within what is left of this frame's budget. True if it finished.
+	bool WaitForTextureLoad(const UE::Tasks::TTask<FRmlDecodedImage>& Task);
+	void ProcessTextureLoads();
+	void FinishTextureLoad(FPendingTextureLoad& Load);
+
+	// Shared pages for small generated textures, created on first use when
+	// URmlUiSettings::bPackGeneratedTextures is set. Regions are returned to their
+	// page from FlushDeferredReleases, once no drawer can still sample them.
+	TSharedPtr<FRmlTextureAtlas>										TextureAtlas;
+
+	// Dimension-based texture pool. When RmlUI releases a generated texture, the
+	// FRmlTextureEntry (and its UTexture2D) is pooled here instead of destroyed.
+	// On the next GenerateTexture with matching dimensions, the pooled UTexture2D is
+	// reused with just UpdateTextureRegions (memcpy), skipping the expensive
+	// UTexture2D::CreateTransient + UpdateResource path.
+	// Key: (Width << 32) | Height
+	TMap<uint64, TArray<TSharedPtr<FRmlTextureEntry, ESPMode::ThreadSafe>>>	TextureDimensionPool;
+};
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "RmlUi/Core.h"
+#include "Tasks/Task.h"
 
 class UERMLUI_API FUERmlSystemInterface : public Rml::SystemInterface
 {
@@ -8,6 +9,9 @@ public:
 	FUERmlSystemInterface();
 
 	EMouseCursor::Type CachedCursorState() const { return CachedCursor; }
+
+	// Block until every task started through RunAsync has finished.
+	void WaitForAsyncTasks();
 protected:
 	// ~Begin Rml::SystemInterface API 
 	virtual double GetElapsedTime() override;
@@ -19,9 +23,14 @@ protected:
 	virtual void GetClipboardText(Rml::String& text) override;
 	virtual void ActivateKeyboard(Rml::Vector2f caret_position, float line_height) override;
 	virtual void DeactivateKeyboard() override;
+	virtual bool RunAsync(Rml::Function<void()> task) override;
+	virtual bool LoadGeneratedTexture(uint64_t key, Rml::Vector<Rml::byte>& data, Rml::Vector2i& dimensions) override;
+	virtual void StoreGeneratedTexture(uint64_t key, const Rml::Vector<Rml::byte>& data, Rml::Vector2i dimensions) override;
 	// ~End Rml::SystemInterface API
 private:
 	EMouseCursor::Type	CachedCursor;
+	FCriticalSection			AsyncTasksLock;
+	TArray<UE::Tasks::FTask>	AsyncTasks;
 #if !UE_BUILD_SHIPPING
 	TSet<FString>		SeenWarnings; // dedup: each unique warning logged once
 #endif
@@ -58,6 +58,117 @@ public:
 
 	bool IsMSAAEnabled() const { return MSAASamples != ERmlMSAASamples::Disabled; }
 
+	// Reuse the recorded render calls of documents that did not change since the last
+	// paint (no layout, style, transform, scroll or animation updates), skipping the
+	// element tree walk. Mostly-static menus cost close to nothing on the game thread.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance")
+	bool bRetainDocumentRendering = true;
+
+	// Give every URmlUiWidget context its own render recorder (drawer, render state,
+	// retained recordings) on top of the shared meshes, textures, filters and shaders,
+	// so contexts can be recorded on different threads. Each recorder has its own RmlUi
+	// render manager, which generates its own copies of font-effect textures.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance")
+	bool bIsolateContextRendering = false;
+
+	// Update the contexts of all ticking URmlUiWidgets (data models, styles, layout) at once
+	// on task-graph workers, at the start of the Slate tick. Event listeners and data-model
+	// callbacks then run on a worker; contexts hosting a URmlDocument stay on the game thread.
+	// Asset textures (/Game/...) used by these contexts must be bound with SetTexture.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance",
+		meta = (EditCondition = "bIsolateContextRendering"))
+	bool bParallelContextUpdate = false;
+
+	// Render each widget's UI into a persistent texture and composite it with one quad.
+	// Only the areas of documents that changed are redrawn, and static frames skip
+	// RmlUi's GPU work entirely. The UI is rendered over transparent black instead of
+	// the scene, so filters that read the backdrop see only the UI beneath them.
+	// Textures bound with SetTexture whose contents change every frame (render
+	// targets) need SRmlWidget::InvalidateCachedLayer.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance",
+		meta = (EditCondition = "bRetainDocumentRendering"))
+	bool bCacheWidgetLayer = false;
+
+	// Merge adjacent draws that share texture, clip rect and transform into a single
+	// draw call. Draws that differ only by position are merged by offsetting vertices.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance")
+	bool bMergeDrawCalls = true;
+
+	// Draw frames that use no layers, filters or clip masks straight onto the Slate
+	// render target, skipping the full-screen copy into the internal layer and the
+	// blit (and MSAA resolve) back. With MSAA on, only frames whose geometry has no
+	// diagonal or curved edges qualify, so the output looks the same.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance")
+	bool bDirectRendering = true;
+
+	// Keep geometry that stays alive across frames in a persistent GPU buffer
+	// instead of re-uploading it every frame. Mostly-static UIs upload almost nothing.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance")
+	bool bRetainStaticGeometry = true;
+
+	// Number of distinct frames a mesh must be drawn in before it is treated as static.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance",
+		meta = (EditCondition = "bRetainStaticGeometry", ClampMin = "1", ClampMax = "60"))
+	int32 GeometryRetainFrames = 3;
+
+	// Size of the persistent geometry buffer. Meshes that don't fit fall back to
+	// the per-frame upload path.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance",
+		meta = (EditCondition = "bRetainStaticGeometry", ClampMin = "1", ClampMax = "256", Units = "Megabytes"))
+	int32 GeometryArenaSizeMB = 16;
+
+	// Pack small generated textures (font effects, shadows) into shared atlas pages
+	// instead of one UTexture2D each, so their draws share a texture and can merge.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance")
+	bool bPackGeneratedTextures = true;
+
+	// Generated textures up to this size (in both dimensions) go into the atlas.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance",
+		meta = (EditCondition = "bPackGeneratedTextures", ClampMin = "8", ClampMax = "1024"))
+	int32 AtlasMaxTextureSize = 128;
+
+	// Width and height of one atlas page.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance",
+		meta = (EditCondition = "bPackGeneratedTextures", ClampMin = "256", ClampMax = "4096"))
+	int32 AtlasPageSize = 1024;
+
+	// Read and decode image files on a worker thread. LoadTexture returns right away
+	// with the size from the file header; the image draws transparent until decoded.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance")
+	bool bAsyncTextureLoading = true;
+
+	// Time per frame LoadTexture may wait for async decodes, so images on a freshly
+	// opened page still show up on its first frame. 0 = never wait.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance",
+		meta = (EditCondition = "bAsyncTextureLoading", ClampMin = "0", ClampMax = "100", Units = "Milliseconds"))
+	float AsyncTextureLoadBudgetMs = 4.0f;
+
+	// Generate font-effect layers (glow, shadow, outline) on worker threads and spread
+	// generated textures over several frames. Text draws without a layer until it is ready.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance")
+	bool bBudgetGeneratedTextures = true;
+
+	// Time per frame spent generating textures on the game thread (uploads, and effects
+	// that cannot run on a worker). At least one texture is generated every frame.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance",
+		meta = (EditCondition = "bBudgetGeneratedTextures", ClampMin = "0", ClampMax = "100", Units = "Milliseconds"))
+	float GeneratedTextureBudgetMs = 1.0f;
+
+	// Keep generated font-effect textures in Saved/RmlUi/TextureCache.bin, so later
+	// runs (and FRmlWarmer) upload them instead of generating them again.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance")
+	bool bPersistentTextureCache = true;
+
+	// Size limit of the cache, in memory and on disk. Least recently used entries are dropped to stay under it.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance",
+		meta = (EditCondition = "bPersistentTextureCache", ClampMin = "1", ClampMax = "1024", Units = "Megabytes"))
+	int32 TextureCacheMaxSizeMB = 64;
+
+	// Let FRmlWarmer generate the font-effect layers of all warmup documents on worker
+	// threads at once, then upload them in one pass. Layout still runs on the game thread.
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Performance")
+	bool bParallelWarmup = true;
+
 	// Documents to pre-warm before showing the first RmlUi widget.
 	// Use rmlui.CaptureWarmup 1 in PIE to auto-populate this list, then stop PIE.
 	// Call FRmlWarmer::WarmContext() in BeginPlay to apply.
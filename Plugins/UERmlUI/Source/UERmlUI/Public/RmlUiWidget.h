@@ -5,6 +5,7 @@
 #include "RmlUiWidget.generated.h"
 
 class SRmlWidget;
+class FUERmlRenderInterface;
 namespace Rml { class Context; class Element; }
 
 /** One font face to load when the widget initializes. */
@@ -109,8 +110,13 @@ protected:
 
 private:
 	Rml::Element* FindElementById(const FString& ElementId) const;
+	// Create / remove the context named ContextName, with its own recorder under
+	// URmlUiSettings::bIsolateContextRendering.
+	Rml::Context* CreateContext(Rml::Vector2i Dimensions);
+	void RemoveContext();
 
 	TSharedPtr<SRmlWidget>	RmlSlateWidget;
 	FString					ContextName;
 	Rml::Context*			PrewarmedContext = nullptr;
+	FUERmlRenderInterface*	ContextRecorder = nullptr;
 };
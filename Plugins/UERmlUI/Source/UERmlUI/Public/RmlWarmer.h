@@ -6,6 +6,16 @@
 namespace Rml { class Context; }
 class FUERmlRenderInterface;
 
+/** A font configuration that generated textures: recorded by capture mode, replayed by warmup. */
+struct FRmlWarmupFontConfig
+{
+	FString	Family;
+	bool	bItalic = false;
+	int32	Weight = 400;
+	int32	Size = 0;			// px, after dp-ratio scaling
+	FString	FontEffects;		// 'font-effect' property value, empty for none
+};
+
 /**
  * Utility for pre-warming RmlUi font effect textures before widgets are shown.
  *
@@ -15,8 +25,16 @@ class FUERmlRenderInterface;
  * Capture workflow (non-shipping only):
  *   1. Set console variable: rmlui.CaptureWarmup 1
  *   2. Navigate all UI pages and tabs in PIE
- *   3. Stop PIE — document paths are written to DefaultGame.ini automatically
- *   4. Next session: WarmContext() pre-warms from the saved list
+ *   3. Stop PIE — document paths are written to DefaultGame.ini automatically,
+ *      and every font configuration that generated textures is merged into the
+ *      font manifest (Content/RmlUi/WarmupManifest.txt)
+ *   4. Next session: WarmContext() pre-warms from the manifest if there is one,
+ *      else from the saved document list
+ *
+ * The manifest is a sorted, tab-separated text file with one line per font
+ * configuration and the characters drawn with it, so it diffs cleanly and
+ * captures from several sessions merge into one. Stage Content/RmlUi as a
+ * non-asset directory to use it in cooked builds.
  */
 class UERMLUI_API FRmlWarmer
 {
@@ -25,10 +43,22 @@ public:
 	 * Pre-warm all documents in the entries list against the given context.
 	 * Loads each document (hidden), auto-detects any <tabset> and cycles all tabs,
 	 * then runs convergence passes until no new textures are generated.
+	 * With bParallelWarmup, font-effect layers of all documents are generated on
+	 * worker threads concurrently and uploaded in a second pass.
 	 * Call in BeginPlay BEFORE creating SRmlWidget.
 	 */
 	static void WarmContext(Rml::Context* Context, const TArray<FRmlWarmupDocumentEntry>& Entries, FUERmlRenderInterface* RI);
 
+	/**
+	 * Generate the glyphs and font-effect textures of every configuration in the
+	 * font manifest, without loading or laying out any document.
+	 * Returns the number of configurations warmed (0 when there is no manifest).
+	 */
+	static int32 WarmFontManifest(Rml::Context* Context);
+
+	/** Returns true if a font manifest exists. */
+	static bool HasFontManifest();
+
 	/**
 	 * Warm ALL documents currently loaded in the context (regardless of settings).
 	 * Iterates Context->GetNumDocuments(), shows each, settles, cycles tabsets,
@@ -46,6 +76,12 @@ public:
 	 */
 	static void SaveCapturedEntries(FUERmlRenderInterface* RI);
 
+	/**
+	 * Record that Text (UTF-8) was drawn with the given font configuration.
+	 * Called by the font engine while capture is enabled.
+	 */
+	static void CaptureFontString(const FRmlWarmupFontConfig& Config, const char* Text, int32 Length);
+
 	/** Returns true if rmlui.CaptureWarmup console variable is set. */
 	static bool IsCaptureEnabled();
 #endif
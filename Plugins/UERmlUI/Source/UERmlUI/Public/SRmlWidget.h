@@ -5,6 +5,7 @@
 #include "RmlInterface/UERmlSystemInterface.h"
 
 class FUERmlRenderInterface;
+struct FRmlCachedLayer;
 
 class UERMLUI_API SRmlWidget : public SLeafWidget
 {
@@ -27,9 +28,11 @@ public:
 	bool AddToViewport(UWorld* InWorld, int32 ZOrder = 0);
 	bool RemoveFromParent(UWorld* InWorld);
 	
-	void Context(Rml::Context* InContext) { BoundContext = InContext; }
+	void Context(Rml::Context* InContext);
 	Rml::Context* Context() const { return BoundContext; }
 	void SetOnEmptyClick(FSimpleDelegate InDelegate) { OnEmptyClick = MoveTemp(InDelegate); }
+	/** Redraw the whole cached layer next frame (URmlUiSettings::bCacheWidgetLayer). */
+	void InvalidateCachedLayer();
 protected:
 	// ~Begin SWidget API
 	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
@@ -81,8 +84,10 @@ private:
 	// documents fill the full context naturally (= full viewport).
 	float					ActiveUiScale = 1.0f;
 	Rml::Vector2i			ViewportPhysSize{0, 0};
-	// Cached at Construct() — Rml::GetRenderInterface() is global and invariant
-	// after Rml::Initialise(). Avoids repeated static_cast every paint/tick.
+	// Recorder of BoundContext, cached when the context is bound: the module's default
+	// interface, or the context's own one (URmlUiSettings::bIsolateContextRendering).
 	FUERmlRenderInterface*	CachedRenderInterface = nullptr;
 	FSimpleDelegate			OnEmptyClick;
+	// Persistent UI texture for URmlUiSettings::bCacheWidgetLayer, created on first paint.
+	mutable TSharedPtr<FRmlCachedLayer, ESPMode::ThreadSafe>	CachedLayer;
 };